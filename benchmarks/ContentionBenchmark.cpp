@@ -0,0 +1,123 @@
+#include "CacheLine.h"
+#include "PolyphonicGenerator.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace GuitarIO;
+
+namespace
+{
+    constexpr size_t ITERATIONS = 50'000'000; ///< Audio-thread updates per layout run
+    constexpr size_t BLOCKS = 200'000;        ///< Generator blocks per run
+    constexpr size_t BLOCK_SIZE = 64;         ///< Frames per generator block
+
+    /**
+     * @brief Control-written parameter next to audio-written state (the layout before the audit)
+     */
+    struct SharedLineState
+    {
+        std::atomic<float> volume = 0.5f; ///< Written by the control thread
+        std::atomic<double> phase = 0.0;  ///< Written by the audio thread
+    };
+
+    /**
+     * @brief Same fields split into control-written and audio-written cache lines
+     */
+    struct SplitLineState
+    {
+        alignas(CACHE_LINE_SIZE) std::atomic<float> volume = 0.5f; ///< Written by the control thread
+        alignas(CACHE_LINE_SIZE) std::atomic<double> phase = 0.0;  ///< Written by the audio thread
+    };
+
+    /**
+     * @brief Runs the audio-thread loop while a control thread keeps writing its own field
+     * @param state Layout under test
+     * @param contended Whether the control thread runs
+     * @return Nanoseconds per audio-thread update
+     */
+    template<typename State> double RunLayout(State &state, bool contended)
+    {
+        std::atomic<bool> running = true;
+        std::thread control([&] {
+            uint32_t counter = 0;
+            while (contended && running.load(std::memory_order_relaxed))
+            {
+                // Writes only the control-side field; any slowdown of the audio loop is false sharing
+                state.volume.store(static_cast<float>(++counter & 1), std::memory_order_relaxed);
+            }
+        });
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ITERATIONS; ++i)
+        {
+            state.phase.store(state.phase.load(std::memory_order_relaxed) + 1.0, std::memory_order_relaxed);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        running.store(false, std::memory_order_relaxed);
+        control.join();
+        return elapsed.count() / ITERATIONS;
+    }
+
+    /**
+     * @brief Times PolyphonicGenerator blocks while a control thread moves the volume
+     * @param contended Whether the control thread runs
+     * @return Nanoseconds per block
+     */
+    double RunGenerator(bool contended)
+    {
+        PolyphonicGenerator generator(48000.0);
+        generator.SetVoiceFrequencies({ 82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f });
+        std::vector<float> buffer(BLOCK_SIZE);
+
+        std::atomic<bool> running = true;
+        std::thread control([&] {
+            uint32_t counter = 0;
+            while (contended && running.load(std::memory_order_relaxed))
+            {
+                ++counter;
+                generator.SetVoiceAmplitude(counter % PolyphonicGenerator::MAX_VOICES, 0.5f + 0.5f * (counter & 1));
+            }
+        });
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < BLOCKS; ++i)
+        {
+            generator.Generate(buffer);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        running.store(false, std::memory_order_relaxed);
+        control.join();
+        return elapsed.count() / BLOCKS;
+    }
+} // namespace
+
+int main()
+{
+    std::printf("Cache line size: %zu bytes\n\n", CACHE_LINE_SIZE);
+
+    SharedLineState shared;
+    SplitLineState split;
+    const double sharedIdle = RunLayout(shared, false);
+    const double sharedBusy = RunLayout(shared, true);
+    const double splitIdle = RunLayout(split, false);
+    const double splitBusy = RunLayout(split, true);
+
+    std::printf("Audio-thread update (ns)   idle    with control writes\n");
+    std::printf("  shared cache line      %6.2f   %6.2f (x%.1f)\n", sharedIdle, sharedBusy, sharedBusy / sharedIdle);
+    std::printf("  split cache lines      %6.2f   %6.2f (x%.1f)\n\n", splitIdle, splitBusy, splitBusy / splitIdle);
+
+    const double generatorIdle = RunGenerator(false);
+    const double generatorBusy = RunGenerator(true);
+    std::printf("PolyphonicGenerator, %zu-frame block (ns)   idle %.0f   with control writes %.0f (x%.2f)\n",
+        BLOCK_SIZE,
+        generatorIdle,
+        generatorBusy,
+        generatorBusy / generatorIdle);
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "NeuralAmp.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace GuitarIO;
+
+namespace
+{
+    constexpr size_t BLOCKS = 20'000;       ///< Blocks per model run
+    constexpr uint32_t BLOCK_SIZE = 64;     ///< Frames per block (mono)
+    constexpr double SAMPLE_RATE = 48000.0; ///< Rate the real-time budget is computed for
+
+    /**
+     * @brief Model shape under test
+     */
+    struct BenchmarkCase
+    {
+        const char *name;                ///< Printed label
+        NeuralArchitecture architecture; ///< Topology
+        uint32_t hiddenSize;             ///< Units or channels
+        uint32_t layers;                 ///< Conv layers
+        uint32_t kernelSize;             ///< Conv taps
+    };
+
+    /**
+     * @brief Times one model on a guitar-like input
+     * @param benchmark Model shape
+     * @return Nanoseconds per sample
+     */
+    double RunModel(const BenchmarkCase &benchmark)
+    {
+        NeuralModelSpec spec;
+        spec.architecture = benchmark.architecture;
+        spec.hiddenSize = benchmark.hiddenSize;
+        spec.layers = benchmark.layers;
+        spec.kernelSize = benchmark.kernelSize;
+
+        // Random weights scaled so activations neither saturate nor vanish; cost does not depend on values
+        std::mt19937 random(1);
+        std::normal_distribution<float> distribution(0.0f, 1.0f / std::sqrt(static_cast<float>(spec.hiddenSize)));
+        std::vector<float> weights(NeuralModel::GetWeightCount(spec));
+        for (float &weight : weights)
+        {
+            weight = distribution(random);
+        }
+
+        NeuralModel model;
+        NeuralAmp amp;
+        ProcessSpec processSpec;
+        processSpec.sampleRate = SAMPLE_RATE;
+        processSpec.maxBlockFrames = BLOCK_SIZE;
+        if (!model.Assign(spec, weights) || !amp.SetModel(model) || !amp.Prepare(processSpec))
+        {
+            std::printf("%s: setup failed\n", benchmark.name);
+            return 0.0;
+        }
+
+        std::vector<float> input(BLOCK_SIZE);
+        std::vector<float> buffer(BLOCK_SIZE);
+        for (uint32_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            input[i] = 0.5f * std::sin(2.0f * 3.14159265f * 110.0f * static_cast<float>(i) / 48000.0f);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t block = 0; block < BLOCKS; ++block)
+        {
+            buffer = input;
+            amp.Process(buffer, 1);
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / static_cast<double>(BLOCKS * BLOCK_SIZE);
+    }
+} // namespace
+
+int main()
+{
+    const BenchmarkCase cases[] = {
+        { "LSTM 12", NeuralArchitecture::Lstm, 12, 1, 1 },
+        { "LSTM 20", NeuralArchitecture::Lstm, 20, 1, 1 },
+        { "LSTM 32", NeuralArchitecture::Lstm, 32, 1, 1 },
+        { "GRU 20", NeuralArchitecture::Gru, 20, 1, 1 },
+        { "ConvNet 8ch x 10", NeuralArchitecture::ConvNet, 8, 10, 3 },
+        { "ConvNet 16ch x 10", NeuralArchitecture::ConvNet, 16, 10, 3 },
+    };
+
+    const double budget = 1e9 / SAMPLE_RATE;
+    std::printf(
+        "Mono, %u-frame blocks, real-time budget %.0f ns/sample at %.0f Hz\n\n", BLOCK_SIZE, budget, SAMPLE_RATE);
+    std::printf("Model                  ns/sample   CPU at 48 kHz\n");
+    for (const BenchmarkCase &benchmark : cases)
+    {
+        const double perSample = RunModel(benchmark);
+        std::printf("  %-20s %9.1f   %6.2f %%\n", benchmark.name, perSample, 100.0 * perSample / budget);
+    }
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Worker pool resuming coroutines
+     *
+     * Suspended coroutines are queued with Schedule() and resumed on one of the workers.
+     * Non-real-time only: Schedule() takes a mutex and must never be called from the audio thread.
+     * The destructor resumes everything still queued before joining the workers.
+     */
+    class AsyncExecutor
+    {
+    public:
+        /**
+         * @brief Awaiter moving the awaiting coroutine onto the pool
+         */
+        class ScheduleAwaiter
+        {
+        public:
+            /**
+             * @brief Constructs an awaiter
+             * @param executor Executor resuming the coroutine
+             */
+            explicit ScheduleAwaiter(AsyncExecutor &executor) : executor(executor)
+            {
+            }
+
+            /**
+             * @brief Always suspends
+             * @return false
+             */
+            [[nodiscard]] bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            /**
+             * @brief Queues the coroutine on the executor
+             * @param handle Awaiting coroutine
+             */
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                executor.Schedule(handle);
+            }
+
+            /**
+             * @brief Resumes on a worker thread
+             */
+            void await_resume() const noexcept
+            {
+            }
+
+        private:
+            AsyncExecutor &executor; ///< Executor resuming the coroutine
+        };
+
+        /**
+         * @brief Constructs the pool and starts its workers
+         * @param workerCount Worker threads (0 = hardware concurrency)
+         */
+        explicit AsyncExecutor(uint32_t workerCount = 0);
+
+        /**
+         * @brief Destructor (drains the queue and joins the workers)
+         */
+        ~AsyncExecutor();
+
+        AsyncExecutor(const AsyncExecutor &) = delete;
+
+        AsyncExecutor &operator=(const AsyncExecutor &) = delete;
+
+        /**
+         * @brief Queues a suspended coroutine for resumption on a worker
+         * @param handle Coroutine to resume
+         */
+        void Schedule(std::coroutine_handle<> handle);
+
+        /**
+         * @brief Returns an awaiter that continues the awaiting coroutine on the pool
+         *
+         * Usage: `co_await executor.Schedule();`
+         */
+        [[nodiscard]] ScheduleAwaiter Schedule();
+
+        /**
+         * @brief Gets the number of worker threads
+         */
+        [[nodiscard]] uint32_t GetWorkerCount() const;
+
+    private:
+        /**
+         * @brief Worker thread entry point
+         */
+        void WorkerLoop();
+
+        std::vector<std::thread> workers;            ///< Worker threads
+        std::deque<std::coroutine_handle<>> pending; ///< Coroutines waiting for a worker
+        std::mutex mutex;                            ///< Guards pending and stopping
+        std::condition_variable wakeup;              ///< Signals queued work or shutdown
+        bool stopping = false;                       ///< Workers exit once pending is empty
+    };
+
+    /**
+     * @brief Fire-and-forget coroutine started on an AsyncExecutor
+     *
+     * The coroutine body does not run until Start() queues it on an executor; it frees its
+     * own frame when it finishes. A task destroyed without being started is discarded.
+     * Exceptions escaping the body terminate the program.
+     */
+    class AsyncTask
+    {
+    public:
+        /**
+         * @brief Coroutine promise
+         */
+        struct promise_type
+        {
+            /**
+             * @brief Creates the task object returned to the caller
+             */
+            AsyncTask get_return_object()
+            {
+                return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            /**
+             * @brief Suspends until Start()
+             */
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            /**
+             * @brief Frees the frame on completion
+             */
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            /**
+             * @brief Completes the task
+             */
+            void return_void() noexcept
+            {
+            }
+
+            /**
+             * @brief Terminates on an escaping exception
+             */
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+
+        /**
+         * @brief Destructor (destroys the frame if the task was never started)
+         */
+        ~AsyncTask()
+        {
+            if (handle)
+            {
+                handle.destroy();
+            }
+        }
+
+        AsyncTask(const AsyncTask &) = delete;
+
+        AsyncTask &operator=(const AsyncTask &) = delete;
+
+        /**
+         * @brief Move constructor
+         * @param other Task to take ownership from
+         */
+        AsyncTask(AsyncTask &&other) noexcept : handle(std::exchange(other.handle, {}))
+        {
+        }
+
+        AsyncTask &operator=(AsyncTask &&) = delete;
+
+        /**
+         * @brief Queues the task on an executor and releases ownership of the frame
+         * @param executor Executor running the task
+         */
+        void Start(AsyncExecutor &executor)
+        {
+            if (handle)
+            {
+                executor.Schedule(std::exchange(handle, {}));
+            }
+        }
+
+    private:
+        /**
+         * @brief Wraps a coroutine handle
+         * @param handle Suspended coroutine
+         */
+        explicit AsyncTask(std::coroutine_handle<promise_type> handle) : handle(handle)
+        {
+        }
+
+        std::coroutine_handle<promise_type> handle; ///< Owned frame until Start()
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Interleaved audio buffer with block-level flags
+     *
+     * The silent flag means every sample is at or below the detection threshold. Producers that
+     * know their output is silent (an idle generator, a skipped processor) set it so consumers
+     * can skip work instead of processing zeros.
+     */
+    struct AudioBlock
+    {
+        std::span<float> samples; ///< Interleaved samples (frames * channels)
+        uint32_t channels = 1;    ///< Number of interleaved channels
+        bool silent = false;      ///< All samples are at or below the silence threshold
+
+        /**
+         * @brief Gets the number of frames in the block
+         */
+        [[nodiscard]] size_t GetFrameCount() const
+        {
+            return channels > 0 ? samples.size() / channels : 0;
+        }
+    };
+
+} // namespace GuitarIO
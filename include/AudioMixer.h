@@ -1,6 +1,8 @@
 #pragma once
 
+#include "AudioBlock.h"
 #include <algorithm>
+#include <cstdint>
 #include <span>
 #include <vector>
 
@@ -8,10 +10,123 @@ namespace GuitarIO
 {
     /**
      * @brief Simple audio mixer for combining signals
+     *
+     * Besides the generic kernels, Mix(), MixRamp() and ApplyGainRamp() have variants specialized on
+     * channel count and block size (e.g. Mix<2, 128>) whose fixed trip counts let the compiler unroll
+     * and vectorize without tail handling. SelectKernels() picks them once from the prepared format.
      */
     class AudioMixer
     {
     public:
+        /**
+         * @brief Signature of Mix(), used by Kernels
+         */
+        using MixFunction = void (*)(std::span<const float>, std::span<float>, float);
+
+        /**
+         * @brief Signature of MixRamp(), used by Kernels
+         */
+        using MixRampFunction = void (*)(std::span<const float>, std::span<float>, float, float, uint32_t);
+
+        /**
+         * @brief Signature of ApplyGainRamp(), used by Kernels
+         */
+        using GainRampFunction = void (*)(std::span<float>, float, float, uint32_t);
+
+        /**
+         * @brief Mixing kernels chosen for one stream format
+         *
+         * Specialized kernels check the buffer size on every call and fall back to the generic
+         * path, so blocks shorter than the configured size (or a device that negotiated another
+         * buffer size) stay correct.
+         */
+        struct Kernels
+        {
+            MixFunction mix = &AudioMixer::Mix;                          ///< Mix() for the format
+            MixRampFunction mixRamp = &AudioMixer::MixRamp;              ///< MixRamp() for the format
+            GainRampFunction applyGainRamp = &AudioMixer::ApplyGainRamp; ///< ApplyGainRamp() for the format
+            bool specialized = false;                                    ///< A fixed-size variant was selected
+        };
+
+        /**
+         * @brief Picks specialized kernels for a channel count and block size (call at prepare time)
+         *
+         * Specializations exist for 1 and 2 channels at 64, 128 and 256 frames; other formats get
+         * the generic kernels.
+         *
+         * @param channels Number of interleaved channels
+         * @param frames Frames per block
+         * @return Kernel set for the format
+         */
+        [[nodiscard]] static Kernels SelectKernels(uint32_t channels, uint32_t frames);
+
+        /**
+         * @brief Mixes a fixed-size interleaved block into another with gain control
+         * @tparam Channels Number of interleaved channels
+         * @tparam Frames Frames per block
+         * @param input Input block
+         * @param output Output block (accumulates result)
+         * @param gain Volume multiplier for input signal
+         */
+        template<uint32_t Channels, uint32_t Frames>
+        static void Mix(std::span<const float, Channels * Frames> input,
+            std::span<float, Channels * Frames> output,
+            float gain)
+        {
+            for (size_t i = 0; i < Channels * Frames; ++i)
+            {
+                output[i] += input[i] * gain;
+            }
+        }
+
+        /**
+         * @brief Mixes a fixed-size interleaved block into another with a linearly ramped gain
+         * @tparam Channels Number of interleaved channels
+         * @tparam Frames Frames per block
+         * @param input Input block
+         * @param output Output block (accumulates result)
+         * @param startGain Gain applied to the first frame
+         * @param endGain Gain the ramp reaches one frame past the end of the block
+         */
+        template<uint32_t Channels, uint32_t Frames>
+        static void MixRamp(std::span<const float, Channels * Frames> input,
+            std::span<float, Channels * Frames> output,
+            float startGain,
+            float endGain)
+        {
+            const float step = (endGain - startGain) / static_cast<float>(Frames);
+            for (size_t i = 0; i < Frames; ++i)
+            {
+                const float gain = startGain + step * static_cast<float>(i);
+                for (size_t c = 0; c < Channels; ++c)
+                {
+                    output[i * Channels + c] += input[i * Channels + c] * gain;
+                }
+            }
+        }
+
+        /**
+         * @brief Multiplies a fixed-size interleaved block by a linearly ramped gain
+         * @tparam Channels Number of interleaved channels
+         * @tparam Frames Frames per block
+         * @param buffer Block to scale in place
+         * @param startGain Gain applied to the first frame
+         * @param endGain Gain the ramp reaches one frame past the end of the block
+         */
+        template<uint32_t Channels, uint32_t Frames>
+        static void ApplyGainRamp(std::span<float, Channels * Frames> buffer, float startGain, float endGain)
+        {
+            const float step = (endGain - startGain) / static_cast<float>(Frames);
+            for (size_t i = 0; i < Frames; ++i)
+            {
+                const float gain = startGain + step * static_cast<float>(i);
+                for (size_t c = 0; c < Channels; ++c)
+                {
+                    buffer[i * Channels + c] *= gain;
+                }
+            }
+        }
+
         /**
          * @brief Mixes input buffer into output buffer with gain control
          * @param input Input audio buffer
@@ -20,6 +135,37 @@ namespace GuitarIO
          */
         static void Mix(std::span<const float> input, std::span<float> output, float gain);
 
+        /**
+         * @brief Mixes input block into output block, skipping the work when the input is silent
+         * @param input Input audio block
+         * @param output Output audio block (accumulates result, silent flag cleared when mixed)
+         * @param gain Volume multiplier for input signal
+         */
+        static void Mix(const AudioBlock &input, AudioBlock &output, float gain);
+
+        /**
+         * @brief Mixes input into output with a gain ramped linearly across the buffer
+         * @param input Input audio buffer (interleaved)
+         * @param output Output audio buffer (accumulates result)
+         * @param startGain Gain applied to the first frame
+         * @param endGain Gain the ramp reaches one frame past the end of the buffer
+         * @param channels Number of interleaved channels
+         */
+        static void MixRamp(std::span<const float> input,
+            std::span<float> output,
+            float startGain,
+            float endGain,
+            uint32_t channels = 1);
+
+        /**
+         * @brief Multiplies a buffer by a gain ramped linearly across it
+         * @param buffer Buffer to scale in place (interleaved)
+         * @param startGain Gain applied to the first frame
+         * @param endGain Gain the ramp reaches one frame past the end of the buffer
+         * @param channels Number of interleaved channels
+         */
+        static void ApplyGainRamp(std::span<float> buffer, float startGain, float endGain, uint32_t channels = 1);
+
         /**
          * @brief Clears the buffer (fills with silence)
          * @param buffer Buffer to clear
@@ -32,5 +178,47 @@ namespace GuitarIO
          * @param threshold Threshold level (usually 1.0)
          */
         static void Limit(std::span<float> buffer, float threshold = 1.0f);
+
+        /**
+         * @brief Checks whether every sample is at or below a threshold
+         * @param buffer Buffer to check
+         * @param threshold Linear amplitude threshold (0 = exact digital silence)
+         * @return true if no sample's magnitude exceeds the threshold
+         */
+        [[nodiscard]] static bool IsSilent(std::span<const float> buffer, float threshold = 0.0f);
+
+    private:
+        /**
+         * @brief Kernel set for one specialized format
+         */
+        template<uint32_t Channels, uint32_t Frames> static Kernels MakeKernels();
+
+        /**
+         * @brief Chooses the block size specialization for a channel count
+         * @param frames Frames per block
+         */
+        template<uint32_t Channels> static Kernels SelectFrames(uint32_t frames);
+
+        /**
+         * @brief Mix() entry point that runs Mix<Channels, Frames> on matching buffers
+         */
+        template<uint32_t Channels, uint32_t Frames>
+        static void MixFixed(std::span<const float> input, std::span<float> output, float gain);
+
+        /**
+         * @brief MixRamp() entry point that runs MixRamp<Channels, Frames> on matching buffers
+         */
+        template<uint32_t Channels, uint32_t Frames>
+        static void MixRampFixed(std::span<const float> input,
+            std::span<float> output,
+            float startGain,
+            float endGain,
+            uint32_t channels);
+
+        /**
+         * @brief ApplyGainRamp() entry point that runs ApplyGainRamp<Channels, Frames> on matching buffers
+         */
+        template<uint32_t Channels, uint32_t Frames>
+        static void ApplyGainRampFixed(std::span<float> buffer, float startGain, float endGain, uint32_t channels);
     };
 } // namespace GuitarIO
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "ProcessSpec.h"
+#include <cstdint>
+#include <span>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Interface for in-place audio processing stages
+     *
+     * Processors are chained by ProcessorChain and run on whichever thread drives
+     * the stream (device callback or StreamHost worker), so Process() must be real-time safe.
+     *
+     * Lifecycle: Prepare() once per stream format with the largest rate and block that will be
+     * used (allocates), SetSampleRate() for any rate change up to that maximum (recomputes
+     * coefficients off the audio thread and publishes them, e.g. through a CoefficientBuffer),
+     * Reset() to clear state. A rate switch therefore never reallocates or rebuilds processors.
+     */
+    class AudioProcessor
+    {
+    public:
+        static constexpr uint32_t TAIL_INFINITE = UINT32_MAX; ///< Output may never become silent
+
+        virtual ~AudioProcessor() = default;
+
+        /**
+         * @brief Processes an interleaved block in place
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Number of interleaved channels
+         */
+        virtual void Process(std::span<float> buffer, uint32_t channels) = 0;
+
+        /**
+         * @brief Allocates buffers for a stream format (not real-time safe)
+         *
+         * Size everything for spec.GetMaxSampleRate() and spec.maxBlockFrames, then compute
+         * coefficients for spec.sampleRate.
+         *
+         * @param spec Stream format
+         * @return true on success, false if the format is not supported
+         */
+        virtual bool Prepare([[maybe_unused]] const ProcessSpec &spec)
+        {
+            return true;
+        }
+
+        /**
+         * @brief Switches to another sample rate without reallocating (control thread)
+         *
+         * Recomputes rate-dependent coefficients off the audio thread and publishes them for the
+         * next block. Must not allocate. Rates above the prepared maximum are clamped to it.
+         *
+         * @param sampleRate New sample rate in Hz
+         */
+        virtual void SetSampleRate([[maybe_unused]] double sampleRate)
+        {
+        }
+
+        /**
+         * @brief Clears internal state (delay lines, envelopes, phases)
+         */
+        virtual void Reset()
+        {
+        }
+
+        /**
+         * @brief Gets how long output can stay non-silent after the input becomes silent
+         *
+         * Once the input has been silent for this many frames, ProcessorChain skips the
+         * processor and keeps the block flagged silent. Return 0 for processors whose silent
+         * input always yields silent output (gains, mixers, analyzers) and the decay length for
+         * filters and delays. The default never skips, which is right for generators.
+         *
+         * @return Tail length in frames, or TAIL_INFINITE
+         */
+        [[nodiscard]] virtual uint32_t GetTailFrames() const
+        {
+            return TAIL_INFINITE;
+        }
+
+        /**
+         * @brief Gets the delay the processor adds to the signal
+         *
+         * Lookahead, linear-phase filters, FFT blocks and resampling delay their output relative to
+         * the input. ParallelChain reads this every block to align parallel paths, so a processor
+         * whose latency changes at runtime takes effect on the next block.
+         *
+         * @return Latency in frames
+         */
+        [[nodiscard]] virtual uint32_t GetLatencyFrames() const
+        {
+            return 0;
+        }
+    };
+
+} // namespace GuitarIO
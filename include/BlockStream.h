@@ -0,0 +1,240 @@
+#pragma once
+
+#include "AsyncExecutor.h"
+#include "CacheLine.h"
+#include "MemoryAccounting.h"
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Block stream configuration
+     */
+    struct BlockStreamConfig
+    {
+        uint32_t channels = 1;        ///< Interleaved channels
+        uint32_t blockFrames = 256;   ///< Frames per published block
+        uint32_t capacityBlocks = 32; ///< Blocks retained for readers that fall behind (minimum 2)
+    };
+
+    /**
+     * @brief Broadcasts fixed-size blocks from the audio callback to coroutine consumers
+     *
+     * The audio thread calls Publish() with whatever the callback produced; samples are regrouped
+     * into blocks of BlockStreamConfig::blockFrames and written to a broadcast ring without locks or
+     * allocation. Any number of BlockStreamReader objects consume the ring independently with
+     * `co_await reader.NextBlock()`. A suspended reader is parked on a waiter list; a dispatcher
+     * thread, woken through an atomic wait/notify only while someone is waiting, hands ready readers
+     * to the AsyncExecutor. Consumers therefore share the executor's workers instead of owning a
+     * thread each.
+     *
+     * The producer never waits for readers: a reader more than capacityBlocks behind skips ahead to
+     * the newest block and counts the skipped ones as dropped.
+     *
+     * The stream must outlive its readers, and the executor must outlive the stream.
+     */
+    class BlockStream
+    {
+    public:
+        /**
+         * @brief Constructs a stream and starts its dispatcher thread
+         * @param executor Executor resuming suspended readers
+         * @param config Stream configuration
+         */
+        explicit BlockStream(AsyncExecutor &executor, const BlockStreamConfig &config = {});
+
+        /**
+         * @brief Destructor (closes the stream and joins the dispatcher)
+         */
+        ~BlockStream();
+
+        BlockStream(const BlockStream &) = delete;
+
+        BlockStream &operator=(const BlockStream &) = delete;
+
+        /**
+         * @brief Appends interleaved samples, publishing every completed block (audio thread)
+         *
+         * Lock-free and allocation-free. Wakes the dispatcher only when a reader is suspended.
+         *
+         * @param samples Interleaved samples (whole frames)
+         */
+        void Publish(std::span<const float> samples);
+
+        /**
+         * @brief Closes the stream; suspended and future NextBlock() awaits return an empty block
+         */
+        void Close();
+
+        /**
+         * @brief Checks whether the stream has been closed
+         */
+        [[nodiscard]] bool IsClosed() const;
+
+        /**
+         * @brief Gets the number of blocks published so far
+         */
+        [[nodiscard]] uint64_t GetPublishedBlocks() const;
+
+        /**
+         * @brief Gets the stream configuration
+         */
+        [[nodiscard]] const BlockStreamConfig &GetConfig() const;
+
+    private:
+        friend class BlockStreamReader;
+
+        /**
+         * @brief Suspended reader waiting for a block
+         */
+        struct Waiter
+        {
+            std::coroutine_handle<> handle; ///< Reader coroutine
+            uint64_t block = 0;             ///< Block the reader needs
+        };
+
+        /**
+         * @brief Copies a published block if it is still in the ring
+         * @param block Block index
+         * @param destination Receives blockFrames * channels samples
+         * @return false if the block was overwritten before or during the copy
+         */
+        bool CopyBlock(uint64_t block, std::span<float> destination);
+
+        /**
+         * @brief Parks a reader until a block is published or the stream closes
+         * @param handle Reader coroutine
+         * @param block Block the reader needs
+         * @return false if the block is already available or the stream is closed (do not suspend)
+         */
+        bool AddWaiter(std::coroutine_handle<> handle, uint64_t block);
+
+        /**
+         * @brief Wakes the dispatcher thread
+         */
+        void Signal();
+
+        /**
+         * @brief Dispatcher thread entry point
+         */
+        void DispatchLoop();
+
+        AsyncExecutor &executor;                               ///< Executor resuming readers
+        BlockStreamConfig config;                              ///< Stream configuration
+        size_t blockSamples = 0;                               ///< Samples per block
+        TaggedVector<float, MemoryTag::Rings> slots;           ///< Ring storage (capacityBlocks blocks)
+        std::unique_ptr<std::atomic<uint64_t>[]> slotSequence; ///< Block index + 1 held per slot (seqlock)
+
+        size_t writeOffset = 0; ///< Samples written into the block being filled (audio thread)
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published = 0; ///< Completed blocks
+        std::atomic<uint32_t> waiterCount = 0;                        ///< Suspended readers
+        std::atomic<uint32_t> wakeSignal = 0;                         ///< Dispatcher wait/notify word
+
+        alignas(CACHE_LINE_SIZE) std::mutex waitersMutex; ///< Guards waiters and closed transitions
+        std::vector<Waiter> waiters;                      ///< Suspended readers
+        std::atomic<bool> closed = false;                 ///< Stream closed
+        std::thread dispatcher;                           ///< Moves ready readers to the executor
+    };
+
+    /**
+     * @brief Independent cursor over a BlockStream
+     *
+     * Each reader keeps its own copy of the current block. A reader is used by one coroutine at a
+     * time; create one reader per consumer.
+     */
+    class BlockStreamReader
+    {
+    public:
+        /**
+         * @brief Awaiter returned by NextBlock()
+         */
+        class NextBlockAwaiter
+        {
+        public:
+            /**
+             * @brief Constructs an awaiter
+             * @param reader Reader being advanced
+             */
+            explicit NextBlockAwaiter(BlockStreamReader &reader) : reader(reader)
+            {
+            }
+
+            /**
+             * @brief Completes immediately if a block is available or the stream is closed
+             */
+            bool await_ready();
+
+            /**
+             * @brief Parks the coroutine on the stream unless a block arrived meanwhile
+             * @param handle Awaiting coroutine
+             * @return true to suspend, false to resume immediately
+             */
+            bool await_suspend(std::coroutine_handle<> handle);
+
+            /**
+             * @brief Returns the block (empty once the stream is closed and drained)
+             */
+            std::span<const float> await_resume();
+
+        private:
+            BlockStreamReader &reader; ///< Reader being advanced
+            bool fetched = false;      ///< Block already copied by await_ready()/await_suspend()
+        };
+
+        /**
+         * @brief Constructs a reader positioned at the next block to be published
+         * @param stream Stream to read
+         */
+        explicit BlockStreamReader(BlockStream &stream);
+
+        BlockStreamReader(const BlockStreamReader &) = delete;
+
+        BlockStreamReader &operator=(const BlockStreamReader &) = delete;
+
+        /**
+         * @brief Awaits the next block
+         *
+         * Usage: `std::span<const float> block = co_await reader.NextBlock();`
+         * The span stays valid until the next call. After a suspension the coroutine continues on
+         * an executor worker. An empty span means the stream was closed and all blocks were read.
+         */
+        [[nodiscard]] NextBlockAwaiter NextBlock();
+
+        /**
+         * @brief Reads the next block without waiting
+         * @return The block, or an empty span if none is available
+         */
+        [[nodiscard]] std::span<const float> TryNextBlock();
+
+        /**
+         * @brief Gets the number of blocks skipped because the reader fell behind
+         */
+        [[nodiscard]] uint64_t GetDroppedBlocks() const;
+
+        /**
+         * @brief Gets the index of the next block to be read
+         */
+        [[nodiscard]] uint64_t GetPosition() const;
+
+    private:
+        /**
+         * @brief Copies the next available block, skipping overwritten ones
+         * @return false if no block is available
+         */
+        bool Fetch();
+
+        BlockStream &stream;       ///< Stream being read
+        TaggedVector<float> block; ///< Copy of the current block
+        uint64_t next = 0;         ///< Next block index to read
+        uint64_t dropped = 0;      ///< Blocks skipped
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "AudioDevice.h"
+#include "CacheLine.h"
+#include "SpscRingBuffer.h"
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Blocking stream configuration
+     */
+    struct BlockingStreamConfig
+    {
+        uint32_t fifoFrames = 8192; ///< Capacity of each direction's FIFO (frames)
+        uint32_t wakeupFrames = 0;  ///< Frames that must be ready before a parked caller is woken (0 = one buffer)
+    };
+
+    /**
+     * @brief Blocking Read()/Write() adapter around any AudioDevice
+     *
+     * The device callback moves samples between the hardware buffers and two SPSC FIFOs and never
+     * blocks. Read() and Write() copy through the FIFOs and park on an atomic wait (a futex on
+     * Linux) only when their FIFO is empty or full. The callback wakes a parked caller only once
+     * wakeupFrames (or the remainder of the request, if smaller) are ready, so a reader of large
+     * spans is woken once per batch instead of once per device buffer.
+     *
+     * Input that does not fit the input FIFO is dropped and output missing from the output FIFO is
+     * replaced by silence; both are counted. One thread may call Read() and another Write().
+     */
+    class BlockingAudioStream
+    {
+    public:
+        /**
+         * @brief Constructs an adapter
+         * @param device Device driven by this adapter (must outlive it)
+         * @param config Adapter configuration
+         */
+        explicit BlockingAudioStream(AudioDevice &device, const BlockingStreamConfig &config = {});
+
+        /**
+         * @brief Destructor (closes the device stream)
+         */
+        ~BlockingAudioStream();
+
+        BlockingAudioStream(const BlockingAudioStream &) = delete;
+
+        BlockingAudioStream &operator=(const BlockingAudioStream &) = delete;
+
+        /**
+         * @brief Opens a device stream feeding the FIFOs
+         * @param deviceId Device ID
+         * @param config Stream configuration
+         * @return true on success, false on failure
+         */
+        bool Open(uint32_t deviceId, const AudioStreamConfig &config);
+
+        /**
+         * @brief Opens the default device
+         * @param config Stream configuration
+         * @return true on success, false on failure
+         */
+        bool OpenDefault(const AudioStreamConfig &config);
+
+        /**
+         * @brief Starts the device stream
+         * @return true on success, false on failure
+         */
+        bool Start();
+
+        /**
+         * @brief Stops the device stream and releases blocked Read()/Write() calls
+         * @return true on success, false on failure
+         */
+        bool Stop();
+
+        /**
+         * @brief Stops and closes the device stream
+         */
+        void Close();
+
+        /**
+         * @brief Reads interleaved input samples, blocking until all are read
+         * @param samples Destination (whole frames)
+         * @return Samples read; fewer than requested only if the stream stopped
+         */
+        size_t Read(std::span<float> samples);
+
+        /**
+         * @brief Writes interleaved output samples, blocking until all are queued
+         * @param samples Source (whole frames)
+         * @return Samples queued; fewer than requested only if the stream stopped
+         */
+        size_t Write(std::span<const float> samples);
+
+        /**
+         * @brief Gets the number of input frames that can be read without blocking
+         */
+        [[nodiscard]] size_t GetReadAvailable() const;
+
+        /**
+         * @brief Gets the number of output frames that can be written without blocking
+         */
+        [[nodiscard]] size_t GetWriteAvailable() const;
+
+        /**
+         * @brief Gets the number of callbacks that dropped input because the input FIFO was full
+         */
+        [[nodiscard]] uint64_t GetInputOverflows() const;
+
+        /**
+         * @brief Gets the number of callbacks that played silence because the output FIFO ran dry
+         */
+        [[nodiscard]] uint64_t GetOutputUnderflows() const;
+
+        /**
+         * @brief Gets the number of times the callback woke a parked Read() or Write()
+         */
+        [[nodiscard]] uint64_t GetWakeups() const;
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief Sizes the FIFOs for a stream configuration
+         * @param config Stream configuration
+         */
+        void Prepare(const AudioStreamConfig &config);
+
+        /**
+         * @brief Device callback moving samples between the device and the FIFOs
+         * @param input Interleaved input buffer
+         * @param output Interleaved output buffer
+         * @return 0 (keeps the stream running)
+         */
+        int Process(std::span<const float> input, std::span<float> output);
+
+        /**
+         * @brief Wakes a parked caller if the samples it waits for are ready (audio thread)
+         *
+         * Must follow a seq_cst fence placed after the FIFO update.
+         *
+         * @param want Samples the caller waits for (0 = not parked)
+         * @param ready Samples currently ready for it
+         * @param signal Wait word the caller is parked on
+         */
+        void WakeIfReady(std::atomic<size_t> &want, size_t ready, std::atomic<uint32_t> &signal);
+
+        /**
+         * @brief Parks the calling thread until enough samples are ready or the stream stops
+         * @param want Samples to wait for
+         * @param ready Returns the samples currently ready
+         * @param wantSlot Published demand read by the callback
+         * @param signal Wait word
+         */
+        template<typename ReadyFn>
+        void Park(size_t want, ReadyFn ready, std::atomic<size_t> &wantSlot, std::atomic<uint32_t> &signal);
+
+        /**
+         * @brief Releases parked callers after the stream stops
+         */
+        void WakeAll();
+
+        AudioDevice &device;         ///< Wrapped device
+        BlockingStreamConfig config; ///< Adapter configuration
+        uint32_t inputChannels = 0;  ///< Interleaved input channels
+        uint32_t outputChannels = 0; ///< Interleaved output channels
+        uint32_t wakeupFrames = 1;   ///< Resolved wakeup batch (frames)
+        std::string lastError;       ///< Last error message
+
+        SpscRingBuffer<float> input;  ///< Callback -> Read()
+        SpscRingBuffer<float> output; ///< Write() -> callback
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> readerWant = 0; ///< Samples a parked Read() needs
+        std::atomic<uint32_t> readerSignal = 0;                      ///< Read() wait word
+        std::atomic<size_t> writerWant = 0;                          ///< Free samples a parked Write() needs
+        std::atomic<uint32_t> writerSignal = 0;                      ///< Write() wait word
+        std::atomic<bool> running = false;                           ///< Read()/Write() may block
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> inputOverflows = 0; ///< Callbacks with dropped input
+        std::atomic<uint64_t> outputUnderflows = 0;                        ///< Callbacks padded with silence
+        std::atomic<uint64_t> wakeups = 0;                                 ///< Parked callers woken
+    };
+
+} // namespace GuitarIO
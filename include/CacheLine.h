@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Alignment that keeps data written by different threads on separate cache lines
+     *
+     * A fixed value stands in for std::hardware_destructive_interference_size, which may change
+     * with compiler version or tuning flags and therefore must not leak into a library ABI.
+     * Apple Silicon cores transfer 128-byte lines.
+     */
+#if defined(__APPLE__) && defined(__aarch64__)
+    inline constexpr size_t CACHE_LINE_SIZE = 128;
+#else
+    inline constexpr size_t CACHE_LINE_SIZE = 64;
+#endif
+
+} // namespace GuitarIO
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "AudioDevice.h"
+#include "CallbackTrace.h"
+#include "SpscRingBuffer.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <thread>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Callback recorder configuration
+     */
+    struct CallbackRecorderConfig
+    {
+        size_t bufferBytes = 8 * 1024 * 1024; ///< Ring buffer between the audio thread and the writer
+        bool recordOutputChecksums = true;    ///< Store a checksum of every output block for replay comparison
+    };
+
+    /**
+     * @brief Captures callback inputs and parameter events into a binary trace
+     *
+     * The audio thread serializes records into a lock-free ring buffer; a background thread
+     * writes them to disk. Records that do not fit are dropped (and counted) rather than
+     * blocking the callback; the next record that fits is preceded by a RECORD_GAP record
+     * carrying what was lost, so replay knows where the trace stops being deterministic. Each
+     * record, including its gap and sample payload, is published to the writer in one push.
+     * Replay the file with TraceReplayer.
+     *
+     * RecordBlock(), RecordOutput() and RecordParameter() must all be called from the audio
+     * thread. Record parameter changes at the point the processor applies them so replay is
+     * deterministic. RtAudioDevice::SetRecorder() wires the block and output hooks automatically.
+     */
+    class CallbackRecorder
+    {
+    public:
+        /**
+         * @brief Constructs a recorder
+         * @param config Recorder configuration
+         */
+        explicit CallbackRecorder(const CallbackRecorderConfig &config = {});
+
+        /**
+         * @brief Destructor (stops recording and flushes the trace)
+         */
+        ~CallbackRecorder();
+
+        CallbackRecorder(const CallbackRecorder &) = delete;
+
+        CallbackRecorder &operator=(const CallbackRecorder &) = delete;
+
+        /**
+         * @brief Creates the trace file and starts the writer thread
+         * @param path Trace file path
+         * @param config Format of the stream being recorded
+         * @return true on success, false on failure
+         */
+        bool Start(const std::string &path, const AudioStreamConfig &config);
+
+        /**
+         * @brief Stops recording, drains pending records and closes the file
+         *
+         * Waits for audio-thread hooks already in progress to return, so the ring buffer can be
+         * resized by the next Start() while the stream keeps running.
+         */
+        void Stop();
+
+        /**
+         * @brief Checks whether recording is active
+         */
+        [[nodiscard]] bool IsRecording() const;
+
+        /**
+         * @brief Records one callback's input (audio thread)
+         * @param input Interleaved input samples (may be empty for output-only streams)
+         * @param frames Frames in the callback
+         * @param streamTime Backend stream time in seconds
+         * @param status Backend stream status flags (overflow/underflow)
+         */
+        void RecordBlock(std::span<const float> input, uint32_t frames, double streamTime, uint32_t status);
+
+        /**
+         * @brief Records the checksum of the output produced for the last recorded block (audio thread)
+         * @param output Interleaved output samples
+         */
+        void RecordOutput(std::span<const float> output);
+
+        /**
+         * @brief Records a parameter change applied before the next block (audio thread)
+         * @param id Application-defined parameter identifier
+         * @param value New value
+         */
+        void RecordParameter(uint32_t id, float value);
+
+        /**
+         * @brief Gets the number of blocks written to the ring buffer
+         */
+        [[nodiscard]] uint64_t GetRecordedBlocks() const;
+
+        /**
+         * @brief Gets the number of records dropped because the ring buffer was full
+         */
+        [[nodiscard]] uint64_t GetDroppedRecords() const;
+
+        /**
+         * @brief Gets the bytes queued for the writer thread (safe from any thread)
+         */
+        [[nodiscard]] size_t GetBacklogBytes() const;
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief Writes one record, preceded by a gap record if earlier records were dropped
+         *
+         * The gap, header and payload are published together or not at all.
+         *
+         * @param head Fixed-size record header
+         * @param payload Optional sample payload
+         * @return true if written, false if dropped
+         */
+        bool Push(std::span<const uint8_t> head, std::span<const float> payload = {});
+
+        /**
+         * @brief Serializes the pending drop counts as a gap record
+         * @return Gap record bytes
+         */
+        [[nodiscard]] std::array<uint8_t, CallbackTrace::GAP_SIZE> MakeGap() const;
+
+        /**
+         * @brief Nanoseconds since Start()
+         */
+        [[nodiscard]] uint64_t Timestamp() const;
+
+        /**
+         * @brief Writer thread entry point
+         */
+        void WriterLoop();
+
+        CallbackRecorderConfig config;                   ///< Recorder configuration
+        SpscRingBuffer<uint8_t> ring;                    ///< Serialized records awaiting the writer
+        std::ofstream file;                              ///< Trace file
+        std::thread writer;                              ///< Background writer thread
+        std::chrono::steady_clock::time_point startTime; ///< Timestamp origin
+        std::atomic<bool> recording = false;             ///< Audio-thread hooks enabled
+        std::atomic<bool> writerRunning = false;         ///< Writer thread keep-alive flag
+        std::atomic<uint64_t> recordedBlocks = 0;        ///< Blocks accepted
+        std::atomic<uint64_t> droppedRecords = 0;        ///< Records rejected (ring full)
+        std::atomic<uint32_t> activeHooks = 0;           ///< Audio-thread hooks currently running
+        bool lastBlockDropped = false;                   ///< Suppresses the checksum of a dropped block
+        uint32_t gapBlocks = 0;                          ///< Blocks dropped since the last written record
+        uint32_t gapParameters = 0;                      ///< Parameter events dropped since the last written record
+        uint64_t gapFrames = 0;                          ///< Frames of the dropped blocks
+        std::string lastError;                           ///< Last error message
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Binary layout of callback traces written by CallbackRecorder
+     *
+     * A trace is a TraceHeader followed by records, all in native byte order (little-endian on
+     * every supported platform). Each record starts with a one-byte type:
+     * - RECORD_BLOCK: frames(u32) sampleCount(u32) status(u32) streamTime(f64) timestampNs(u64),
+     *   then sampleCount interleaved float input samples
+     * - RECORD_PARAMETER: id(u32) value(f32) timestampNs(u64); applies before the next block
+     * - RECORD_OUTPUT_CHECKSUM: checksum(u64) of the output of the preceding block
+     * - RECORD_GAP: blocks(u32) parameters(u32) frames(u64) dropped by the recorder since the
+     *   previous record because its ring buffer was full
+     *
+     * Version 2 added RECORD_GAP; version 1 traces are read unchanged.
+     */
+    struct CallbackTrace
+    {
+        static constexpr uint32_t MAGIC = 0x47494F54; ///< "GIOT"
+        static constexpr uint32_t VERSION = 2;        ///< Format version
+
+        static constexpr uint8_t RECORD_BLOCK = 1;           ///< Callback input block
+        static constexpr uint8_t RECORD_PARAMETER = 2;       ///< Parameter event
+        static constexpr uint8_t RECORD_OUTPUT_CHECKSUM = 3; ///< Output checksum of the previous block
+        static constexpr uint8_t RECORD_GAP = 4;             ///< Records lost to a full ring buffer
+
+        static constexpr size_t BLOCK_HEADER_SIZE = 1 + 4 + 4 + 4 + 8 + 8; ///< Block record without samples
+        static constexpr size_t PARAMETER_SIZE = 1 + 4 + 4 + 8;            ///< Parameter record
+        static constexpr size_t CHECKSUM_SIZE = 1 + 8;                     ///< Output checksum record
+        static constexpr size_t GAP_SIZE = 1 + 4 + 4 + 8;                  ///< Gap record
+
+        static constexpr uint64_t CHECKSUM_SEED = 14695981039346656037ull; ///< FNV-1a offset basis
+
+        /**
+         * @brief Hashes the bit patterns of a block of samples
+         *
+         * Bit-exact: any difference in output, including the sign of zero or NaN payloads, changes
+         * the checksum. Hashing 32-bit words keeps it cheap enough for the audio thread.
+         *
+         * @param samples Samples to hash
+         * @param seed Starting value (chain blocks by passing the previous checksum)
+         * @return 64-bit checksum
+         */
+        [[nodiscard]] static uint64_t Checksum(std::span<const float> samples, uint64_t seed = CHECKSUM_SEED)
+        {
+            constexpr uint64_t PRIME = 1099511628211ull;
+
+            uint64_t hash = seed;
+            for (float sample : samples)
+            {
+                uint32_t bits = 0;
+                std::memcpy(&bits, &sample, sizeof(bits));
+                hash = (hash ^ bits) * PRIME;
+            }
+            return hash;
+        }
+    };
+
+    /**
+     * @brief Trace file header
+     */
+    struct TraceHeader
+    {
+        uint32_t magic = CallbackTrace::MAGIC;     ///< Format identifier
+        uint32_t version = CallbackTrace::VERSION; ///< Format version
+        uint32_t sampleRate = 0;                   ///< Stream sample rate (Hz)
+        uint32_t bufferSize = 0;                   ///< Nominal frames per callback
+        uint32_t inputChannels = 0;                ///< Interleaved input channels
+        uint32_t outputChannels = 0;               ///< Interleaved output channels
+    };
+
+} // namespace GuitarIO
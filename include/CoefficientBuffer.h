@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CacheLine.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Wait-free hand-over of a coefficient set from a control thread to the audio thread
+     *
+     * A triple buffer: the control thread fills a spare copy and publishes it with one atomic
+     * exchange; the audio thread picks up the newest complete set at the start of a block with
+     * Acquire(). Neither side blocks or allocates, and the audio thread never sees a half-written
+     * set. Processors use it to apply SetSampleRate() (or any multi-value change) atomically.
+     *
+     * One writer thread and one reader thread.
+     *
+     * @tparam T Copyable coefficient set
+     */
+    template<typename T> class CoefficientBuffer
+    {
+    public:
+        /**
+         * @brief Constructs the buffer with every copy set to an initial value
+         * @param initial Initial coefficients
+         */
+        explicit CoefficientBuffer(const T &initial = T{})
+        {
+            for (Slot &slot : slots)
+            {
+                slot.value = initial;
+            }
+        }
+
+        /**
+         * @brief Publishes a new coefficient set (control thread)
+         * @param coefficients Coefficients to hand over
+         */
+        void Publish(const T &coefficients)
+        {
+            slots[back].value = coefficients;
+            back = middle.exchange(static_cast<uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX_MASK;
+        }
+
+        /**
+         * @brief Switches to the newest published set if there is one (audio thread)
+         * @return Current coefficients, valid until the next Acquire()
+         */
+        const T &Acquire()
+        {
+            if ((middle.load(std::memory_order_relaxed) & FRESH) != 0)
+            {
+                front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+            }
+            return slots[front].value;
+        }
+
+        /**
+         * @brief Gets the coefficients last returned by Acquire() (audio thread)
+         */
+        [[nodiscard]] const T &Get() const
+        {
+            return slots[front].value;
+        }
+
+    private:
+        static constexpr uint8_t INDEX_MASK = 0x3; ///< Slot index bits of middle
+        static constexpr uint8_t FRESH = 0x4;      ///< middle holds a set the reader has not taken
+
+        /**
+         * @brief One copy of the coefficients on its own cache line
+         */
+        struct alignas(CACHE_LINE_SIZE) Slot
+        {
+            T value{}; ///< Coefficient set
+        };
+
+        std::array<Slot, 3> slots; ///< Front (reader), middle (exchange) and back (writer) copies
+
+        alignas(CACHE_LINE_SIZE) uint8_t back = 1;                ///< Slot the writer fills next
+        alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> middle = 2; ///< Slot being handed over, with FRESH flag
+        alignas(CACHE_LINE_SIZE) uint8_t front = 0;               ///< Slot the reader uses
+    };
+
+} // namespace GuitarIO
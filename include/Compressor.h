@@ -0,0 +1,194 @@
+#pragma once
+
+#include "AudioProcessor.h"
+#include "CacheLine.h"
+#include "CoefficientBuffer.h"
+#include "MemoryAccounting.h"
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Level measured by a dynamics detector over each control period
+     */
+    enum class DetectorMode
+    {
+        Peak, ///< Largest absolute sample
+        Rms   ///< Root mean square
+    };
+
+    /**
+     * @brief How the channels of a dynamics processor share gain
+     */
+    enum class ChannelLink
+    {
+        Linked,     ///< One gain from the loudest key channel, applied to every channel (keeps the image)
+        Independent ///< Each channel keyed and gained on its own
+    };
+
+    /**
+     * @brief Compressor/expander settings
+     */
+    struct CompressorSettings
+    {
+        float thresholdDb = -18.0f;                 ///< Level where compression starts
+        float ratio = 4.0f;                         ///< Input dB above the threshold per output dB (>= 1)
+        float kneeDb = 6.0f;                        ///< Soft-knee width centred on the threshold
+        float expanderThresholdDb = -70.0f;         ///< Level below which downward expansion starts
+        float expanderRatio = 1.0f;                 ///< Output dB per input dB below the expander threshold (1 = off)
+        float attackMs = 5.0f;                      ///< Time to reach more gain reduction
+        float releaseMs = 100.0f;                   ///< Time to recover
+        float makeupDb = 0.0f;                      ///< Gain added after the gain computer
+        DetectorMode detector = DetectorMode::Peak; ///< Level detector
+        ChannelLink link = ChannelLink::Linked;     ///< Channel linking
+    };
+
+    /**
+     * @brief Feed-forward compressor and downward expander with an optional external sidechain
+     *
+     * Every CONTROL_INTERVAL frames the detector reduces the key signal (the input, or the
+     * sidechain) to one level per key channel with a contiguous max/sum-of-squares pass; the gain
+     * computer then works in dB with FastMath log/exp approximations, the result is smoothed with
+     * attack/release coefficients per period (scaled down for a shorter period at the end of a
+     * block), and the linear gain is ramped across the period.
+     * Only the ramp runs per sample. Per-channel state is kept as structure-of-arrays so the
+     * gain computer loops over channels rather than samples.
+     *
+     * SetSettings() and SetSampleRate() compute coefficients on the control thread and publish
+     * them through a CoefficientBuffer.
+     */
+    class Compressor : public AudioProcessor
+    {
+    public:
+        static constexpr uint32_t CONTROL_INTERVAL = 16; ///< Frames per gain computer update
+
+        /**
+         * @brief Constructs the compressor
+         * @param settings Initial settings
+         */
+        explicit Compressor(const CompressorSettings &settings = {});
+
+        /**
+         * @brief Allocates per-channel state (not real-time safe)
+         * @param spec Stream format
+         * @return true on success, false on an invalid format
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Recomputes the time constants for a new sample rate (control thread)
+         * @param sampleRate New sample rate in Hz
+         */
+        void SetSampleRate(double sampleRate) override;
+
+        /**
+         * @brief Compresses an interleaved block in place, keyed by itself
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Number of interleaved channels (must match Prepare())
+         */
+        void Process(std::span<float> buffer, uint32_t channels) override;
+
+        /**
+         * @brief Compresses an interleaved block in place, keyed by an external signal
+         *
+         * With Independent linking, output channel c is keyed by sidechain channel
+         * c % sidechainChannels. A sidechain shorter than the block falls back to self-keying.
+         *
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Number of interleaved channels (must match Prepare())
+         * @param sidechain Interleaved key signal (frames * sidechainChannels)
+         * @param sidechainChannels Number of interleaved key channels
+         */
+        void Process(std::span<float> buffer,
+            uint32_t channels,
+            std::span<const float> sidechain,
+            uint32_t sidechainChannels);
+
+        /**
+         * @brief Returns to the makeup gain with released detectors
+         */
+        void Reset() override;
+
+        /**
+         * @brief Gets the tail (0: silent input gives silent output)
+         */
+        [[nodiscard]] uint32_t GetTailFrames() const override;
+
+        /**
+         * @brief Replaces the settings (control thread)
+         * @param settings New settings
+         */
+        void SetSettings(const CompressorSettings &settings);
+
+        /**
+         * @brief Gets the settings last passed to the constructor or SetSettings() (control thread)
+         */
+        [[nodiscard]] CompressorSettings GetSettings() const;
+
+        /**
+         * @brief Gets the gain reduction of the last processed block, deepest channel (any thread)
+         * @return Reduction in dB (<= 0, makeup excluded)
+         */
+        [[nodiscard]] float GetGainReductionDb() const;
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief Gain computer and detector constants, handed to the audio thread as one set
+         */
+        struct Coefficients
+        {
+            float threshold = 0.0f;                     ///< Compression threshold in dB
+            float slope = 0.0f;                         ///< 1 / ratio - 1 (<= 0)
+            float knee = 0.0f;                          ///< Knee width in dB
+            float expanderThreshold = 0.0f;             ///< Expansion threshold in dB
+            float expanderSlope = 0.0f;                 ///< expanderRatio - 1 (>= 0)
+            float attack = 0.0f;                        ///< Smoothing coefficient per period when reducing
+            float release = 0.0f;                       ///< Smoothing coefficient per period when recovering
+            float makeup = 0.0f;                        ///< Makeup gain in dB
+            DetectorMode detector = DetectorMode::Peak; ///< Level detector
+            ChannelLink link = ChannelLink::Linked;     ///< Channel linking
+        };
+
+        /**
+         * @brief Computes and publishes the coefficient set (control thread)
+         */
+        void PublishCoefficients();
+
+        /**
+         * @brief Measures one period of the key signal into levels (dB per key channel)
+         * @param key Interleaved key samples of the period
+         * @param keyChannels Key channel count
+         * @param linked Reduce all key channels to levels[0]
+         * @param detector Level detector
+         */
+        void Detect(std::span<const float> key, uint32_t keyChannels, bool linked, DetectorMode detector);
+
+        /**
+         * @brief Processes a block keyed by key (audio thread)
+         * @param buffer Interleaved samples processed in place
+         * @param key Interleaved key signal
+         * @param keyChannels Key channel count
+         */
+        void ProcessKeyed(std::span<float> buffer, std::span<const float> key, uint32_t keyChannels);
+
+        alignas(CACHE_LINE_SIZE) std::atomic<float> gainReductionDb = 0.0f; ///< Meter (audio-written)
+
+        alignas(CACHE_LINE_SIZE) CompressorSettings settings; ///< Control-side settings
+        double sampleRate = 0.0;                              ///< Control-side sample rate
+        CoefficientBuffer<Coefficients> coefficients;         ///< Control-to-audio hand-over
+        uint32_t channels = 0;                                ///< Prepared channel count
+        TaggedVector<float> levels;                           ///< Detected level per key channel [dB]
+        TaggedVector<float> reductions;                       ///< Smoothed gain reduction per channel [dB]
+        TaggedVector<float> gains;                            ///< Linear gain per channel at the end of the last period
+        std::string lastError;                                ///< Last error message
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "MemoryAccounting.h"
+#include <cstdint>
+#include <span>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Fractional delay interpolation methods
+     */
+    enum class DelayInterpolation
+    {
+        Linear,   ///< Two-point linear (cheapest, high-frequency loss when modulated)
+        Lagrange, ///< Four-point third-order Lagrange (flat response, the default for modulation)
+        Allpass   ///< First-order allpass (flat magnitude, stateful; best for slowly varying delays)
+    };
+
+    /**
+     * @brief Mono circular delay line with fractional, per-sample modulated reads
+     *
+     * Storage is a power-of-two ring indexed with a mask, followed by a mirrored copy of its
+     * first maxBlockFrames + 4 samples, so any interpolation window or block read starting
+     * inside the ring is contiguous in memory and never wraps: reads carry no per-sample
+     * branches or modulo.
+     *
+     * A read of N samples is aligned with the last N written samples: output[i] is the signal
+     * delays[i] frames before the (N - i)-th most recent written sample, so the usual order is
+     * Write() the block, then read it back with any number of taps. Feedback paths read before
+     * writing and subtract the read length from their delays. Reads run three plain loops over
+     * the block: a position pass (clamp, ring index, fraction), a gather copying each point of
+     * the interpolation windows into contiguous scratch, and a weighting pass over that scratch.
+     * The compiler vectorizes the position and weighting passes; the gather stays a scalar
+     * indexed copy and the allpass recursion is inherently serial per tap.
+     */
+    class DelayLine
+    {
+    public:
+        /**
+         * @brief Allocates the ring (not real-time safe)
+         * @param maxDelayFrames Longest delay that will be read
+         * @param maxBlockFrames Largest block passed to Write() and the Read functions
+         * @return true on success, false on an invalid size
+         */
+        bool Prepare(uint32_t maxDelayFrames, uint32_t maxBlockFrames);
+
+        /**
+         * @brief Clears the ring
+         */
+        void Reset();
+
+        /**
+         * @brief Appends a block
+         * @param input Samples (at most maxBlockFrames)
+         */
+        void Write(std::span<const float> input);
+
+        /**
+         * @brief Reads at a constant delay with linear interpolation (one contiguous window)
+         * @param delay Delay in frames (clamped to [0, maxDelayFrames])
+         * @param output Destination (at most maxBlockFrames)
+         */
+        void ReadFixed(float delay, std::span<float> output) const;
+
+        /**
+         * @brief Reads with a per-sample delay and linear interpolation
+         * @param delays Delay in frames for each output sample (clamped to [0, maxDelayFrames])
+         * @param output Destination, same size as delays
+         */
+        void ReadLinear(std::span<const float> delays, std::span<float> output);
+
+        /**
+         * @brief Reads with a per-sample delay and third-order Lagrange interpolation
+         * @param delays Delay in frames for each output sample (clamped to [1, maxDelayFrames])
+         * @param output Destination, same size as delays
+         */
+        void ReadLagrange(std::span<const float> delays, std::span<float> output);
+
+        /**
+         * @brief Reads with a per-sample delay through a first-order allpass interpolator
+         * @param delays Delay in frames for each output sample (clamped to [1, maxDelayFrames])
+         * @param output Destination, same size as delays
+         * @param state Allpass memory of this tap (zero it when the tap starts)
+         */
+        void ReadAllpass(std::span<const float> delays, std::span<float> output, float &state);
+
+        /**
+         * @brief Reads with a per-sample delay using the given interpolation
+         * @param delays Delay in frames for each output sample
+         * @param output Destination, same size as delays
+         * @param interpolation Interpolation method
+         * @param allpassState Allpass memory of this tap (used by DelayInterpolation::Allpass only)
+         */
+        void Read(std::span<const float> delays,
+            std::span<float> output,
+            DelayInterpolation interpolation,
+            float &allpassState);
+
+        /**
+         * @brief Gets the longest supported delay in frames
+         */
+        [[nodiscard]] uint32_t GetMaxDelayFrames() const;
+
+        /**
+         * @brief Gets the ring size in frames (a power of two)
+         */
+        [[nodiscard]] uint32_t GetCapacity() const;
+
+    private:
+        /**
+         * @brief Splits each read position into a masked ring index and a fraction (vectorized pass)
+         * @param delays Delay for each output sample
+         * @param minDelay Lower clamp for the delays
+         * @param windowStart Offset of the first interpolation point from the integer position
+         */
+        void ComputePositions(std::span<const float> delays, float minDelay, int32_t windowStart);
+
+        /**
+         * @brief Copies the interpolation windows at indices[] into points[] (gather pass)
+         * @param count Samples in the block
+         * @param width Points per window (at most 4)
+         */
+        void GatherWindows(size_t count, uint32_t width);
+
+        TaggedVector<float> data;       ///< Ring followed by its mirrored tail
+        TaggedVector<uint32_t> indices; ///< Per-sample ring index of the interpolation window
+        TaggedVector<float> fractions;  ///< Per-sample fractional position
+        TaggedVector<float> points;     ///< Gathered window points [point][sample], maxBlockFrames each
+        uint32_t capacity = 0;          ///< Ring size (power of two)
+        uint32_t mask = 0;              ///< capacity - 1
+        uint32_t mirror = 0;            ///< Samples duplicated past the end of the ring
+        uint32_t maxDelay = 0;          ///< Longest supported delay
+        uint32_t maxBlock = 0;          ///< Largest block
+        uint32_t writePosition = 0;     ///< Running count of written samples (wraps; masked on use)
+    };
+
+} // namespace GuitarIO
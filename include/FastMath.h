@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Branch-free float approximations for gain computers, meters and network activations
+     *
+     * Exponent/mantissa split plus a short polynomial and no tables, so loops over them vectorize.
+     * Errors are far below what a level detector, gain stage or trained network can resolve but
+     * too large for oscillators and filter design; use <cmath> there.
+     */
+    namespace FastMath
+    {
+        constexpr float DB_PER_LOG2 = 6.02059991f;        ///< 20 * log10(2)
+        constexpr float LOG2_PER_DB = 1.0f / DB_PER_LOG2; ///< Inverse of DB_PER_LOG2
+        constexpr float LOG2_E = 1.44269504f;             ///< log2(e), converts natural exponents for Exp2
+
+        /**
+         * @brief Base-2 logarithm, absolute error below 2e-5 and exact at powers of two
+         * @param x Positive value (zero and denormals read as about -127)
+         */
+        inline float Log2(float x)
+        {
+            const auto bits = std::bit_cast<uint32_t>(x);
+            const auto exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+            const float t = std::bit_cast<float>((bits & 0x007FFFFFu) | 0x3F800000u) - 1.0f; // mantissa - 1
+
+            // Least-squares fit of log2(1 + t) on [0, 1), constrained through zero
+            const float p = ((0.0452682925f * t - 0.193516524f) * t + 0.41524556f) * t - 0.708865218f;
+            return exponent + (p * t + 1.4418799f) * t;
+        }
+
+        /**
+         * @brief Power of two, relative error below 1e-5 and exact at integers (0 dB is unity gain)
+         * @param x Exponent (clamped to [-126, 126])
+         */
+        inline float Exp2(float x)
+        {
+            // Clamp and round without branches or libm calls so loops over Exp2 vectorize. Float
+            // min/max followed by adds defeats if-conversion under the default trapping-math rules,
+            // so the clamp is an unsigned min on the magnitude bits (non-negative floats order like
+            // their bit patterns), exact for every input including infinities. Adding 1.5 * 2^23
+            // leaves no fraction bits, so the round trip rounds to the nearest integer (strict float
+            // semantics; no -ffast-math or /fp:fast)
+            constexpr uint32_t SIGN_MASK = 0x80000000u;
+            constexpr float ROUND_MAGIC = 12582912.0f;
+            const auto bits = std::bit_cast<uint32_t>(x);
+            const uint32_t magnitude = std::min(bits & ~SIGN_MASK, std::bit_cast<uint32_t>(126.0f));
+            x = std::bit_cast<float>(magnitude | (bits & SIGN_MASK));
+            const float whole = (x + ROUND_MAGIC) - ROUND_MAGIC;
+            const float t = x - whole;
+
+            // Minimax fit of 2^t - 1 on [-0.5, 0.5], constrained through zero
+            const float p = (((0.00958283567f * t + 0.0559064392f) * t + 0.240240991f) * t + 0.693124191f) * t;
+            const auto scale = std::bit_cast<float>(static_cast<uint32_t>(static_cast<int32_t>(whole) + 127) << 23);
+            return (p + 1.0f) * scale;
+        }
+
+        /**
+         * @brief Linear amplitude to decibels
+         * @param amplitude Positive amplitude
+         */
+        inline float AmplitudeToDb(float amplitude)
+        {
+            return DB_PER_LOG2 * Log2(amplitude);
+        }
+
+        /**
+         * @brief Decibels to linear amplitude
+         * @param db Level in dB
+         */
+        inline float DbToAmplitude(float db)
+        {
+            return Exp2(db * LOG2_PER_DB);
+        }
+
+        /**
+         * @brief Hyperbolic tangent, absolute error below 1e-5 (neural network activations)
+         * @param x Argument
+         */
+        inline float Tanh(float x)
+        {
+            return 1.0f - 2.0f / (Exp2(2.0f * LOG2_E * x) + 1.0f);
+        }
+
+        /**
+         * @brief Logistic sigmoid 1 / (1 + e^-x), absolute error below 1e-5
+         * @param x Argument
+         */
+        inline float Sigmoid(float x)
+        {
+            return 1.0f / (Exp2(-LOG2_E * x) + 1.0f);
+        }
+    } // namespace FastMath
+
+} // namespace GuitarIO
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "AudioProcessor.h"
+#include "CacheLine.h"
+#include "CoefficientBuffer.h"
+#include "DelayLine.h"
+#include "LaneKernels.h"
+#include "MemoryAccounting.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Feedback matrix of an FDN reverb
+     */
+    enum class FdnMatrix
+    {
+        Hadamard,   ///< Fast Walsh-Hadamard transform (log2(N) butterfly stages, densest mixing)
+        Householder ///< I - 2/N * ones (one sum per frame, cheapest; lines mix more slowly)
+    };
+
+    /**
+     * @brief FDN reverb configuration
+     */
+    struct FdnReverbConfig
+    {
+        float sizeMs = 80.0f;                   ///< Longest delay line
+        float spread = 0.4f;                    ///< Shortest line as a fraction of sizeMs
+        float decaySeconds = 2.0f;              ///< Time for the tail to fall by 60 dB
+        float dampingHz = 6000.0f;              ///< In-loop low-pass cut-off (highs decay faster)
+        float mix = 0.3f;                       ///< Wet share of the output
+        FdnMatrix matrix = FdnMatrix::Hadamard; ///< Feedback matrix
+    };
+
+    /**
+     * @brief Feedback delay network reverb with Lines parallel delay lines (8 or 16)
+     *
+     * The network runs in chunks no longer than the shortest line (and at most MAX_CHUNK_FRAMES),
+     * so each chunk's delay outputs are already in the lines: every line is read as one contiguous
+     * block, the blocks are packed into a LaneKernels lane block (frame-major, Lines wide), decay
+     * gain and damping low-pass run as Lines-wide vector operations, the feedback matrix is applied
+     * in place per frame, and the result is unpacked and written back. Lines are coprime lengths
+     * spread exponentially between spread * sizeMs and sizeMs.
+     *
+     * The input is the channel average; even output channels take one decorrelated tap mix, odd
+     * channels another. Decay, damping and rate changes are computed on the control thread and
+     * published through a CoefficientBuffer; nothing allocates after Prepare().
+     *
+     * @tparam Lines Number of delay lines (8 or 16)
+     */
+    template<size_t Lines> class FdnReverb : public AudioProcessor
+    {
+        static_assert(Lines == 8 || Lines == 16, "FdnReverb supports 8 or 16 lines");
+
+    public:
+        static constexpr uint32_t MAX_CHUNK_FRAMES = 64; ///< Longest run processed as one lane block
+
+        /**
+         * @brief Constructs the reverb
+         * @param config Initial configuration
+         */
+        explicit FdnReverb(const FdnReverbConfig &config = {});
+
+        /**
+         * @brief Allocates the delay lines for spec.GetMaxSampleRate() (not real-time safe)
+         * @param spec Stream format
+         * @return true on success, false on an invalid format
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Recomputes line lengths and gains for a new sample rate (control thread)
+         * @param sampleRate New sample rate in Hz (clamped to the prepared maximum)
+         */
+        void SetSampleRate(double sampleRate) override;
+
+        /**
+         * @brief Processes an interleaved block in place
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Number of interleaved channels (must match Prepare())
+         */
+        void Process(std::span<float> buffer, uint32_t channels) override;
+
+        /**
+         * @brief Clears the delay lines and damping filters
+         */
+        void Reset() override;
+
+        /**
+         * @brief Gets the decay time plus the longest line, in frames (audio thread)
+         */
+        [[nodiscard]] uint32_t GetTailFrames() const override;
+
+        /**
+         * @brief Sets the decay time (control thread)
+         * @param seconds Time for the tail to fall by 60 dB
+         */
+        void SetDecay(float seconds);
+
+        /**
+         * @brief Sets the damping cut-off (control thread)
+         * @param hz In-loop low-pass cut-off
+         */
+        void SetDamping(float hz);
+
+        /**
+         * @brief Sets the wet share of the output (safe from any thread)
+         * @param mix 0 = dry only, 1 = wet only
+         */
+        void SetMix(float mix);
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief Rate- and decay-dependent values, handed to the audio thread as one set
+         */
+        struct Coefficients
+        {
+            std::array<uint32_t, Lines> delays{}; ///< Line lengths in frames
+            std::array<float, Lines> gains{};     ///< Per-line decay gain (Hadamard scaling folded in)
+            std::array<float, Lines> damping{};   ///< One-pole low-pass coefficient per line
+            uint32_t chunkFrames = 1;             ///< Frames per lane block
+            uint32_t tailFrames = 0;              ///< Decay time plus the longest line
+            double sampleRate = 0.0;              ///< Rate the set was computed for
+        };
+
+        /**
+         * @brief Computes and publishes the coefficient set (control thread)
+         */
+        void PublishCoefficients();
+
+        /**
+         * @brief Runs the network over one chunk (audio thread)
+         * @param block Interleaved samples of the chunk, processed in place
+         * @param coefficients Current coefficient set
+         * @param mix Wet share
+         */
+        void ProcessChunk(std::span<float> block, const Coefficients &coefficients, float mix);
+
+        alignas(CACHE_LINE_SIZE) std::atomic<float> mix; ///< Wet share
+
+        alignas(CACHE_LINE_SIZE) FdnReverbConfig config;      ///< Size, matrix and control-side decay/damping
+        double sampleRate = 0.0;                              ///< Control-side sample rate
+        double maxSampleRate = 0.0;                           ///< Prepared maximum rate
+        CoefficientBuffer<Coefficients> coefficients;         ///< Control-to-audio hand-over
+        uint32_t channels = 0;                                ///< Prepared channel count
+        std::array<DelayLine, Lines> lines;                   ///< Delay lines
+        std::array<std::span<const float>, Lines> readBlocks; ///< Per-line views of lineBlocks for Pack
+        std::array<std::span<float>, Lines> writeBlocks;      ///< Per-line views of lineBlocks for Unpack
+        TaggedVector<float> lineBlocks;                       ///< Per-line chunk [line][frame]
+        TaggedVector<float> lanes;                            ///< Lane block [frame][line]
+        TaggedVector<float> input;                            ///< Mono input of a chunk
+        LaneFilterState<Lines> dampingState;                  ///< Damping filter memory
+        std::string lastError;                                ///< Last error message
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "MemoryAccounting.h"
+#include <complex>
+#include <cstdint>
+#include <span>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Power-of-two real FFT
+     *
+     * A real transform of size N runs as one complex radix-2 transform of size N/2 on the
+     * even/odd samples packed as real/imaginary parts, followed by a split pass, so it costs about
+     * half a complex transform of size N. Twiddles and the bit-reversal table are computed by
+     * Prepare(); Forward() and Inverse() do not allocate but use per-instance scratch, so one
+     * instance must not be shared between threads.
+     */
+    class Fft
+    {
+    public:
+        static constexpr uint32_t MIN_SIZE = 4;       ///< Smallest transform size
+        static constexpr uint32_t MAX_SIZE = 1 << 20; ///< Largest transform size
+
+        /**
+         * @brief Builds the tables for a transform size (allocates, not real-time safe)
+         * @param size Transform size (power of two in [MIN_SIZE, MAX_SIZE])
+         * @return false if the size is not supported
+         */
+        bool Prepare(uint32_t size);
+
+        /**
+         * @brief Forward transform of real samples
+         * @param input GetSize() real samples
+         * @param output GetSize() / 2 + 1 bins (DC to Nyquist), unscaled
+         */
+        void Forward(std::span<const float> input, std::span<std::complex<float>> output);
+
+        /**
+         * @brief Inverse transform back to real samples
+         * @param input GetSize() / 2 + 1 bins (DC to Nyquist)
+         * @param output GetSize() real samples, unscaled (Inverse(Forward(x)) = GetSize() * x)
+         */
+        void Inverse(std::span<const std::complex<float>> input, std::span<float> output);
+
+        /**
+         * @brief Gets the prepared transform size (0 before Prepare())
+         */
+        [[nodiscard]] uint32_t GetSize() const
+        {
+            return size;
+        }
+
+    private:
+        /**
+         * @brief In-place complex transform of size / 2 points held in scratch
+         * @param inverse Conjugate twiddles (unscaled inverse)
+         */
+        void Transform(bool inverse);
+
+        uint32_t size = 0;                                          ///< Real transform size
+        TaggedVector<std::complex<float>, MemoryTag::Fft> twiddles; ///< e^(-2 pi i k / size), k < size / 2
+        TaggedVector<uint32_t, MemoryTag::Fft> bitReversal;         ///< Bit-reversed index per complex point
+        TaggedVector<std::complex<float>, MemoryTag::Fft> scratch;  ///< Packed complex points
+    };
+
+} // namespace GuitarIO
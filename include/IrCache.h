@@ -0,0 +1,315 @@
+#pragma once
+
+#include "AsyncExecutor.h"
+#include "MemoryAccounting.h"
+#include <atomic>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Binary layout of impulse response cache files written by IrCache
+     *
+     * A cache file is this header followed by channels * partitionCount * (partitionFrames + 1)
+     * complex<float> bins in native byte order, laid out [channel][partition][bin]. The header is
+     * padded to 64 bytes so the bins of a mapped file start cache-line aligned.
+     */
+    struct IrCacheHeader
+    {
+        static constexpr uint32_t MAGIC = 0x47495243; ///< "GIRC"
+        static constexpr uint32_t VERSION = 1;        ///< Format version
+
+        uint32_t magic = MAGIC;       ///< Format identifier
+        uint32_t version = VERSION;   ///< Format version
+        uint64_t sourceHash = 0;      ///< FNV-1a hash of the source file bytes
+        uint32_t sampleRate = 0;      ///< Rate the response was resampled to (Hz)
+        uint32_t partitionFrames = 0; ///< Frames per partition (FFT size / 2)
+        uint32_t partitionCount = 0;  ///< Partitions per channel
+        uint32_t channels = 0;        ///< Response channels
+        uint32_t lengthFrames = 0;    ///< Response length at sampleRate
+        uint32_t reserved[7] = {};    ///< Zero; pads the header to 64 bytes
+    };
+
+    static_assert(sizeof(IrCacheHeader) == 64, "Cache file header must stay 64 bytes");
+
+    /**
+     * @brief Impulse response stored as frequency-domain partitions
+     *
+     * The response is cut into partitions of partitionFrames samples, each zero-padded to
+     * 2 * partitionFrames and transformed with a real FFT, giving partitionFrames + 1 bins per
+     * partition. Bins are pre-scaled by 1 / (2 * partitionFrames), so a convolver multiplying them
+     * with an unscaled Fft::Forward() spectrum gets correctly scaled output from Fft::Inverse().
+     *
+     * Assets are immutable and shared between presets; the bins are either a read-only mapping of
+     * a cache file or a heap copy. Every accessor is real-time safe.
+     */
+    class IrAsset
+    {
+    public:
+        /**
+         * @brief Destructor (unmaps or frees the bins)
+         */
+        ~IrAsset();
+
+        IrAsset(const IrAsset &) = delete;
+
+        IrAsset &operator=(const IrAsset &) = delete;
+
+        /**
+         * @brief Gets the bins of one partition
+         * @param channel Response channel
+         * @param index Partition index (0 = earliest)
+         * @return partitionFrames + 1 bins, or an empty span when out of range
+         */
+        [[nodiscard]] std::span<const std::complex<float>> GetPartition(uint32_t channel, uint32_t index) const;
+
+        /**
+         * @brief Gets the sample rate the response was resampled to
+         */
+        [[nodiscard]] uint32_t GetSampleRate() const
+        {
+            return header.sampleRate;
+        }
+
+        /**
+         * @brief Gets the frames per partition
+         */
+        [[nodiscard]] uint32_t GetPartitionFrames() const
+        {
+            return header.partitionFrames;
+        }
+
+        /**
+         * @brief Gets the number of partitions per channel
+         */
+        [[nodiscard]] uint32_t GetPartitionCount() const
+        {
+            return header.partitionCount;
+        }
+
+        /**
+         * @brief Gets the number of response channels
+         */
+        [[nodiscard]] uint32_t GetChannels() const
+        {
+            return header.channels;
+        }
+
+        /**
+         * @brief Gets the response length in frames at GetSampleRate()
+         */
+        [[nodiscard]] uint32_t GetLengthFrames() const
+        {
+            return header.lengthFrames;
+        }
+
+        /**
+         * @brief Gets the hash of the source file the asset was built from
+         */
+        [[nodiscard]] uint64_t GetSourceHash() const
+        {
+            return header.sourceHash;
+        }
+
+        /**
+         * @brief Checks whether the bins are mapped from a cache file rather than held on the heap
+         */
+        [[nodiscard]] bool IsMapped() const
+        {
+            return mapping != nullptr;
+        }
+
+    private:
+        friend class IrCache;
+
+        /**
+         * @brief Constructs an empty asset (filled in by IrCache)
+         */
+        IrAsset() = default;
+
+        IrCacheHeader header;                                      ///< Layout of bins
+        const std::complex<float> *bins = nullptr;                 ///< First bin of channel 0, partition 0
+        void *mapping = nullptr;                                   ///< Mapped cache file (null for heap assets)
+        size_t mappingBytes = 0;                                   ///< Size of mapping
+        std::optional<MemoryReservation> mappedFootprint;          ///< Charges mapping to MemoryTag::Fft
+        TaggedVector<std::complex<float>, MemoryTag::Fft> storage; ///< Heap bins when not mapped
+    };
+
+    /**
+     * @brief Cache of partitioned impulse responses keyed by (file hash, sample rate, partition size)
+     *
+     * Building an asset decodes the WAV file, resamples it to the stream rate, partitions and
+     * transforms it, and writes the result to `<directory>/<hash>-<rate>-<partitionFrames>.girc`.
+     * Later loads of the same content, from this or any later process, hash the file and map
+     * the cache file instead, so a preset change costs a file read and an mmap. Loads repeated
+     * within one cache instance skip even the hash as long as the file's size and modification
+     * time are unchanged.
+     *
+     * Warm() builds the assets for a set of files on an AsyncExecutor so that the first preset
+     * load is fast as well. All methods are thread-safe and none may be called from the audio
+     * thread; the returned assets are what the audio thread reads.
+     *
+     * Supported sources are RIFF/WAVE files with 16, 24 or 32-bit integer PCM or 32-bit float
+     * samples. Cache files are mapped on Linux and macOS and read into memory elsewhere.
+     */
+    class IrCache
+    {
+    public:
+        static constexpr uint32_t MIN_PARTITION_FRAMES = 32;    ///< Smallest partition
+        static constexpr uint32_t MAX_PARTITION_FRAMES = 8192;  ///< Largest partition
+        static constexpr uint32_t MAX_CHANNELS = 8;             ///< Most response channels
+        static constexpr uint32_t MAX_LENGTH_FRAMES = 1u << 20; ///< Longest response after resampling
+
+        /**
+         * @brief Constructs a cache storing its files in a directory (created on first write)
+         * @param directory Cache file directory
+         */
+        explicit IrCache(std::filesystem::path directory);
+
+        /**
+         * @brief Destructor (waits for pending Warm() work)
+         */
+        ~IrCache();
+
+        IrCache(const IrCache &) = delete;
+
+        IrCache &operator=(const IrCache &) = delete;
+
+        /**
+         * @brief Gets the partitioned response of a WAV file, building and storing it on a miss
+         * @param path WAV file
+         * @param sampleRate Stream sample rate (Hz)
+         * @param partitionFrames Frames per partition (power of two in [MIN_PARTITION_FRAMES, MAX_PARTITION_FRAMES])
+         * @return Shared asset, or null on failure (see GetLastError())
+         */
+        std::shared_ptr<const IrAsset> Load(const std::filesystem::path &path,
+            uint32_t sampleRate,
+            uint32_t partitionFrames);
+
+        /**
+         * @brief Builds or maps assets for several files in the background
+         *
+         * Each file is loaded by its own task on the executor. Failures are reported through
+         * GetLastError(); successful loads land in the in-memory index so the next Load() of the
+         * same file is a lookup. The executor must outlive the warm-up (see WaitForWarm()).
+         *
+         * @param executor Executor running the loads
+         * @param paths WAV files
+         * @param sampleRate Stream sample rate (Hz)
+         * @param partitionFrames Frames per partition
+         */
+        void Warm(AsyncExecutor &executor,
+            std::vector<std::filesystem::path> paths,
+            uint32_t sampleRate,
+            uint32_t partitionFrames);
+
+        /**
+         * @brief Checks whether Warm() tasks are still running
+         */
+        [[nodiscard]] bool IsWarming() const;
+
+        /**
+         * @brief Blocks until every Warm() task has finished
+         */
+        void WaitForWarm();
+
+        /**
+         * @brief Drops the in-memory index (cache files stay on disk; assets in use stay valid)
+         */
+        void Clear();
+
+        /**
+         * @brief Gets the cache file directory
+         */
+        [[nodiscard]] const std::filesystem::path &GetDirectory() const
+        {
+            return directory;
+        }
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief In-memory index entry
+         */
+        struct Entry
+        {
+            std::filesystem::file_time_type modified; ///< Source modification time when loaded
+            uintmax_t size = 0;                       ///< Source size when loaded
+            std::shared_ptr<const IrAsset> asset;     ///< Loaded asset
+        };
+
+        /**
+         * @brief Maps (or reads) a cache file
+         * @param file Cache file
+         * @param hash Expected source hash
+         * @param sampleRate Expected sample rate
+         * @param partitionFrames Expected partition size
+         * @return Asset, or null if the file is missing, stale or corrupt
+         */
+        static std::shared_ptr<IrAsset> Open(const std::filesystem::path &file,
+            uint64_t hash,
+            uint32_t sampleRate,
+            uint32_t partitionFrames);
+
+        /**
+         * @brief Decodes, resamples and partitions a WAV file
+         * @param bytes Source file contents
+         * @param hash Hash of bytes
+         * @param sampleRate Target sample rate
+         * @param partitionFrames Frames per partition
+         * @param error Set on failure
+         * @return Heap asset, or null on failure
+         */
+        static std::shared_ptr<IrAsset> Build(std::span<const uint8_t> bytes,
+            uint64_t hash,
+            uint32_t sampleRate,
+            uint32_t partitionFrames,
+            std::string &error);
+
+        /**
+         * @brief Writes an asset to a cache file through a temporary file and a rename
+         * @param file Cache file
+         * @param asset Asset to store
+         * @return true on success
+         */
+        static bool Store(const std::filesystem::path &file, const IrAsset &asset);
+
+        /**
+         * @brief Warm() task loading one file on an executor worker
+         * @param path WAV file
+         * @param sampleRate Stream sample rate (Hz)
+         * @param partitionFrames Frames per partition
+         */
+        AsyncTask WarmOne(std::filesystem::path path, uint32_t sampleRate, uint32_t partitionFrames);
+
+        /**
+         * @brief Records an error message
+         * @param message Error message
+         */
+        void SetError(std::string message);
+
+        std::filesystem::path directory;    ///< Cache file directory
+        mutable std::mutex mutex;           ///< Guards index and lastError
+        std::map<std::string, Entry> index; ///< Loaded assets by path, rate and partition size
+        std::string lastError;              ///< Last error message
+
+        std::atomic<uint32_t> warming = 0; ///< Warm() tasks not finished
+        std::mutex warmMutex;              ///< Guards warmDone waits
+        std::condition_variable warmDone;  ///< Signals warming reaching zero
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "MemoryAccounting.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Jitter buffer configuration
+     */
+    struct JitterBufferConfig
+    {
+        uint32_t sampleRate = 48000;   ///< Sample rate (Hz)
+        uint32_t channels = 1;         ///< Interleaved channels per frame
+        uint32_t packetFrames = 128;   ///< Frames carried by every packet
+        uint32_t capacityPackets = 64; ///< Reorder window (rounded up to a power of two)
+        uint32_t minDepthPackets = 1;  ///< Lower bound of the adaptive target depth
+        uint32_t maxDepthPackets = 32; ///< Upper bound of the adaptive target depth
+        float jitterMultiplier = 3.0f; ///< Target depth in multiples of measured jitter
+        uint32_t crossfadeFrames = 32; ///< Crossfade length when audio resumes after concealment
+    };
+
+    /**
+     * @brief Jitter buffer statistics
+     */
+    struct JitterBufferStats
+    {
+        uint64_t packetsReceived = 0;    ///< Packets accepted by Insert()
+        uint64_t packetsLate = 0;        ///< Packets that arrived after their playout time
+        uint64_t packetsDuplicate = 0;   ///< Packets received twice
+        uint64_t packetsOverflow = 0;    ///< Packets too far ahead of the playout position to fit the buffer
+        uint64_t packetsConcealed = 0;   ///< Packets replaced by waveform extrapolation
+        uint64_t packetsDiscarded = 0;   ///< Packets skipped to shrink the buffer toward its target
+        double jitterMs = 0.0;           ///< Interarrival jitter estimate (RFC 3550)
+        uint32_t targetDepthPackets = 0; ///< Current adaptive target depth
+        uint32_t depthPackets = 0;       ///< Packets between playout position and newest packet
+    };
+
+    /**
+     * @brief Adaptive jitter buffer turning timestamped network packets into fixed-size blocks
+     *
+     * Insert() is called from one network thread and is lock-free: packets land in the slot
+     * selected by their sequence number, which reorders them for free. Read() is called from the
+     * audio thread, takes constant time per packet and never allocates. Missing packets are
+     * concealed by repeating the last pitch period of the output with a fade; the target depth
+     * follows the measured interarrival jitter and excess depth is trimmed by skipping packets.
+     */
+    class JitterBuffer
+    {
+    public:
+        /**
+         * @brief Constructs a jitter buffer
+         * @param config Buffer configuration
+         */
+        explicit JitterBuffer(const JitterBufferConfig &config = {});
+
+        /**
+         * @brief Inserts a packet (network thread)
+         * @param sequence Packet sequence number (timestamp / packetFrames, wraps at 2^32)
+         * @param samples Interleaved samples (packetFrames * channels)
+         * @return true if the packet was stored, false if late, duplicate, malformed or too early
+         */
+        bool Insert(uint32_t sequence, std::span<const float> samples);
+
+        /**
+         * @brief Reads the next output block (audio thread)
+         * @param block Interleaved destination buffer (whole frames, any size)
+         */
+        void Read(std::span<float> block);
+
+        /**
+         * @brief Discards all packets and restarts buffering (not thread-safe)
+         */
+        void Reset();
+
+        /**
+         * @brief Gets the buffer statistics
+         */
+        [[nodiscard]] JitterBufferStats GetStats() const;
+
+        /**
+         * @brief Gets the configuration
+         */
+        [[nodiscard]] const JitterBufferConfig &GetConfig() const;
+
+    private:
+        /**
+         * @brief Packet storage slot
+         */
+        struct Slot
+        {
+            std::atomic<int64_t> sequence = -1; ///< Sequence stored in the slot (-1 = empty)
+        };
+
+        /**
+         * @brief Loads the next packet (or its concealment) into the current packet buffer
+         */
+        void NextPacket();
+
+        /**
+         * @brief Fills the current packet buffer by extending the output history periodically
+         */
+        void Conceal();
+
+        /**
+         * @brief Estimates the dominant period of the output history
+         * @return Period in frames
+         */
+        [[nodiscard]] size_t EstimatePeriod() const;
+
+        /**
+         * @brief Appends the current packet buffer to the output history
+         */
+        void PushHistory(std::span<const float> packet);
+
+        /**
+         * @brief Recomputes the target depth from the jitter estimate
+         */
+        [[nodiscard]] uint32_t ComputeTargetDepth() const;
+
+        JitterBufferConfig config;                         ///< Configuration
+        size_t packetSamples = 0;                          ///< Samples per packet (frames * channels)
+        uint32_t mask = 0;                                 ///< Slot index mask
+        std::unique_ptr<Slot[]> slots;                     ///< Packet slots
+        TaggedVector<float, MemoryTag::Rings> slotSamples; ///< Sample storage, one packet per slot
+
+        // Shared between the network and audio threads
+        std::atomic<int64_t> readSequence = -1;     ///< Next sequence to play (-1 = no packet yet)
+        std::atomic<uint32_t> newestSequence = 0;   ///< Newest sequence received
+        std::atomic<float> jitterFrames = 0.0f;     ///< Interarrival jitter estimate in frames
+        std::atomic<uint64_t> packetsReceived = 0;  ///< Accepted packets
+        std::atomic<uint64_t> packetsLate = 0;      ///< Late packets
+        std::atomic<uint64_t> packetsDuplicate = 0; ///< Duplicate packets
+        std::atomic<uint64_t> packetsOverflow = 0;  ///< Early packets dropped for lack of slots
+        std::atomic<uint64_t> packetsConcealed = 0; ///< Concealed packets
+        std::atomic<uint64_t> packetsDiscarded = 0; ///< Skipped packets
+        std::atomic<uint32_t> targetDepth = 0;      ///< Last computed target depth
+
+        // Network thread only
+        bool hasArrival = false;                           ///< A previous arrival exists
+        std::chrono::steady_clock::time_point lastArrival; ///< Arrival time of the previous packet
+        uint32_t lastArrivalSequence = 0;                  ///< Sequence of the previous packet
+
+        // Audio thread only
+        bool playing = false;           ///< Prefill complete
+        TaggedVector<float> current;    ///< Packet being played
+        size_t currentFrame = 0;        ///< Next frame of current to output
+        TaggedVector<float> history;    ///< Recent output frames used for concealment
+        size_t concealPeriod = 0;       ///< Pitch period of the running concealment (frames)
+        size_t concealPhase = 0;        ///< Position inside the concealment period
+        uint32_t consecutiveLosses = 0; ///< Packets concealed in a row
+    };
+
+} // namespace GuitarIO
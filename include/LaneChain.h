@@ -0,0 +1,297 @@
+#pragma once
+
+#include "AudioProcessor.h"
+#include "CoefficientBuffer.h"
+#include "LaneKernels.h"
+#include "MemoryAccounting.h"
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Interface for a processing step that runs once for all lanes of a lane block
+     */
+    template<size_t Lanes> class LaneProcessor
+    {
+    public:
+        virtual ~LaneProcessor() = default;
+
+        /**
+         * @brief Processes a lane block in place
+         * @param soa Lane block (frames * Lanes, frame-major)
+         */
+        virtual void ProcessLanes(std::span<float> soa) = 0;
+
+        /**
+         * @brief Prepares for a stream format (not real-time safe), see AudioProcessor::Prepare()
+         * @param spec Stream format
+         * @return true on success, false if the format is not supported
+         */
+        virtual bool Prepare([[maybe_unused]] const ProcessSpec &spec)
+        {
+            return true;
+        }
+
+        /**
+         * @brief Switches to another sample rate without reallocating (control thread)
+         * @param sampleRate New sample rate in Hz (clamped to the prepared maximum)
+         */
+        virtual void SetSampleRate([[maybe_unused]] double sampleRate)
+        {
+        }
+
+        /**
+         * @brief Clears per-lane state
+         */
+        virtual void Reset()
+        {
+        }
+    };
+
+    /**
+     * @brief Independent gain per lane
+     */
+    template<size_t Lanes> class LaneGain : public LaneProcessor<Lanes>
+    {
+    public:
+        /**
+         * @brief Constructs a lane gain (unity on all lanes)
+         */
+        LaneGain();
+
+        /**
+         * @brief Sets the gain of one lane
+         * @param lane Lane index
+         * @param gain Linear gain
+         */
+        void SetGain(size_t lane, float gain);
+
+        /**
+         * @brief Processes a lane block in place
+         * @param soa Lane block (frames * Lanes, frame-major)
+         */
+        void ProcessLanes(std::span<float> soa) override;
+
+    private:
+        std::array<float, Lanes> gains{}; ///< Gain per lane
+    };
+
+    /**
+     * @brief Noise gate with a threshold per lane and shared timing
+     *
+     * SetTimes() and SetSampleRate() compute the per-sample coefficients on the control thread
+     * and publish them through a CoefficientBuffer.
+     */
+    template<size_t Lanes> class LaneNoiseGate : public LaneProcessor<Lanes>
+    {
+    public:
+        /**
+         * @brief Constructs a lane noise gate
+         * @param sampleRate Initial sample rate in Hz (replaced by Prepare())
+         */
+        explicit LaneNoiseGate(double sampleRate = 48000.0);
+
+        /**
+         * @brief Sets the open threshold of one lane
+         * @param lane Lane index
+         * @param threshold Linear amplitude threshold
+         */
+        void SetThreshold(size_t lane, float threshold);
+
+        /**
+         * @brief Sets release and gain smoothing times for all lanes (control thread)
+         * @param releaseMs Envelope release time in milliseconds
+         * @param smoothingMs Gain smoothing time in milliseconds
+         */
+        void SetTimes(double releaseMs, double smoothingMs);
+
+        /**
+         * @brief Records the maximum rate and computes the coefficients (not real-time safe)
+         * @param spec Stream format
+         * @return true on success, false on an invalid sample rate
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Recomputes the coefficients for a new sample rate (control thread)
+         * @param sampleRate New sample rate in Hz (clamped to the prepared maximum)
+         */
+        void SetSampleRate(double sampleRate) override;
+
+        /**
+         * @brief Processes a lane block in place
+         * @param soa Lane block (frames * Lanes, frame-major)
+         */
+        void ProcessLanes(std::span<float> soa) override;
+
+        /**
+         * @brief Clears per-lane state
+         */
+        void Reset() override;
+
+    private:
+        /**
+         * @brief Per-sample timing coefficients, handed to the audio thread as one set
+         */
+        struct Coefficients
+        {
+            float release = 0.0f;   ///< Envelope decay per sample
+            float smoothing = 0.0f; ///< Gain smoothing per sample
+        };
+
+        /**
+         * @brief Computes and publishes the coefficients (control thread)
+         */
+        void PublishCoefficients();
+
+        double sampleRate;                            ///< Control-side sample rate in Hz
+        double maxSampleRate = 0.0;                   ///< Prepared maximum rate (0 = not prepared)
+        double releaseMs = 50.0;                      ///< Envelope release time
+        double smoothingMs = 5.0;                     ///< Gain smoothing time
+        CoefficientBuffer<Coefficients> coefficients; ///< Control-to-audio hand-over
+        LaneGateState<Lanes> state;                   ///< Envelope and gain memory
+        std::array<float, Lanes> thresholds{};        ///< Open threshold per lane
+    };
+
+    /**
+     * @brief One-pole low-pass filter with a cutoff per lane
+     *
+     * SetCutoff() and SetSampleRate() compute the coefficients on the control thread and publish
+     * them through a CoefficientBuffer.
+     */
+    template<size_t Lanes> class LaneLowpass : public LaneProcessor<Lanes>
+    {
+    public:
+        /**
+         * @brief Constructs a lane low-pass filter (all lanes bypassed)
+         * @param sampleRate Initial sample rate in Hz (replaced by Prepare())
+         */
+        explicit LaneLowpass(double sampleRate = 48000.0);
+
+        /**
+         * @brief Sets the cutoff of one lane (control thread)
+         * @param lane Lane index
+         * @param cutoff Cutoff frequency in Hz
+         */
+        void SetCutoff(size_t lane, double cutoff);
+
+        /**
+         * @brief Records the maximum rate and computes the coefficients (not real-time safe)
+         * @param spec Stream format
+         * @return true on success, false on an invalid sample rate
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Recomputes the coefficients for a new sample rate (control thread)
+         * @param sampleRate New sample rate in Hz (clamped to the prepared maximum)
+         */
+        void SetSampleRate(double sampleRate) override;
+
+        /**
+         * @brief Processes a lane block in place
+         * @param soa Lane block (frames * Lanes, frame-major)
+         */
+        void ProcessLanes(std::span<float> soa) override;
+
+        /**
+         * @brief Clears per-lane state
+         */
+        void Reset() override;
+
+    private:
+        /**
+         * @brief Computes and publishes the coefficients (control thread)
+         */
+        void PublishCoefficients();
+
+        double sampleRate;                                        ///< Control-side sample rate in Hz
+        double maxSampleRate = 0.0;                               ///< Prepared maximum rate (0 = not prepared)
+        std::array<double, Lanes> cutoffs{};                      ///< Cutoff per lane in Hz (infinite = bypassed)
+        CoefficientBuffer<std::array<float, Lanes>> coefficients; ///< Smoothing coefficient per lane
+        LaneFilterState<Lanes> state;                             ///< Filter memory
+    };
+
+    /**
+     * @brief Runs one processing chain for Lanes independent streams in structure-of-arrays layout
+     *
+     * Used as an AudioProcessor, it treats an interleaved Lanes-channel buffer as a lane block
+     * directly (no transposition), which lets a StreamHost stream carry Lanes multiplexed inputs.
+     * ProcessStreams() accepts separate mono buffers and transposes them at the edges.
+     * Prepare() and SetSampleRate() are forwarded to every step. Instantiated for 4, 8 and 16 lanes.
+     */
+    template<size_t Lanes> class LaneChain : public AudioProcessor
+    {
+    public:
+        static constexpr size_t LANES = Lanes; ///< Number of lanes
+
+        /**
+         * @brief Constructs a lane chain
+         * @param maxFrames Largest block ProcessStreams() accepts (until Prepare() resizes it)
+         */
+        explicit LaneChain(size_t maxFrames = 1024);
+
+        /**
+         * @brief Appends a processing step
+         * @param processor Step to take ownership of (ignored if null)
+         */
+        void Add(std::unique_ptr<LaneProcessor<Lanes>> processor);
+
+        /**
+         * @brief Sizes the transposition block for spec.maxBlockFrames and prepares every step
+         * (not real-time safe)
+         * @param spec Stream format
+         * @return true if every step accepted the format
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Switches every step to a new sample rate (control thread)
+         * @param sampleRate New sample rate in Hz
+         */
+        void SetSampleRate(double sampleRate) override;
+
+        /**
+         * @brief Processes an interleaved Lanes-channel buffer in place
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Must equal Lanes, otherwise the buffer is left untouched
+         */
+        void Process(std::span<float> buffer, uint32_t channels) override;
+
+        /**
+         * @brief Processes separate mono streams, one per lane
+         * @param inputs Input buffer per lane (at most Lanes, missing lanes read as silence)
+         * @param outputs Output buffer per lane (may alias inputs)
+         * @param frames Frames to process (clamped to maxFrames)
+         */
+        void ProcessStreams(std::span<const std::span<const float>> inputs,
+            std::span<const std::span<float>> outputs,
+            size_t frames);
+
+        /**
+         * @brief Clears per-lane state
+         */
+        void Reset() override;
+
+    private:
+        std::vector<std::unique_ptr<LaneProcessor<Lanes>>> processors; ///< Steps in execution order
+        TaggedVector<float> soa;                                       ///< Transposition scratch block
+    };
+
+    extern template class LaneGain<4>;
+    extern template class LaneGain<8>;
+    extern template class LaneGain<16>;
+    extern template class LaneNoiseGate<4>;
+    extern template class LaneNoiseGate<8>;
+    extern template class LaneNoiseGate<16>;
+    extern template class LaneLowpass<4>;
+    extern template class LaneLowpass<8>;
+    extern template class LaneLowpass<16>;
+    extern template class LaneChain<4>;
+    extern template class LaneChain<8>;
+    extern template class LaneChain<16>;
+
+} // namespace GuitarIO
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Per-lane state of the noise gate kernel
+     */
+    template<size_t Lanes> struct LaneGateState
+    {
+        std::array<float, Lanes> envelope{}; ///< Peak envelope per lane
+        std::array<float, Lanes> gain{};     ///< Smoothed gate gain per lane
+    };
+
+    /**
+     * @brief Per-lane state of the one-pole filter kernel
+     */
+    template<size_t Lanes> struct LaneFilterState
+    {
+        std::array<float, Lanes> z{}; ///< Filter memory per lane
+    };
+
+    /**
+     * @brief Structure-of-arrays kernels running one DSP step for several independent streams
+     *
+     * A lane block holds Lanes mono streams frame-major: sample i of lane l lives at
+     * soa[i * Lanes + l], so every inner loop is a contiguous Lanes-wide vector operation.
+     * This is the same layout as an interleaved Lanes-channel buffer.
+     * Instantiated for 4, 8 and 16 lanes.
+     */
+    class LaneKernels
+    {
+    public:
+        /**
+         * @brief Transposes separate mono streams into a lane block
+         * @param inputs One buffer per lane (missing lanes and short buffers read as silence)
+         * @param soa Lane block (frames * Lanes)
+         */
+        template<size_t Lanes> static void Pack(std::span<const std::span<const float>> inputs, std::span<float> soa);
+
+        /**
+         * @brief Transposes a lane block back into separate mono streams
+         * @param soa Lane block (frames * Lanes)
+         * @param outputs One buffer per lane (missing lanes are skipped)
+         */
+        template<size_t Lanes>
+        static void Unpack(std::span<const float> soa, std::span<const std::span<float>> outputs);
+
+        /**
+         * @brief Multiplies every lane by its own gain
+         * @param soa Lane block to scale in place
+         * @param gains Gain per lane
+         */
+        template<size_t Lanes> static void Gain(std::span<float> soa, const std::array<float, Lanes> &gains);
+
+        /**
+         * @brief Mixes one lane block into another with a gain per lane
+         * @param input Input lane block
+         * @param output Output lane block (accumulates result)
+         * @param gains Gain per lane
+         */
+        template<size_t Lanes>
+        static void Mix(std::span<const float> input, std::span<float> output, const std::array<float, Lanes> &gains);
+
+        /**
+         * @brief Peak-envelope noise gate with smoothed gain
+         * @param soa Lane block to gate in place
+         * @param state Envelope and gain memory
+         * @param thresholds Open threshold per lane (linear amplitude)
+         * @param release Envelope decay coefficient per sample (0..1)
+         * @param smoothing Gain smoothing coefficient per sample (0..1)
+         */
+        template<size_t Lanes>
+        static void NoiseGate(std::span<float> soa,
+            LaneGateState<Lanes> &state,
+            const std::array<float, Lanes> &thresholds,
+            float release,
+            float smoothing);
+
+        /**
+         * @brief One-pole low-pass filter with a coefficient per lane
+         * @param soa Lane block to filter in place
+         * @param state Filter memory
+         * @param coefficients Smoothing coefficient per lane (0..1, 1 = bypass)
+         */
+        template<size_t Lanes>
+        static void OnePoleLowpass(std::span<float> soa,
+            LaneFilterState<Lanes> &state,
+            const std::array<float, Lanes> &coefficients);
+    };
+} // namespace GuitarIO
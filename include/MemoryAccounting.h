@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Category a library allocation is accounted under
+     */
+    enum class MemoryTag : uint8_t
+    {
+        Buffers, ///< Scratch, delay and I/O sample buffers
+        Rings,   ///< Lock-free ring buffers between threads
+        Tables,  ///< Coefficient, wavetable and impulse response tables
+        Voices,  ///< Voice pools of generators
+        Fft,     ///< FFT plans and spectra
+        Other,   ///< Everything else
+        Count    ///< Number of tags
+    };
+
+    /**
+     * @brief Memory held under one tag
+     */
+    struct MemoryUsage
+    {
+        MemoryTag tag = MemoryTag::Other; ///< Tag
+        const char *name = "";            ///< Tag name
+        size_t currentBytes = 0;          ///< Bytes held now
+        size_t peakBytes = 0;             ///< Highest currentBytes since start or ResetPeaks()
+        uint64_t allocations = 0;         ///< Allocations made under the tag
+    };
+
+    /**
+     * @brief Process-wide per-tag memory counters fed by TaggedAllocator and MemoryReservation
+     *
+     * Counting is a few relaxed atomic operations per allocation, so it is always on. It covers
+     * library containers, rings and voice pools; compile-time tables in LookupTables.h live in
+     * read-only data and are not counted.
+     */
+    class MemoryAccounting
+    {
+    public:
+        /**
+         * @brief Accounts an allocation
+         * @param tag Tag to charge
+         * @param bytes Size of the allocation
+         */
+        static void Add(MemoryTag tag, size_t bytes);
+
+        /**
+         * @brief Accounts a deallocation
+         * @param tag Tag the allocation was charged to
+         * @param bytes Size of the allocation
+         */
+        static void Remove(MemoryTag tag, size_t bytes);
+
+        /**
+         * @brief Gets the usage of one tag
+         * @param tag Tag to query
+         */
+        [[nodiscard]] static MemoryUsage GetUsage(MemoryTag tag);
+
+        /**
+         * @brief Gets the usage of every tag
+         */
+        [[nodiscard]] static std::vector<MemoryUsage> GetReport();
+
+        /**
+         * @brief Formats the report as an aligned text table with a total line
+         */
+        [[nodiscard]] static std::string FormatReport();
+
+        /**
+         * @brief Gets the bytes currently held across all tags
+         */
+        [[nodiscard]] static size_t GetTotalBytes();
+
+        /**
+         * @brief Restarts peak tracking from the current usage
+         */
+        static void ResetPeaks();
+
+        /**
+         * @brief Gets the display name of a tag
+         * @param tag Tag
+         */
+        [[nodiscard]] static const char *GetTagName(MemoryTag tag);
+
+    private:
+        /**
+         * @brief Counters of one tag
+         */
+        struct Counters
+        {
+            std::atomic<size_t> current = 0;       ///< Bytes held
+            std::atomic<size_t> peak = 0;          ///< Highest current
+            std::atomic<uint64_t> allocations = 0; ///< Allocation count
+        };
+
+        static std::array<Counters, static_cast<size_t>(MemoryTag::Count)> counters; ///< Per-tag counters
+    };
+
+    /**
+     * @brief Standard allocator that charges its allocations to a MemoryTag
+     * @tparam T Element type
+     * @tparam Tag Tag to charge
+     */
+    template<typename T, MemoryTag Tag> class TaggedAllocator
+    {
+    public:
+        using value_type = T; ///< Element type
+
+        /**
+         * @brief Same allocator for another element type
+         */
+        template<typename U> struct rebind
+        {
+            using other = TaggedAllocator<U, Tag>; ///< Rebound allocator
+        };
+
+        TaggedAllocator() = default;
+
+        /**
+         * @brief Converting constructor (allocators are stateless)
+         */
+        template<typename U> TaggedAllocator([[maybe_unused]] const TaggedAllocator<U, Tag> &other) noexcept
+        {
+        }
+
+        /**
+         * @brief Allocates and accounts storage for n elements
+         * @param n Element count
+         */
+        [[nodiscard]] T *allocate(size_t n)
+        {
+            T *pointer = std::allocator<T>{}.allocate(n);
+            MemoryAccounting::Add(Tag, n * sizeof(T));
+            return pointer;
+        }
+
+        /**
+         * @brief Frees and un-accounts storage for n elements
+         * @param pointer Storage from allocate()
+         * @param n Element count passed to allocate()
+         */
+        void deallocate(T *pointer, size_t n) noexcept
+        {
+            MemoryAccounting::Remove(Tag, n * sizeof(T));
+            std::allocator<T>{}.deallocate(pointer, n);
+        }
+
+        /**
+         * @brief Allocators of the same tag are interchangeable
+         */
+        template<typename U> bool operator==([[maybe_unused]] const TaggedAllocator<U, Tag> &other) const noexcept
+        {
+            return true;
+        }
+    };
+
+    /**
+     * @brief std::vector whose storage is accounted under a tag
+     */
+    template<typename T, MemoryTag Tag = MemoryTag::Buffers>
+    using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+
+    /**
+     * @brief Charges a fixed footprint (e.g. an inline voice pool) to a tag for the owner's lifetime
+     */
+    class MemoryReservation
+    {
+    public:
+        /**
+         * @brief Accounts the footprint
+         * @param tag Tag to charge
+         * @param bytes Footprint size
+         */
+        MemoryReservation(MemoryTag tag, size_t bytes) : tag(tag), bytes(bytes)
+        {
+            MemoryAccounting::Add(tag, bytes);
+        }
+
+        /**
+         * @brief Releases the footprint
+         */
+        ~MemoryReservation()
+        {
+            MemoryAccounting::Remove(tag, bytes);
+        }
+
+        MemoryReservation(const MemoryReservation &) = delete;
+
+        MemoryReservation &operator=(const MemoryReservation &) = delete;
+
+    private:
+        MemoryTag tag; ///< Charged tag
+        size_t bytes;  ///< Charged size
+    };
+
+} // namespace GuitarIO
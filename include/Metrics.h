@@ -0,0 +1,262 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Kind of metric
+     */
+    enum class MetricType
+    {
+        Counter,  ///< Monotonically increasing count
+        Gauge,    ///< Value that goes up and down
+        Histogram ///< Distribution over fixed buckets
+    };
+
+    /**
+     * @brief Monotonic counter (lock-free, safe from any thread)
+     */
+    class MetricCounter
+    {
+    public:
+        /**
+         * @brief Adds to the counter
+         * @param amount Increment
+         */
+        void Increment(uint64_t amount = 1);
+
+        /**
+         * @brief Gets the current count
+         */
+        [[nodiscard]] uint64_t Get() const;
+
+    private:
+        std::atomic<uint64_t> value = 0; ///< Current count
+    };
+
+    /**
+     * @brief Gauge holding the last value set (lock-free, safe from any thread)
+     */
+    class MetricGauge
+    {
+    public:
+        /**
+         * @brief Sets the gauge
+         * @param newValue New value
+         */
+        void Set(double newValue);
+
+        /**
+         * @brief Adds to the gauge
+         * @param delta Amount to add (negative to subtract)
+         */
+        void Add(double delta);
+
+        /**
+         * @brief Gets the current value
+         */
+        [[nodiscard]] double Get() const;
+
+    private:
+        std::atomic<double> value = 0.0; ///< Current value
+    };
+
+    /**
+     * @brief Histogram over fixed upper bounds (lock-free, safe from any thread)
+     *
+     * Observe() is a short linear scan over the bounds plus two relaxed atomic updates; keep
+     * the bucket count small (a dozen or so) for real-time use.
+     */
+    class MetricHistogram
+    {
+    public:
+        /**
+         * @brief Constructs a histogram
+         * @param upperBounds Inclusive bucket upper bounds in increasing order (+Inf is implied)
+         */
+        explicit MetricHistogram(std::vector<double> upperBounds);
+
+        /**
+         * @brief Records one observation
+         * @param value Observed value
+         */
+        void Observe(double value);
+
+        /**
+         * @brief Gets the bucket upper bounds (without +Inf)
+         */
+        [[nodiscard]] const std::vector<double> &GetUpperBounds() const;
+
+        /**
+         * @brief Gets the per-bucket observation counts (not cumulative; the last entry is +Inf)
+         */
+        [[nodiscard]] std::vector<uint64_t> GetBucketCounts() const;
+
+        /**
+         * @brief Gets the sum of all observations
+         */
+        [[nodiscard]] double GetSum() const;
+
+    private:
+        std::vector<double> bounds;                       ///< Bucket upper bounds
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets; ///< bounds.size() + 1 counts
+        std::atomic<double> sum = 0.0;                    ///< Sum of observations
+    };
+
+    /**
+     * @brief Value of one metric at snapshot time
+     */
+    struct MetricSample
+    {
+        std::string name;                      ///< Metric name
+        std::string help;                      ///< Description
+        MetricType type = MetricType::Counter; ///< Metric kind
+        double value = 0.0;                    ///< Counter or gauge value
+        std::vector<double> upperBounds;       ///< Histogram bucket bounds (without +Inf)
+        std::vector<uint64_t> bucketCounts;    ///< Cumulative histogram counts (last entry is +Inf)
+        double sum = 0.0;                      ///< Histogram sum of observations
+        uint64_t count = 0;                    ///< Histogram observation count
+    };
+
+    /**
+     * @brief Values of every registered metric
+     */
+    struct MetricsSnapshot
+    {
+        std::vector<MetricSample> metrics; ///< Samples in registration order
+    };
+
+    /**
+     * @brief Owns named counters, gauges and histograms and exports them for monitoring
+     *
+     * Register metrics during setup (registration locks and allocates); the returned pointers
+     * stay valid for the registry's lifetime and can be updated from any thread, including the
+     * audio callback. Snapshot() and ExportPrometheus() read the atomics from a monitoring
+     * thread and never block updaters.
+     *
+     * Values that are cheaper to sample than to push (queue depths, backlog sizes) can be set by
+     * collectors, which run on the snapshotting thread right before each snapshot.
+     */
+    class MetricsRegistry
+    {
+    public:
+        /**
+         * @brief Registers a counter, or returns the existing counter of that name
+         * @param name Metric name ([a-zA-Z_:][a-zA-Z0-9_:]*)
+         * @param help Description
+         * @return Counter, or nullptr if the name is invalid or taken by another type
+         */
+        MetricCounter *AddCounter(const std::string &name, const std::string &help);
+
+        /**
+         * @brief Registers a gauge, or returns the existing gauge of that name
+         * @param name Metric name ([a-zA-Z_:][a-zA-Z0-9_:]*)
+         * @param help Description
+         * @return Gauge, or nullptr if the name is invalid or taken by another type
+         */
+        MetricGauge *AddGauge(const std::string &name, const std::string &help);
+
+        /**
+         * @brief Registers a histogram, or returns the existing histogram of that name
+         * @param name Metric name ([a-zA-Z_:][a-zA-Z0-9_:]*)
+         * @param help Description
+         * @param upperBounds Bucket upper bounds in increasing order (ignored if the name exists)
+         * @return Histogram, or nullptr if the name is invalid, taken by another type or the bounds are unsorted
+         */
+        MetricHistogram *AddHistogram(const std::string &name,
+            const std::string &help,
+            std::vector<double> upperBounds);
+
+        /**
+         * @brief Adds a function that updates metrics before every snapshot (snapshot thread)
+         * @param collector Function sampling values into gauges or counters
+         */
+        void AddCollector(std::function<void()> collector);
+
+        /**
+         * @brief Runs the collectors and captures every metric
+         */
+        [[nodiscard]] MetricsSnapshot Snapshot() const;
+
+        /**
+         * @brief Captures a snapshot and formats it in Prometheus text exposition format
+         */
+        [[nodiscard]] std::string ExportPrometheus() const;
+
+        /**
+         * @brief Formats a snapshot in Prometheus text exposition format (version 0.0.4)
+         * @param snapshot Snapshot to format
+         * @return Exposition text
+         */
+        [[nodiscard]] static std::string FormatPrometheus(const MetricsSnapshot &snapshot);
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief Registered metric and where its storage lives
+         */
+        struct Entry
+        {
+            std::string name;                      ///< Metric name
+            std::string help;                      ///< Description
+            MetricType type = MetricType::Counter; ///< Metric kind
+            size_t index = 0;                      ///< Position in the deque for the type
+        };
+
+        /**
+         * @brief Finds a registered metric or validates a new name (registry mutex held)
+         * @param name Metric name
+         * @param type Expected type
+         * @param existing Set to the entry if the name is registered with this type
+         * @return true if the name is usable, false if invalid or registered with another type
+         */
+        bool Lookup(const std::string &name, MetricType type, const Entry *&existing);
+
+        mutable std::mutex mutex;                      ///< Guards registration and collectors
+        std::vector<Entry> entries;                    ///< Metrics in registration order
+        std::deque<MetricCounter> counters;            ///< Counter storage (deque keeps atomics in place)
+        std::deque<MetricGauge> gauges;                ///< Gauge storage
+        std::deque<MetricHistogram> histograms;        ///< Histogram storage
+        std::vector<std::function<void()>> collectors; ///< Pre-snapshot samplers
+        std::string lastError;                         ///< Last error message
+    };
+
+    /**
+     * @brief Standard audio stream health metrics, updated by RtAudioDevice::SetMetrics()
+     */
+    struct AudioStreamMetrics
+    {
+        MetricCounter *callbacks = nullptr;      ///< <prefix>_callbacks_total
+        MetricCounter *xruns = nullptr;          ///< <prefix>_xruns_total (callbacks reporting over/underflow)
+        MetricHistogram *callbackLoad = nullptr; ///< <prefix>_callback_load (callback time / buffer period)
+        MetricGauge *lastCallbackLoad = nullptr; ///< <prefix>_callback_load_last
+
+        /**
+         * @brief Registers the stream metrics
+         * @param registry Registry owning the metrics
+         * @param prefix Name prefix
+         * @return Metric set (pointers are null if registration failed)
+         */
+        static AudioStreamMetrics Register(MetricsRegistry &registry, const std::string &prefix = "guitar_io");
+
+        /**
+         * @brief Records one callback (audio thread)
+         * @param load Callback duration divided by the buffer period
+         * @param xrun true if the backend reported an overflow or underflow
+         */
+        void RecordCallback(double load, bool xrun) const;
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Metrics.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Minimal HTTP endpoint serving a MetricsRegistry in Prometheus text format
+     *
+     * A background thread accepts one connection at a time and answers GET /metrics (any other
+     * path returns 404). Scrapes run the registry's collectors and read its atomics on this
+     * thread, so polling never touches the audio path. Binds to the loopback interface by
+     * default. Only supported on POSIX platforms.
+     */
+    class MetricsServer
+    {
+    public:
+        /**
+         * @brief Constructs a server
+         * @param registry Registry to export (must outlive the server)
+         */
+        explicit MetricsServer(const MetricsRegistry &registry);
+
+        /**
+         * @brief Destructor (stops the server)
+         */
+        ~MetricsServer();
+
+        MetricsServer(const MetricsServer &) = delete;
+
+        MetricsServer &operator=(const MetricsServer &) = delete;
+
+        /**
+         * @brief Binds the listening socket and starts the server thread
+         * @param port Local TCP port (0 = pick a free port, see GetPort())
+         * @param address Local IPv4 address to bind
+         * @return true on success, false on failure
+         */
+        bool Start(uint16_t port, const std::string &address = "127.0.0.1");
+
+        /**
+         * @brief Stops the server thread and closes the socket
+         */
+        void Stop();
+
+        /**
+         * @brief Checks whether the server is running
+         */
+        [[nodiscard]] bool IsRunning() const;
+
+        /**
+         * @brief Gets the bound port (useful after Start(0))
+         */
+        [[nodiscard]] uint16_t GetPort() const;
+
+        /**
+         * @brief Gets the number of scrapes answered
+         */
+        [[nodiscard]] uint64_t GetRequestCount() const;
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief Server thread entry point
+         */
+        void ServeLoop();
+
+        /**
+         * @brief Reads one request and writes the response
+         * @param clientFd Connected socket
+         */
+        void HandleClient(int clientFd);
+
+        const MetricsRegistry &registry;    ///< Exported metrics
+        int socketFd = -1;                  ///< Listening socket
+        uint16_t port = 0;                  ///< Bound port
+        std::thread thread;                 ///< Server thread
+        std::atomic<bool> running = false;  ///< Server thread keep-alive flag
+        std::atomic<uint64_t> requests = 0; ///< Scrapes answered
+        std::string lastError;              ///< Last error message
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "AudioProcessor.h"
+#include "CacheLine.h"
+#include "DelayLine.h"
+#include "MemoryAccounting.h"
+#include "Modulation.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Modulated delay configuration
+     */
+    struct ModulatedDelaySettings
+    {
+        float delayMs = 12.0f;                                           ///< Centre delay
+        float depthMs = 3.0f;                                            ///< LFO sweep either side of delayMs
+        float rateHz = 0.6f;                                             ///< LFO rate
+        float feedback = 0.0f;                                           ///< Wet signal fed back into the line
+        float mix = 0.5f;                                                ///< Wet share of the output
+        float maxDelayMs = 40.0f;                                        ///< Longest reachable delay (sizes the lines)
+        uint32_t voices = 1;                                             ///< Taps per channel, phases spread evenly
+        float stereoPhase = 0.25f;                                       ///< LFO phase step between channels (cycles)
+        Lfo::Shape shape = Lfo::Shape::Sine;                             ///< LFO waveform
+        DelayInterpolation interpolation = DelayInterpolation::Lagrange; ///< Fractional delay interpolation
+    };
+
+    /**
+     * @brief Delay line swept by control-rate LFOs: the engine behind Chorus, Flanger and Vibrato
+     *
+     * Each channel owns a DelayLine read by one or more taps. Every CONTROL_INTERVAL frames each
+     * tap's Lfo is ticked once and the delay ramps linearly to the new value over the period, so
+     * the per-sample work is the ramp and the interpolated read. Periods carry over between
+     * Process() calls, so the sweep rate does not depend on the host block size. Without feedback
+     * a period (or the part of it in the current block) is written and then read in one go; with
+     * feedback it is split into runs shorter than the smallest delay so every read only sees
+     * samples that have already been written.
+     *
+     * Parameters are atomics, safe to set from any thread; the audio thread reads them once per
+     * control period.
+     */
+    class ModulatedDelay : public AudioProcessor
+    {
+    public:
+        static constexpr uint32_t CONTROL_INTERVAL = 32; ///< Frames per LFO tick
+
+        /**
+         * @brief Constructs the effect
+         * @param settings Initial configuration
+         */
+        explicit ModulatedDelay(const ModulatedDelaySettings &settings = {});
+
+        /**
+         * @brief Allocates delay lines and taps for a stream format (not real-time safe)
+         * @param spec Stream format
+         * @return true on success, false on an invalid format
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Switches the sample rate (control thread); taps pick it up at the next block
+         * @param sampleRate New sample rate in Hz (clamped to the prepared maximum)
+         */
+        void SetSampleRate(double sampleRate) override;
+
+        /**
+         * @brief Processes an interleaved block in place
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Number of interleaved channels (must match Prepare())
+         */
+        void Process(std::span<float> buffer, uint32_t channels) override;
+
+        /**
+         * @brief Clears the delay lines and restarts the LFOs at their initial phases
+         */
+        void Reset() override;
+
+        /**
+         * @brief Gets the decay length: the longest delay, repeated until feedback falls below -60 dB
+         */
+        [[nodiscard]] uint32_t GetTailFrames() const override;
+
+        /**
+         * @brief Sets the LFO rate (safe from any thread)
+         * @param rateHz Rate in Hz
+         */
+        void SetRate(float rateHz);
+
+        /**
+         * @brief Sets the centre delay (safe from any thread)
+         * @param delayMs Delay in milliseconds (clamped to maxDelayMs)
+         */
+        void SetDelay(float delayMs);
+
+        /**
+         * @brief Sets the sweep depth (safe from any thread)
+         * @param depthMs Excursion either side of the centre delay in milliseconds
+         */
+        void SetDepth(float depthMs);
+
+        /**
+         * @brief Sets the feedback gain (safe from any thread)
+         * @param feedback Gain in [-0.95, 0.95]
+         */
+        void SetFeedback(float feedback);
+
+        /**
+         * @brief Sets the wet share of the output (safe from any thread)
+         * @param mix 0 = dry only, 1 = wet only
+         */
+        void SetMix(float mix);
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief One modulated read of a channel's line
+         */
+        struct Tap
+        {
+            Lfo lfo;                   ///< Control-rate sweep
+            double startPhase = 0.0;   ///< LFO phase after Reset()
+            float start = 0.0f;        ///< Delay in frames at the start of the current period
+            float target = -1.0f;      ///< Delay in frames at the end of the current period (< 0 = not started)
+            float allpassState = 0.0f; ///< Allpass interpolator memory
+        };
+
+        /**
+         * @brief Re-times the LFOs if SetSampleRate() published a new rate (audio thread)
+         */
+        void ApplySampleRate();
+
+        /**
+         * @brief Fills one delay ramp per tap for a chunk of the current period (audio thread)
+         *
+         * A chunk starting a period ticks the channel's LFOs; later chunks continue the same ramp.
+         *
+         * @param channel Channel index
+         * @param frames Frames in the chunk (at most CONTROL_INTERVAL - periodPosition)
+         * @return Smallest delay of the chunk in frames
+         */
+        float ComputeDelays(uint32_t channel, uint32_t frames);
+
+        /**
+         * @brief Writes and reads a channel's line for one chunk (audio thread)
+         * @param channel Channel index
+         * @param frames Frames in the chunk
+         * @param feedback Feedback gain
+         * @param minDelay Smallest delay of the chunk in frames
+         */
+        void RenderChannel(uint32_t channel, uint32_t frames, float feedback, float minDelay);
+
+        alignas(CACHE_LINE_SIZE) std::atomic<float> rateHz; ///< LFO rate
+        std::atomic<float> delayMs;                         ///< Centre delay
+        std::atomic<float> depthMs;                         ///< Sweep depth
+        std::atomic<float> feedback;                        ///< Feedback gain
+        std::atomic<float> mix;                             ///< Wet share
+        std::atomic<double> sampleRate = 0.0;               ///< Rate published by SetSampleRate()
+
+        alignas(CACHE_LINE_SIZE) ModulatedDelaySettings settings; ///< Construction-time configuration
+        double appliedSampleRate = 0.0;                           ///< Rate the LFOs are timed for
+        double maxSampleRate = 0.0;                               ///< Prepared maximum rate
+        uint32_t channels = 0;                                    ///< Prepared channel count
+        uint32_t voices = 1;                                      ///< Taps per channel
+        uint32_t periodPosition = 0;                              ///< Frames of the current period already rendered
+        std::vector<DelayLine> lines;                             ///< One line per channel
+        std::deque<Tap> taps;                                     ///< [channel][voice] (deque: Lfo holds atomics)
+        TaggedVector<float> delays;                               ///< Per-tap delay ramps [voice][frame]
+        TaggedVector<float> dry;                                  ///< Deinterleaved input of one chunk
+        TaggedVector<float> wet;                                  ///< Summed taps of one chunk
+        TaggedVector<float> tapOutput;                            ///< One tap's read
+        TaggedVector<float> shifted;                              ///< Delays rebased for read-before-write
+        std::string lastError;                                    ///< Last error message
+    };
+
+    /**
+     * @brief Chorus: several slowly swept taps around 12 ms mixed with the dry signal
+     */
+    class Chorus : public ModulatedDelay
+    {
+    public:
+        /**
+         * @brief Gets the chorus defaults (three voices, 0.6 Hz, 12 +/- 3 ms)
+         */
+        [[nodiscard]] static ModulatedDelaySettings DefaultSettings();
+
+        /**
+         * @brief Constructs a chorus
+         * @param settings Initial configuration
+         */
+        explicit Chorus(const ModulatedDelaySettings &settings = DefaultSettings());
+    };
+
+    /**
+     * @brief Flanger: one short swept tap with feedback, producing moving comb-filter notches
+     */
+    class Flanger : public ModulatedDelay
+    {
+    public:
+        /**
+         * @brief Gets the flanger defaults (triangle LFO at 0.2 Hz, 2.5 +/- 2 ms, feedback 0.6)
+         */
+        [[nodiscard]] static ModulatedDelaySettings DefaultSettings();
+
+        /**
+         * @brief Constructs a flanger
+         * @param settings Initial configuration
+         */
+        explicit Flanger(const ModulatedDelaySettings &settings = DefaultSettings());
+    };
+
+    /**
+     * @brief Vibrato: a fully wet swept tap, so only the pitch modulation is heard
+     */
+    class Vibrato : public ModulatedDelay
+    {
+    public:
+        /**
+         * @brief Gets the vibrato defaults (5 Hz, 4 +/- 3 ms, wet only)
+         */
+        [[nodiscard]] static ModulatedDelaySettings DefaultSettings();
+
+        /**
+         * @brief Constructs a vibrato
+         * @param settings Initial configuration
+         */
+        explicit Vibrato(const ModulatedDelaySettings &settings = DefaultSettings());
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "CacheLine.h"
+#include "SmoothedParameter.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Control-rate modulation source
+     *
+     * Sources produce one value per control period; ModulationMatrix advances them.
+     */
+    class ModulationSource
+    {
+    public:
+        virtual ~ModulationSource() = default;
+
+        /**
+         * @brief Configures timing
+         * @param sampleRate Audio sample rate in Hz
+         * @param controlInterval Samples per control period
+         */
+        virtual void Prepare(double sampleRate, uint32_t controlInterval) = 0;
+
+        /**
+         * @brief Advances one control period
+         * @return Source value for the period
+         */
+        virtual float Tick() = 0;
+
+        /**
+         * @brief Resets the source to its initial state
+         */
+        virtual void Reset()
+        {
+        }
+    };
+
+    /**
+     * @brief Low-frequency oscillator evaluated at control rate, output range [-1, 1]
+     */
+    class Lfo : public ModulationSource
+    {
+    public:
+        /**
+         * @brief Waveform shapes
+         */
+        enum class Shape
+        {
+            Sine,
+            Triangle,
+            Square,
+            Saw
+        };
+
+        /**
+         * @brief Constructs an LFO
+         * @param rateHz Oscillation rate in Hz
+         * @param shape Waveform shape
+         */
+        explicit Lfo(float rateHz = 1.0f, Shape shape = Shape::Sine);
+
+        /**
+         * @brief Configures timing
+         * @param sampleRate Audio sample rate in Hz
+         * @param controlInterval Samples per control period
+         */
+        void Prepare(double sampleRate, uint32_t controlInterval) override;
+
+        /**
+         * @brief Advances one control period
+         * @return LFO value in [-1, 1]
+         */
+        float Tick() override;
+
+        /**
+         * @brief Resets the phase to zero
+         */
+        void Reset() override;
+
+        /**
+         * @brief Sets the rate (safe from any thread)
+         * @param rateHz Oscillation rate in Hz
+         */
+        void SetRate(float rateHz);
+
+        /**
+         * @brief Sets the waveform shape (safe from any thread)
+         * @param shape Waveform shape
+         */
+        void SetShape(Shape shape);
+
+        /**
+         * @brief Jumps to a phase (audio thread, or before processing starts)
+         * @param newPhase Phase in cycles (wrapped to [0, 1))
+         */
+        void SetPhase(double newPhase);
+
+        /**
+         * @brief Gets the current phase in [0, 1)
+         */
+        [[nodiscard]] double GetPhase() const;
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<float> rate; ///< Rate in Hz
+        std::atomic<Shape> shape;                         ///< Waveform shape
+
+        alignas(CACHE_LINE_SIZE) double phase = 0.0; ///< Normalized phase [0, 1)
+        double periodSeconds = 0.0;                  ///< Duration of one control period
+    };
+
+    /**
+     * @brief Envelope timing
+     */
+    struct EnvelopeSettings
+    {
+        float attackMs = 5.0f;    ///< Rise time to 1
+        float decayMs = 100.0f;   ///< Fall time to sustain
+        float sustain = 0.7f;     ///< Sustain level [0, 1]
+        float releaseMs = 200.0f; ///< Fall time to 0 after NoteOff()
+    };
+
+    /**
+     * @brief Linear ADSR envelope evaluated at control rate, output range [0, 1]
+     */
+    class Envelope : public ModulationSource
+    {
+    public:
+        /**
+         * @brief Constructs an envelope
+         * @param settings Envelope timing
+         */
+        explicit Envelope(const EnvelopeSettings &settings = {});
+
+        /**
+         * @brief Configures timing
+         * @param sampleRate Audio sample rate in Hz
+         * @param controlInterval Samples per control period
+         */
+        void Prepare(double sampleRate, uint32_t controlInterval) override;
+
+        /**
+         * @brief Advances one control period
+         * @return Envelope level in [0, 1]
+         */
+        float Tick() override;
+
+        /**
+         * @brief Returns the envelope to idle
+         */
+        void Reset() override;
+
+        /**
+         * @brief Opens the gate (safe from any thread)
+         */
+        void NoteOn();
+
+        /**
+         * @brief Closes the gate (safe from any thread)
+         */
+        void NoteOff();
+
+        /**
+         * @brief Checks whether the envelope is producing a non-zero level
+         */
+        [[nodiscard]] bool IsActive() const;
+
+    private:
+        /**
+         * @brief Envelope stages
+         */
+        enum class Stage
+        {
+            Idle,
+            Attack,
+            Decay,
+            Sustain,
+            Release
+        };
+
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> gate = false; ///< Gate state written by NoteOn()/NoteOff()
+        std::atomic<uint32_t> noteOns = 0;                       ///< NoteOn() count, a change retriggers the attack
+
+        alignas(CACHE_LINE_SIZE) EnvelopeSettings settings; ///< Envelope timing
+        uint32_t seenNoteOns = 0;                           ///< NoteOn() count handled by Tick()
+        Stage stage = Stage::Idle;                          ///< Current stage
+        float level = 0.0f;                                 ///< Current output level
+        float attackStep = 1.0f;                            ///< Level increment per period during attack
+        float decayStep = 1.0f;                             ///< Level decrement per period during decay
+        float releaseStep = 1.0f;                           ///< Level decrement per period during release
+    };
+
+    /**
+     * @brief Routes modulation sources to smoothed parameters at control rate
+     *
+     * Routes are added during setup. Tick() advances every source once per control period and
+     * updates only the destinations whose inputs changed, so idle routes cost a comparison.
+     */
+    class ModulationMatrix
+    {
+    public:
+        /**
+         * @brief Adds a route (setup only, not real-time safe)
+         * @param source Modulation source (must outlive the matrix)
+         * @param destination Modulated parameter (must outlive the matrix)
+         * @param depth Offset added to the destination per unit of source value
+         * @return Route index, used with SetDepth()
+         */
+        size_t AddRoute(ModulationSource &source, SmoothedParameter &destination, float depth);
+
+        /**
+         * @brief Changes a route depth (safe from any thread)
+         * @param route Route index returned by AddRoute()
+         * @param depth New depth
+         */
+        void SetDepth(size_t route, float depth);
+
+        /**
+         * @brief Prepares every source
+         * @param sampleRate Audio sample rate in Hz
+         * @param controlInterval Samples per control period
+         */
+        void Prepare(double sampleRate, uint32_t controlInterval);
+
+        /**
+         * @brief Advances every source and updates changed destinations (audio thread)
+         */
+        void Tick();
+
+        /**
+         * @brief Removes every route
+         */
+        void Clear();
+
+        /**
+         * @brief Gets the number of routes
+         */
+        [[nodiscard]] size_t GetRouteCount() const;
+
+    private:
+        /**
+         * @brief One source-to-destination connection
+         */
+        struct Route
+        {
+            size_t source = 0;               ///< Index into sources
+            size_t destination = 0;          ///< Index into destinations
+            std::atomic<float> depth = 0.0f; ///< Modulation depth
+            float appliedDepth = 0.0f;       ///< Depth used at the last update
+        };
+
+        /**
+         * @brief Source slot with the value from the last Tick()
+         */
+        struct SourceSlot
+        {
+            ModulationSource *source = nullptr; ///< Modulation source
+            float value = 0.0f;                 ///< Last produced value
+            bool changed = true;                ///< Value changed at the last Tick()
+        };
+
+        /**
+         * @brief Destination slot with the summed offset
+         */
+        struct DestinationSlot
+        {
+            SmoothedParameter *parameter = nullptr; ///< Modulated parameter
+            bool dirty = true;                      ///< Offset must be recomputed
+        };
+
+        std::vector<SourceSlot> sources;           ///< Distinct sources
+        std::vector<DestinationSlot> destinations; ///< Distinct destinations
+        std::deque<Route> routes;                  ///< Connections (deque keeps atomics in place)
+    };
+
+} // namespace GuitarIO
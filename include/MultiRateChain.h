@@ -0,0 +1,161 @@
+#pragma once
+
+#include "AudioProcessor.h"
+#include "MemoryAccounting.h"
+#include "ProcessorChain.h"
+#include "RateConverter.h"
+#include <string>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Rate domain configuration
+     */
+    struct RateDomainConfig
+    {
+        uint32_t divisor = 1;     ///< Domain rate = device rate / divisor
+        bool feedsOutput = true;  ///< Result replaces the stream (false = analysis-only side path)
+        uint32_t blockFrames = 0; ///< Analysis block at the domain rate (0 = device block / divisor)
+    };
+
+    /**
+     * @brief Runs processor chains at integer fractions of the device rate within one stream
+     *
+     * Domains run in the order they were added. At each boundary the chain inserts a decimator
+     * (and, for domains feeding the output, an interpolator back to the device rate):
+     * - Output domains process the decimated callback block every callback, at 1/divisor the cost.
+     *   Their output is queued behind divisor - 1 held-back frames, so a callback may end part way
+     *   through a group of divisor frames; this adds divisor - 1 frames to GetLatencyFrames().
+     * - Analysis domains (feedsOutput = false) see a decimated copy of the stream and accumulate
+     *   blockFrames before running, i.e. every few callbacks. Analysis domains with the same
+     *   cadence are staggered so they run in different callbacks instead of piling up in one.
+     *
+     * Callbacks may deliver any number of frames up to the prepared block size.
+     */
+    class MultiRateChain : public AudioProcessor
+    {
+    public:
+        /**
+         * @brief Adds a domain (setup only, before Prepare())
+         * @param config Domain configuration
+         * @param chain Processors to run at the domain rate
+         * @return Domain index
+         */
+        size_t AddDomain(const RateDomainConfig &config, ProcessorChain chain);
+
+        /**
+         * @brief Allocates converters and buffers for a stream format (not real-time safe)
+         * @param sampleRate Device sample rate in Hz
+         * @param blockSize Largest number of device frames per callback
+         * @param channels Number of interleaved channels
+         * @return true on success, false if a domain does not fit the block size
+         */
+        bool Prepare(double sampleRate, uint32_t blockSize, uint32_t channels);
+
+        /**
+         * @brief Prepares the converters and every domain chain (not real-time safe)
+         *
+         * spec.maxBlockFrames is the largest device block and must be a multiple of every divisor;
+         * each domain chain is prepared with its own rate and block.
+         *
+         * @param spec Stream format
+         * @return true on success, false if a domain does not fit or a processor rejects its format
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Switches every domain chain to the matching fraction of a new device rate (control thread)
+         * @param sampleRate New device sample rate in Hz
+         */
+        void SetSampleRate(double sampleRate) override;
+
+        /**
+         * @brief Processes a device-rate block through every domain
+         * @param buffer Interleaved samples (any number of frames; longer blocks than blockSize are split)
+         * @param channels Number of interleaved channels (must match Prepare())
+         */
+        void Process(std::span<float> buffer, uint32_t channels) override;
+
+        /**
+         * @brief Resets every domain chain and converter
+         */
+        void Reset() override;
+
+        /**
+         * @brief Gets the number of domains
+         */
+        [[nodiscard]] size_t GetDomainCount() const;
+
+        /**
+         * @brief Gets a domain's processor chain
+         * @param index Domain index
+         * @return Chain pointer, or nullptr if out of range
+         */
+        [[nodiscard]] ProcessorChain *GetChain(size_t index);
+
+        /**
+         * @brief Gets the domain sample rate
+         * @param index Domain index
+         * @return Sample rate in Hz, or 0 if out of range
+         */
+        [[nodiscard]] double GetDomainSampleRate(size_t index) const;
+
+        /**
+         * @brief Gets the output delay from rate conversion, held-back frames and output domain chains,
+         * in device-rate frames
+         */
+        [[nodiscard]] uint32_t GetLatencyFrames() const override;
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief One rate domain with its converters and buffers
+         */
+        struct Domain
+        {
+            RateDomainConfig config;    ///< Domain configuration
+            ProcessorChain chain;       ///< Processors at the domain rate
+            Decimator decimator;        ///< Device rate to domain rate
+            Interpolator interpolator;  ///< Domain rate back to device rate (output domains)
+            TaggedVector<float> buffer; ///< Domain-rate block (interleaved)
+            TaggedVector<float> queued; ///< Interpolated device-rate frames not yet returned (output domains)
+            size_t queuedFrames = 0;    ///< Frames waiting in queued
+            size_t filled = 0;          ///< Frames accumulated in buffer (analysis domains)
+            size_t staggerFrames = 0;   ///< Initial fill offset that staggers analysis runs
+        };
+
+        /**
+         * @brief Runs one block of at most blockSize frames through every domain
+         * @param block Interleaved samples
+         */
+        void ProcessBlock(std::span<float> block);
+
+        /**
+         * @brief Runs an output domain with a divisor above 1 on one block
+         * @param domain Output domain
+         * @param block Interleaved samples, replaced by the domain output
+         */
+        void ProcessOutputDomain(Domain &domain, std::span<float> block);
+
+        /**
+         * @brief Feeds one block to an analysis domain, running its chain whenever its buffer fills
+         * @param domain Analysis domain
+         * @param block Interleaved samples (not modified)
+         */
+        void ProcessAnalysisDomain(Domain &domain, std::span<const float> block);
+
+        std::vector<Domain> domains;   ///< Domains in execution order
+        TaggedVector<float> decimated; ///< Decimated block of an analysis domain
+        double sampleRate = 0.0;       ///< Device sample rate
+        double maxSampleRate = 0.0;    ///< Highest device rate the domain chains were prepared for
+        uint32_t blockSize = 0;        ///< Largest device block in frames
+        uint32_t channels = 0;         ///< Interleaved channels
+        std::string lastError;         ///< Last error message
+    };
+
+} // namespace GuitarIO
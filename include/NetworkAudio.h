@@ -0,0 +1,157 @@
+#pragma once
+
+#include "JitterBuffer.h"
+#include "MemoryAccounting.h"
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Wire format of network audio packets
+     *
+     * A packet is a 12-byte header followed by frames * channels float32 samples in the
+     * sender's native byte order (little-endian on every supported platform).
+     * Header fields are big-endian.
+     */
+    struct NetworkAudioPacket
+    {
+        static constexpr uint32_t MAGIC = 0x47494F31; ///< "GIO1"
+        static constexpr size_t HEADER_SIZE = 12;     ///< magic(4) sequence(4) frames(2) channels(2)
+        static constexpr size_t MAX_SIZE = 65507;     ///< Largest UDP payload
+    };
+
+    /**
+     * @brief Receives network audio packets on a UDP socket and feeds a JitterBuffer
+     *
+     * A background thread receives packets and calls JitterBuffer::Insert(), so the
+     * buffer's Read() can be used directly from the audio callback.
+     * Only supported on POSIX platforms.
+     */
+    class NetworkAudioReceiver
+    {
+    public:
+        /**
+         * @brief Constructs a receiver
+         * @param buffer Jitter buffer receiving packets (must outlive the receiver)
+         */
+        explicit NetworkAudioReceiver(JitterBuffer &buffer);
+
+        /**
+         * @brief Destructor (stops and closes the socket)
+         */
+        ~NetworkAudioReceiver();
+
+        NetworkAudioReceiver(const NetworkAudioReceiver &) = delete;
+
+        NetworkAudioReceiver &operator=(const NetworkAudioReceiver &) = delete;
+
+        /**
+         * @brief Binds the UDP socket
+         * @param port Local port (0 = pick a free port, see GetPort())
+         * @param address Local IPv4 address to bind
+         * @return true on success, false on failure
+         */
+        bool Open(uint16_t port, const std::string &address = "127.0.0.1");
+
+        /**
+         * @brief Starts the receive thread
+         * @return true on success, false on failure
+         */
+        bool Start();
+
+        /**
+         * @brief Stops the receive thread
+         */
+        void Stop();
+
+        /**
+         * @brief Stops receiving and closes the socket
+         */
+        void Close();
+
+        /**
+         * @brief Gets the bound local port
+         */
+        [[nodiscard]] uint16_t GetPort() const;
+
+        /**
+         * @brief Gets the number of packets rejected as malformed
+         */
+        [[nodiscard]] uint64_t GetMalformedPackets() const;
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief Receive thread entry point
+         */
+        void ReceiveLoop();
+
+        JitterBuffer &buffer;                       ///< Destination buffer
+        int socketFd = -1;                          ///< UDP socket
+        uint16_t port = 0;                          ///< Bound local port
+        std::atomic<bool> running = false;          ///< Receive thread running flag
+        std::atomic<uint64_t> malformedPackets = 0; ///< Packets with a bad header or size
+        std::thread thread;                         ///< Receive thread
+        std::string lastError;                      ///< Last error message
+    };
+
+    /**
+     * @brief Sends network audio packets over UDP (used by remote players and loopback tests)
+     */
+    class NetworkAudioSender
+    {
+    public:
+        NetworkAudioSender() = default;
+
+        /**
+         * @brief Destructor (closes the socket)
+         */
+        ~NetworkAudioSender();
+
+        NetworkAudioSender(const NetworkAudioSender &) = delete;
+
+        NetworkAudioSender &operator=(const NetworkAudioSender &) = delete;
+
+        /**
+         * @brief Creates the socket and sets the destination
+         * @param address Destination IPv4 address
+         * @param port Destination port
+         * @return true on success, false on failure
+         */
+        bool Open(const std::string &address, uint16_t port);
+
+        /**
+         * @brief Sends one packet
+         * @param sequence Packet sequence number
+         * @param samples Interleaved samples (whole frames)
+         * @param channels Number of interleaved channels
+         * @return true on success, false on failure
+         */
+        bool Send(uint32_t sequence, std::span<const float> samples, uint32_t channels);
+
+        /**
+         * @brief Closes the socket
+         */
+        void Close();
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        int socketFd = -1;         ///< UDP socket
+        TaggedVector<char> packet; ///< Packet assembly buffer
+        std::string lastError;     ///< Last error message
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "AudioProcessor.h"
+#include "MemoryAccounting.h"
+#include "NeuralModel.h"
+#include "PackedMatrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Allocation-free inference engine for small neural amp captures (LSTM, GRU, ConvNet)
+     *
+     * SetModel() repacks the weights once: recurrent and convolution matrices go into
+     * PackedMatrix row blocks, biases are fused and padded to whole blocks, so inference is a
+     * chain of sequential multiply-add sweeps and elementwise FastMath activations.
+     *
+     * Recurrent models run sample by sample (the recurrence allows nothing else): one packed
+     * product of the hidden state per sample, then the gate nonlinearities. ConvNet models run
+     * layer by layer over the whole block, so each layer's weights stay in cache for every frame;
+     * each layer keeps a frame ring of its input history, so the dilated taps read previous blocks
+     * without copying. Recurrent state and convolution history persist across blocks and are only
+     * cleared by Reset().
+     *
+     * Every channel runs its own state (a stereo stream costs twice a mono one). The network has
+     * no notion of sample rate and sounds right only at the model's training rate; when the
+     * device runs faster, host it in a MultiRateChain domain at that rate.
+     */
+    class NeuralAmp : public AudioProcessor
+    {
+    public:
+        /**
+         * @brief Installs a model (allocates, not real-time safe; call before Prepare() or while stopped)
+         * @param model Loaded or assigned model
+         * @return true on success, false if the model is empty
+         */
+        bool SetModel(const NeuralModel &model);
+
+        /**
+         * @brief Allocates per-channel state and scratch (not real-time safe)
+         * @param spec Stream format
+         * @return true on success, false without a model or on an invalid format
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Runs the model on every channel of an interleaved block in place
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Number of interleaved channels (must match Prepare())
+         */
+        void Process(std::span<float> buffer, uint32_t channels) override;
+
+        /**
+         * @brief Clears recurrent state and convolution history
+         */
+        void Reset() override;
+
+        /**
+         * @brief Gets the tail: the receptive field for ConvNet, TAIL_INFINITE for recurrent models
+         */
+        [[nodiscard]] uint32_t GetTailFrames() const override;
+
+        /**
+         * @brief Gets the installed model shape
+         */
+        [[nodiscard]] const NeuralModelSpec &GetModelSpec() const
+        {
+            return spec;
+        }
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        using Weights = TaggedVector<float, MemoryTag::Tables>;
+
+        /**
+         * @brief Packed weights of one ConvNet layer
+         */
+        struct ConvLayer
+        {
+            uint32_t dilation = 1;          ///< Frames between taps
+            std::vector<PackedMatrix> taps; ///< C x C matrix per tap, oldest first
+            Weights convBias;               ///< Convolution bias (padded)
+            PackedMatrix residual;          ///< C x C residual 1x1 convolution
+            Weights residualBias;           ///< Residual bias (padded)
+        };
+
+        /**
+         * @brief Network state of one channel
+         */
+        struct ChannelState
+        {
+            TaggedVector<float> hidden;               ///< Recurrent hidden state (padded)
+            TaggedVector<float> cell;                 ///< LSTM cell state (padded)
+            std::vector<TaggedVector<float>> history; ///< Per ConvNet layer input ring [frame][stride]
+            size_t position = 0;                      ///< Frames processed, ring write position
+        };
+
+        /**
+         * @brief Builds the packed LSTM/GRU weights from the flat model weights
+         * @param weights Flat weights in NeuralModel order
+         */
+        void PackRecurrent(std::span<const float> weights);
+
+        /**
+         * @brief Builds the packed ConvNet weights from the flat model weights
+         * @param weights Flat weights in NeuralModel order
+         */
+        void PackConvNet(std::span<const float> weights);
+
+        /**
+         * @brief Allocates the state of every channel and the scratch buffers
+         */
+        void AllocateState();
+
+        /**
+         * @brief Runs an LSTM over a mono block in place
+         * @param samples Mono samples
+         * @param state Channel state
+         */
+        void ProcessLstm(std::span<float> samples, ChannelState &state);
+
+        /**
+         * @brief Runs a GRU over a mono block in place
+         * @param samples Mono samples
+         * @param state Channel state
+         */
+        void ProcessGru(std::span<float> samples, ChannelState &state);
+
+        /**
+         * @brief Runs a ConvNet over a mono block (at most maxBlockFrames) in place
+         * @param samples Mono samples
+         * @param state Channel state
+         */
+        void ProcessConvNet(std::span<float> samples, ChannelState &state);
+
+        /**
+         * @brief Gets the ring capacity of a ConvNet layer in frames (power of two)
+         * @param layer Layer index
+         */
+        [[nodiscard]] size_t GetRingFrames(size_t layer) const;
+
+        NeuralModelSpec spec;             ///< Installed model shape
+        bool hasModel = false;            ///< Whether SetModel() succeeded
+        size_t stride = 0;                ///< Hidden size padded to PackedMatrix blocks
+        PackedMatrix hiddenWeights;       ///< Recurrent weight_hh, gates x H
+        Weights inputWeights;             ///< Recurrent weight_ih per gate row, or ConvNet input 1x1 (padded)
+        Weights inputBias;                ///< LSTM fused biases, or GRU bias_ih (padded)
+        Weights hiddenBias;               ///< GRU bias_hh (padded)
+        std::vector<ConvLayer> layers;    ///< ConvNet layers
+        Weights outputWeights;            ///< Dense/head weights (padded)
+        float outputBias = 0.0f;          ///< Dense/head bias
+        uint32_t channels = 0;            ///< Prepared channel count
+        uint32_t maxBlockFrames = 0;      ///< Prepared block size
+        std::vector<ChannelState> states; ///< Per-channel state
+        TaggedVector<float> gates;        ///< Recurrent gate pre-activations (padded)
+        TaggedVector<float> hiddenGates;  ///< GRU hidden-side pre-activations (padded)
+        TaggedVector<float> activation;   ///< ConvNet tanh output of one frame (padded)
+        TaggedVector<float> skip;         ///< ConvNet skip sum [frame][stride]
+        TaggedVector<float> mono;         ///< De-interleaved channel block
+        std::string lastError;            ///< Last error message
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "MemoryAccounting.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Network topology of a neural amp capture
+     */
+    enum class NeuralArchitecture : uint32_t
+    {
+        Lstm = 0,   ///< One LSTM layer and a dense output
+        Gru = 1,    ///< One GRU layer and a dense output
+        ConvNet = 2 ///< WaveNet-style stack of dilated causal convolutions with skip sums
+    };
+
+    /**
+     * @brief Shape of a neural amp model
+     */
+    struct NeuralModelSpec
+    {
+        NeuralArchitecture architecture = NeuralArchitecture::Lstm; ///< Topology
+        uint32_t hiddenSize = 16;                                   ///< Recurrent units, or channels per conv layer
+        uint32_t layers = 1;                                        ///< Conv layers (recurrent models have one)
+        uint32_t kernelSize = 3;                                    ///< Taps per convolution (ConvNet only)
+        bool inputSkip = true;                                      ///< Adds the input to the network output
+        uint32_t sampleRate = 48000;                                ///< Rate the model was trained at (Hz)
+    };
+
+    /**
+     * @brief Binary header of a neural model file
+     *
+     * The header is followed by weightCount float32 weights in native byte order (little-endian
+     * on every supported platform), in the order documented on NeuralModel.
+     */
+    struct NeuralModelHeader
+    {
+        static constexpr uint32_t MAGIC = 0x47494E4D;  ///< "GINM"
+        static constexpr uint32_t VERSION = 1;         ///< Format version
+        static constexpr uint32_t FLAG_INPUT_SKIP = 1; ///< NeuralModelSpec::inputSkip
+
+        uint32_t magic = MAGIC;     ///< Format identifier
+        uint32_t version = VERSION; ///< Format version
+        uint32_t architecture = 0;  ///< NeuralArchitecture value
+        uint32_t hiddenSize = 0;    ///< NeuralModelSpec::hiddenSize
+        uint32_t layers = 0;        ///< NeuralModelSpec::layers
+        uint32_t kernelSize = 0;    ///< NeuralModelSpec::kernelSize
+        uint32_t flags = 0;         ///< FLAG_* bits
+        uint32_t sampleRate = 0;    ///< Training sample rate (Hz)
+        uint32_t weightCount = 0;   ///< Number of float weights that follow
+    };
+
+    /**
+     * @brief Weights and shape of a neural amp capture, loaded from or saved to a weight file
+     *
+     * Weights are one flat array in PyTorch parameter order, so an exporter only has to
+     * concatenate state_dict tensors (H = hiddenSize, C = hiddenSize, K = kernelSize, L = layers):
+     * - Lstm (gates i, f, g, o): weight_ih [4H], weight_hh [4H][H], bias_ih [4H], bias_hh [4H],
+     *   dense weight [H], dense bias [1]
+     * - Gru (gates r, z, n): weight_ih [3H], weight_hh [3H][H], bias_ih [3H], bias_hh [3H],
+     *   dense weight [H], dense bias [1]
+     * - ConvNet: input 1x1 weight [C]; per layer l (dilation 2^l) conv weight [C][C][K] (tap K-1
+     *   is the current sample), conv bias [C], residual 1x1 weight [C][C], residual bias [C];
+     *   head weight [C], head bias [1]. Layer l computes z = tanh(conv(h)), h += residual(z)
+     *   and adds z to the skip sum the head reads.
+     *
+     * Loading validates the shape against MAX_* limits and rejects non-finite weights, so a bad
+     * file fails here rather than in the audio thread.
+     */
+    class NeuralModel
+    {
+    public:
+        static constexpr uint32_t MAX_HIDDEN_SIZE = 128; ///< Largest hiddenSize
+        static constexpr uint32_t MAX_LAYERS = 12;       ///< Largest ConvNet layer count
+        static constexpr uint32_t MAX_KERNEL_SIZE = 8;   ///< Largest ConvNet kernel
+
+        /**
+         * @brief Gets the number of weights a model of the given shape has
+         * @param spec Model shape
+         */
+        [[nodiscard]] static size_t GetWeightCount(const NeuralModelSpec &spec);
+
+        /**
+         * @brief Replaces shape and weights (not real-time safe)
+         * @param spec Model shape
+         * @param weights GetWeightCount(spec) weights in the documented order
+         * @return true on success, false on an invalid shape, count or weight
+         */
+        bool Assign(const NeuralModelSpec &spec, std::span<const float> weights);
+
+        /**
+         * @brief Reads a weight file (not real-time safe)
+         * @param path File path
+         * @return true on success; on failure the previous model is kept
+         */
+        bool Load(const std::string &path);
+
+        /**
+         * @brief Writes the model as a weight file
+         * @param path File path
+         * @return true on success
+         */
+        bool Save(const std::string &path);
+
+        /**
+         * @brief Gets the model shape
+         */
+        [[nodiscard]] const NeuralModelSpec &GetSpec() const
+        {
+            return spec;
+        }
+
+        /**
+         * @brief Gets the flat weights (empty until a model is assigned or loaded)
+         */
+        [[nodiscard]] std::span<const float> GetWeights() const
+        {
+            return weights;
+        }
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief Checks a shape against the supported limits
+         * @param spec Model shape
+         * @return true if supported; otherwise sets lastError
+         */
+        bool Validate(const NeuralModelSpec &spec);
+
+        NeuralModelSpec spec;                           ///< Model shape
+        TaggedVector<float, MemoryTag::Tables> weights; ///< Flat weights
+        std::string lastError;                          ///< Last error message
+    };
+
+} // namespace GuitarIO
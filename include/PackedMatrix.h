@@ -0,0 +1,87 @@
+#pragma once
+
+#include "MemoryAccounting.h"
+#include <cstddef>
+#include <span>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Dense weight matrix packed for vectorized matrix-vector products
+     *
+     * Rows are grouped into blocks of LANES; inside a block the weights are stored column-major,
+     * so column c of a block is LANES contiguous floats. A product then walks the weights strictly
+     * sequentially and each step is one broadcast input times one LANES-wide weight vector added
+     * to LANES accumulators (the same layout idea as LaneKernels). The block kernel is written with
+     * AVX, SSE or NEON intrinsics, picked at compile time from the target flags, and alternates two
+     * accumulator sets between even and odd columns to hide add latency; other targets use a
+     * scalar loop. The last block is zero-padded, so products always produce GetPaddedRows()
+     * outputs and callers size their vectors for that.
+     */
+    class PackedMatrix
+    {
+    public:
+        static constexpr size_t LANES = 8; ///< Rows per block (one AVX register, two SSE/NEON registers)
+
+        /**
+         * @brief Rounds a row count up to whole blocks
+         * @param rows Row count
+         */
+        [[nodiscard]] static constexpr size_t PadRows(size_t rows)
+        {
+            return (rows + LANES - 1) / LANES * LANES;
+        }
+
+        /**
+         * @brief Packs a row-major matrix (allocates, not real-time safe)
+         * @param rowMajor rows * columns weights, row by row
+         * @param rows Row count (outputs)
+         * @param columns Column count (inputs)
+         */
+        void Pack(std::span<const float> rowMajor, size_t rows, size_t columns);
+
+        /**
+         * @brief Computes output = W * input
+         * @param input At least GetColumns() values
+         * @param output At least GetPaddedRows() values (padding rows are written as zero)
+         */
+        void Multiply(std::span<const float> input, std::span<float> output) const;
+
+        /**
+         * @brief Computes output += W * input
+         * @param input At least GetColumns() values
+         * @param output At least GetPaddedRows() values
+         */
+        void MultiplyAdd(std::span<const float> input, std::span<float> output) const;
+
+        /**
+         * @brief Gets the row count passed to Pack()
+         */
+        [[nodiscard]] size_t GetRows() const
+        {
+            return rows;
+        }
+
+        /**
+         * @brief Gets the row count rounded up to whole blocks
+         */
+        [[nodiscard]] size_t GetPaddedRows() const
+        {
+            return PadRows(rows);
+        }
+
+        /**
+         * @brief Gets the column count passed to Pack()
+         */
+        [[nodiscard]] size_t GetColumns() const
+        {
+            return columns;
+        }
+
+    private:
+        size_t rows = 0;                               ///< Logical rows
+        size_t columns = 0;                            ///< Columns
+        TaggedVector<float, MemoryTag::Tables> blocks; ///< [block][column][lane]
+    };
+
+} // namespace GuitarIO
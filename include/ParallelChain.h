@@ -0,0 +1,148 @@
+#pragma once
+
+#include "AudioMixer.h"
+#include "AudioProcessor.h"
+#include "MemoryAccounting.h"
+#include "ProcessorChain.h"
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Runs processor chains in parallel on the same input and mixes them with delay compensation
+     *
+     * Each path processes its own copy of the input block; the results are summed with
+     * AudioMixer::Mix. Paths whose latency (ProcessorChain::GetLatencyFrames()) is shorter than the
+     * longest one are delayed by the difference so the mix stays phase-aligned (no comb
+     * filtering between a dry path and a lookahead, convolution or oversampled path). The
+     * longest path gets no delay line work at all.
+     *
+     * Latencies are polled every block; when one changes the compensation delays are recomputed
+     * and their contents cleared, without allocating. Compensation is capped at the
+     * maxCompensationFrames given to Prepare().
+     */
+    class ParallelChain : public AudioProcessor
+    {
+    public:
+        /**
+         * @brief Adds a path (setup only, before Prepare())
+         * @param chain Processors on this path
+         * @param gain Mix gain of the path
+         * @return Path index
+         */
+        size_t AddPath(ProcessorChain chain, float gain = 1.0f);
+
+        /**
+         * @brief Allocates scratch buffers and compensation delay lines (not real-time safe)
+         * @param maxBlockFrames Largest block passed to Process() (longer blocks are split)
+         * @param channels Number of interleaved channels
+         * @param maxCompensationFrames Longest compensation delay any path may need
+         * @return true on success, false on an invalid format
+         */
+        bool Prepare(uint32_t maxBlockFrames, uint32_t channels, uint32_t maxCompensationFrames);
+
+        /**
+         * @brief Prepares every path, then sizes compensation for the longest path latency (not real-time safe)
+         *
+         * The compensation capacity is the larger of the longest path latency after preparing
+         * (scaled up to spec.GetMaxSampleRate()) and the capacity given to an earlier Prepare().
+         *
+         * @param spec Stream format
+         * @return true on success, false if a path processor rejects the format
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Switches every path to another sample rate (control thread)
+         * @param sampleRate New sample rate in Hz
+         */
+        void SetSampleRate(double sampleRate) override;
+
+        /**
+         * @brief Processes every path on the block and replaces it with the compensated mix
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Number of interleaved channels (must match Prepare())
+         */
+        void Process(std::span<float> buffer, uint32_t channels) override;
+
+        /**
+         * @brief Resets every path and clears the compensation delays
+         */
+        void Reset() override;
+
+        /**
+         * @brief Gets the latency of the longest path (the latency of the mix)
+         */
+        [[nodiscard]] uint32_t GetLatencyFrames() const override;
+
+        /**
+         * @brief Sets a path's mix gain (safe from any thread)
+         * @param index Path index
+         * @param gain Mix gain
+         */
+        void SetPathGain(size_t index, float gain);
+
+        /**
+         * @brief Gets the delay currently inserted on a path
+         * @param index Path index
+         * @return Compensation in frames, or 0 if out of range
+         */
+        [[nodiscard]] uint32_t GetCompensationFrames(size_t index) const;
+
+        /**
+         * @brief Gets the number of paths
+         */
+        [[nodiscard]] size_t GetPathCount() const;
+
+        /**
+         * @brief Gets a path's processor chain
+         * @param index Path index
+         * @return Chain pointer, or nullptr if out of range
+         */
+        [[nodiscard]] ProcessorChain *GetChain(size_t index);
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief One parallel path with its compensation delay line
+         */
+        struct Path
+        {
+            ProcessorChain chain;                   ///< Processors on this path
+            std::atomic<float> gain = 1.0f;         ///< Mix gain
+            TaggedVector<float> delay;              ///< Circular compensation delay (interleaved)
+            size_t delayWrite = 0;                  ///< Next frame written in delay
+            uint32_t latency = 0;                   ///< Chain latency at the last update
+            std::atomic<uint32_t> compensation = 0; ///< Delay applied to this path (frames)
+        };
+
+        /**
+         * @brief Recomputes compensation delays if any path latency changed (audio thread)
+         */
+        void UpdateCompensation();
+
+        /**
+         * @brief Delays a processed block by the path's compensation
+         * @param path Path owning the delay line
+         * @param block Interleaved samples, delayed in place
+         */
+        void ApplyDelay(Path &path, std::span<float> block) const;
+
+        std::deque<Path> paths;      ///< Paths (deque keeps atomics in place)
+        TaggedVector<float> input;   ///< Copy of the input chunk shared by every path
+        TaggedVector<float> scratch; ///< Block processed by the current path
+        uint32_t maxBlockFrames = 0; ///< Frames per processing chunk
+        uint32_t channels = 0;       ///< Interleaved channels
+        uint32_t delayFrames = 0;    ///< Delay line length (maxCompensationFrames + 1)
+        AudioMixer::Kernels kernels; ///< Mixing kernels for the prepared format
+        std::string lastError;       ///< Last error message
+    };
+
+} // namespace GuitarIO
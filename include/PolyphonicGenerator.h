@@ -1,7 +1,12 @@
 #pragma once
 
+#include "AudioBlock.h"
+#include "CacheLine.h"
+#include "MemoryAccounting.h"
 #include "SineWaveGenerator.h"
+#include "SmoothedParameter.h"
 #include <array>
+#include <atomic>
 #include <span>
 
 namespace GuitarIO
@@ -11,11 +16,15 @@ namespace GuitarIO
      *
      * Useful for playing reference chords when tuning in polyphonic mode.
      * Supports up to 6 simultaneous tones (for guitar strings).
+     * Voice levels and the global gain are smoothed at control rate, so enabling, disabling
+     * or re-leveling a voice never produces a click.
      */
     class PolyphonicGenerator
     {
     public:
-        static constexpr size_t MAX_VOICES = 6; ///< Maximum number of simultaneous tones
+        static constexpr size_t MAX_VOICES = 6;          ///< Maximum number of simultaneous tones
+        static constexpr uint32_t CONTROL_INTERVAL = 32; ///< Samples per gain update
+        static constexpr double SMOOTHING_MS = 10.0;     ///< Gain smoothing time constant
 
         /**
          * @brief Constructs a polyphonic generator
@@ -24,7 +33,11 @@ namespace GuitarIO
         explicit PolyphonicGenerator(double sampleRate = 48000.0);
 
         /**
-         * @brief Sets the sample rate for all oscillators
+         * @brief Sets the sample rate for all oscillators and gain smoothers
+         *
+         * Safe while Generate() runs: only increments and smoothing coefficients are recomputed,
+         * nothing is reallocated, and the audio thread picks them up at its next block.
+         *
          * @param sampleRate Sample rate in Hz
          */
         void SetSampleRate(double sampleRate);
@@ -45,7 +58,7 @@ namespace GuitarIO
         /**
          * @brief Sets the amplitude for a specific voice
          * @param voiceIndex Voice index (0-5)
-         * @param amplitude Volume level (0.0 to 1.0)
+         * @param amplitude Volume level (0.0 to 1.0), applied while the voice has a frequency
          */
         void SetVoiceAmplitude(size_t voiceIndex, float amplitude);
 
@@ -55,6 +68,16 @@ namespace GuitarIO
          */
         void SetGlobalVolume(float volume);
 
+        /**
+         * @brief Limits the number of voices rendered (cheap fallback for QualityScheduler)
+         *
+         * Active voices beyond the limit, counted from voice 0, fade out; raising the limit fades
+         * them back in. Real-time safe.
+         *
+         * @param limit Maximum number of rendered voices (MAX_VOICES = no limit)
+         */
+        void SetVoiceLimit(size_t limit);
+
         /**
          * @brief Generates polyphonic samples into the output buffer
          * @param buffer Output buffer to fill
@@ -62,6 +85,17 @@ namespace GuitarIO
          */
         void Generate(std::span<float> buffer, bool accumulate = false);
 
+        /**
+         * @brief Generates polyphonic samples into a block and maintains its silent flag
+         *
+         * With no active voices the block is flagged silent (or left untouched when accumulating),
+         * so downstream processors can skip it.
+         *
+         * @param block Output block to fill
+         * @param accumulate If true, adds to existing block content instead of overwriting
+         */
+        void Generate(AudioBlock &block, bool accumulate = false);
+
         /**
          * @brief Resets all voice phases to 0
          */
@@ -72,13 +106,40 @@ namespace GuitarIO
          */
         [[nodiscard]] size_t GetActiveVoiceCount() const;
 
+        /**
+         * @brief Checks whether every voice has faded out completely
+         */
+        [[nodiscard]] bool IsIdle() const;
+
     private:
-        std::array<SineWaveGenerator, MAX_VOICES> voices; ///< Array of oscillators
-        std::array<double, MAX_VOICES> frequencies;       ///< Array of frequencies
-        float globalVolume = 0.5f;                        ///< Global volume
-        size_t activeVoiceCount = 0;                      ///< Number of active voices
+        // Control-written settings
+        alignas(CACHE_LINE_SIZE) std::array<std::atomic<double>, MAX_VOICES> frequencies; ///< Voice frequencies
+
+        std::array<std::atomic<float>, MAX_VOICES> amplitudes; ///< Requested voice amplitudes
+        std::atomic<float> globalVolume = 0.5f;                ///< Global volume
+        std::atomic<size_t> activeVoiceCount = 0;              ///< Number of active voices
+        std::atomic<size_t> voiceLimit = MAX_VOICES;           ///< Maximum number of rendered voices
+
+        // Audio-written state (each smoother keeps its control-written target on its own line)
+        std::array<SineWaveGenerator, MAX_VOICES> voices;      ///< Oscillators (unit amplitude)
+        std::array<SmoothedParameter, MAX_VOICES> voiceLevels; ///< Smoothed per-voice levels
+        SmoothedParameter outputGain;                          ///< Smoothed global gain with voice compensation
+
+        alignas(CACHE_LINE_SIZE) std::array<float, CONTROL_INTERVAL> scratch{}; ///< Per-voice render buffer
+
+        MemoryReservation voicePool{ MemoryTag::Voices, sizeof(voices) + sizeof(voiceLevels) }; ///< Pool footprint
 
         void UpdateActiveVoiceCount();
+
+        /**
+         * @brief Pushes the requested voice levels to their smoothers
+         */
+        void UpdateVoiceLevels();
+
+        /**
+         * @brief Pushes the compensated global gain to its smoother
+         */
+        void UpdateOutputGain();
     };
 
 } // namespace GuitarIO
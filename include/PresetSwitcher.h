@@ -0,0 +1,210 @@
+#pragma once
+
+#include "AudioMixer.h"
+#include "AudioProcessor.h"
+#include "CacheLine.h"
+#include "MemoryAccounting.h"
+#include "ProcessorChain.h"
+#include "SpscRingBuffer.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Complete tone state published as one unit
+     *
+     * Build it entirely off the audio thread: create the processors, set every parameter, load
+     * impulse responses and wavetables and prepare the chain for the stream format. Once handed to
+     * PresetSwitcher::Load() it is owned by the switcher and must not be touched again.
+     */
+    struct Preset
+    {
+        std::string name;     ///< Display name
+        ProcessorChain chain; ///< Fully configured processors
+    };
+
+    /**
+     * @brief Preset switcher configuration
+     */
+    struct PresetSwitcherConfig
+    {
+        float crossfadeMs = 10.0f;       ///< Crossfade between old and new preset (0 = hard switch)
+        uint32_t reclaimIntervalMs = 20; ///< How often the reclaim thread frees retired presets
+        uint32_t retireCapacity = 16;    ///< Retired presets the audio thread can queue before it defers switches
+    };
+
+    /**
+     * @brief Swaps whole presets into the audio path with one atomic pointer exchange
+     *
+     * Load() publishes a preset through an atomic pointer; the audio thread adopts it at the start
+     * of the next block, so every parameter and resource changes at once and no intermediate state
+     * is ever heard. If several presets are loaded before the audio thread picks one up, only the
+     * latest is adopted and the superseded ones are freed by the loading thread.
+     *
+     * The audio thread never frees memory: presets it retires are queued to a reclaim thread that
+     * deletes them (and their impulse responses, wavetables, ...) in the background. With a
+     * crossfade configured the outgoing preset keeps running for crossfadeMs and is mixed out
+     * while the new one fades in; a preset loaded during a fade is adopted when the fade ends.
+     */
+    class PresetSwitcher : public AudioProcessor
+    {
+    public:
+        /**
+         * @brief Constructs a switcher and starts the reclaim thread
+         * @param config Switcher configuration
+         */
+        explicit PresetSwitcher(const PresetSwitcherConfig &config = {});
+
+        /**
+         * @brief Destructor (stops the reclaim thread and frees every preset)
+         */
+        ~PresetSwitcher() override;
+
+        PresetSwitcher(const PresetSwitcher &) = delete;
+
+        PresetSwitcher &operator=(const PresetSwitcher &) = delete;
+
+        /**
+         * @brief Allocates the crossfade buffer for a stream format (not real-time safe)
+         * @param sampleRate Sample rate in Hz
+         * @param maxBlockFrames Largest block passed to Process()
+         * @param channels Number of interleaved channels
+         * @return true on success, false on an invalid format
+         */
+        bool Prepare(double sampleRate, uint32_t maxBlockFrames, uint32_t channels);
+
+        /**
+         * @brief Allocates the crossfade buffer for spec.maxBlockFrames (not real-time safe)
+         *
+         * Presets are prepared by whoever builds them; pass them the same spec.
+         *
+         * @param spec Stream format
+         * @return true on success, false on an invalid format
+         */
+        bool Prepare(const ProcessSpec &spec) override;
+
+        /**
+         * @brief Recomputes the crossfade length for a new sample rate (control thread)
+         *
+         * Takes effect at the next switch. Presets are switched to the new rate by whoever owns
+         * them, before they are loaded.
+         *
+         * @param sampleRate New sample rate in Hz
+         */
+        void SetSampleRate(double sampleRate) override;
+
+        /**
+         * @brief Publishes a preset for the audio thread to adopt (any non-audio thread)
+         * @param preset Fully built preset (ignored if null)
+         * @return Generation number the preset will report through GetActiveGeneration(), or 0 if null
+         */
+        uint64_t Load(std::unique_ptr<Preset> preset);
+
+        /**
+         * @brief Adopts a pending preset, then processes the block through the active one
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Number of interleaved channels (must match Prepare())
+         */
+        void Process(std::span<float> buffer, uint32_t channels) override;
+
+        /**
+         * @brief Resets the active preset's chain and finishes any crossfade (audio thread)
+         *
+         * If the retire queue is full the crossfade keeps running instead, so the outgoing preset
+         * is never dropped without being freed.
+         */
+        void Reset() override;
+
+        /**
+         * @brief Gets the latency of the active preset's chain (audio thread)
+         */
+        [[nodiscard]] uint32_t GetLatencyFrames() const override;
+
+        /**
+         * @brief Gets the generation of the preset the audio thread is running (0 = none)
+         */
+        [[nodiscard]] uint64_t GetActiveGeneration() const;
+
+        /**
+         * @brief Checks whether a crossfade is in progress
+         */
+        [[nodiscard]] bool IsCrossfading() const;
+
+        /**
+         * @brief Gets the number of presets freed by the reclaim thread
+         */
+        [[nodiscard]] uint64_t GetReclaimedCount() const;
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        /**
+         * @brief Preset tagged with its generation
+         */
+        struct Slot
+        {
+            std::unique_ptr<Preset> preset; ///< Owned preset
+            uint64_t generation = 0;        ///< Load() sequence number
+        };
+
+        /**
+         * @brief Takes the pending preset if the previous switch has finished (audio thread)
+         */
+        void AdoptPending();
+
+        /**
+         * @brief Runs both presets and mixes the outgoing one out (audio thread)
+         * @param buffer Interleaved samples processed in place
+         */
+        void ProcessCrossfade(std::span<float> buffer);
+
+        /**
+         * @brief Queues a preset for deletion by the reclaim thread (audio thread)
+         * @param slot Preset to retire
+         * @return false if the queue is full (the caller keeps the preset)
+         */
+        bool Retire(Slot *slot);
+
+        /**
+         * @brief Reclaim thread entry point
+         */
+        void ReclaimLoop();
+
+        /**
+         * @brief Deletes every queued preset (reclaim thread or destructor)
+         */
+        void Reclaim();
+
+        PresetSwitcherConfig config;     ///< Switcher configuration
+        TaggedVector<float> fadeBuffer;  ///< Input copy processed by the outgoing preset
+        uint32_t maxBlockFrames = 0;     ///< Frames per crossfade chunk
+        uint32_t channels = 0;           ///< Interleaved channels
+        AudioMixer::Kernels kernels;     ///< Crossfade kernels for the prepared format
+        std::atomic<uint64_t> loads = 0; ///< Presets published so far (generation counter)
+        std::string lastError;           ///< Last error message
+
+        alignas(CACHE_LINE_SIZE) std::atomic<Slot *> pending = nullptr; ///< Published, not yet adopted
+        std::atomic<uint32_t> crossfadeFrames = 0;                      ///< Crossfade length at the current rate
+
+        alignas(CACHE_LINE_SIZE) Slot *active = nullptr; ///< Preset producing the output
+        Slot *outgoing = nullptr;                        ///< Preset being faded out
+        uint32_t fadePosition = 0;                       ///< Frames of the crossfade done
+        uint32_t fadeLength = 0;                         ///< Length of the running crossfade
+        std::atomic<uint64_t> activeGeneration = 0;      ///< Generation of active
+        std::atomic<bool> crossfading = false;           ///< outgoing is set
+        SpscRingBuffer<Slot *> retired;                  ///< Audio thread -> reclaim thread
+
+        std::atomic<bool> reclaiming = false; ///< Reclaim thread keep-alive flag
+        std::atomic<uint64_t> reclaimed = 0;  ///< Presets deleted
+        std::thread reclaimer;                ///< Background deletion thread
+    };
+
+} // namespace GuitarIO
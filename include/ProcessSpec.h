@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Stream format a processor is prepared for
+     *
+     * AudioProcessor::Prepare() sizes every buffer for maxSampleRate and maxBlockFrames, so later
+     * sample-rate changes up to maxSampleRate only recompute coefficients
+     * (AudioProcessor::SetSampleRate()) and never reallocate.
+     */
+    struct ProcessSpec
+    {
+        double sampleRate = 48000.0;   ///< Initial sample rate (Hz)
+        double maxSampleRate = 0.0;    ///< Highest rate SetSampleRate() may switch to (0 = sampleRate)
+        uint32_t maxBlockFrames = 512; ///< Largest block passed to Process()
+        uint32_t channels = 1;         ///< Number of interleaved channels
+
+        /**
+         * @brief Gets the rate buffers must be sized for
+         */
+        [[nodiscard]] double GetMaxSampleRate() const
+        {
+            return std::max(sampleRate, maxSampleRate);
+        }
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "AudioBlock.h"
+#include "AudioProcessor.h"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Ordered list of processors applied to a block in place
+     */
+    class ProcessorChain
+    {
+    public:
+        /**
+         * @brief Appends a processor to the end of the chain
+         * @param processor Processor to take ownership of (ignored if null)
+         */
+        void Add(std::unique_ptr<AudioProcessor> processor);
+
+        /**
+         * @brief Runs every processor on the block in order
+         * @param buffer Interleaved samples (frames * channels)
+         * @param channels Number of interleaved channels
+         */
+        void Process(std::span<float> buffer, uint32_t channels);
+
+        /**
+         * @brief Runs the chain, skipping processors whose tail has decayed while the block is silent
+         *
+         * The block's silent flag is updated as it propagates: a processor that runs on silent
+         * input is re-checked against the silence threshold.
+         *
+         * @param block Block to process in place
+         */
+        void Process(AudioBlock &block);
+
+        /**
+         * @brief Sets the peak level at or below which a processed block counts as silent
+         * @param threshold Linear amplitude threshold
+         */
+        void SetSilenceThreshold(float threshold);
+
+        /**
+         * @brief Prepares every processor for a stream format (not real-time safe)
+         * @param spec Stream format
+         * @return true if every processor accepted the format
+         */
+        bool Prepare(const ProcessSpec &spec);
+
+        /**
+         * @brief Switches every processor to another sample rate without reallocating (control thread)
+         * @param sampleRate New sample rate in Hz
+         */
+        void SetSampleRate(double sampleRate);
+
+        /**
+         * @brief Resets every processor in the chain
+         */
+        void Reset();
+
+        /**
+         * @brief Gets the latency of the whole chain (sum of every processor's latency)
+         */
+        [[nodiscard]] uint32_t GetLatencyFrames() const;
+
+        /**
+         * @brief Gets the number of processors in the chain
+         */
+        [[nodiscard]] size_t GetSize() const;
+
+        /**
+         * @brief Gets a processor by position
+         * @param index Position in the chain
+         * @return Processor pointer, or nullptr if out of range
+         */
+        [[nodiscard]] AudioProcessor *Get(size_t index) const;
+
+    private:
+        std::vector<std::unique_ptr<AudioProcessor>> processors; ///< Processors in execution order
+
+        std::vector<uint32_t> silentFrames; ///< Consecutive silent input frames seen by each processor
+        float silenceThreshold = 0.0f;      ///< Peak level treated as silence
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "SpscRingBuffer.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace GuitarIO
+{
+    /**
+     * @brief Kind of profiling event
+     */
+    enum class ProfileEventType : uint8_t
+    {
+        Scope,   ///< Timed region (start..end)
+        Counter, ///< Sampled value
+        Instant  ///< Point-in-time trace marker
+    };
+
+    /**
+     * @brief One recorded profiling event
+     *
+     * Timestamps are raw ticks of Profiler::ReadTimestamp(); convert with Profiler::GetTicksPerSecond().
+     */
+    struct ProfileEvent
+    {
+        const char *name = nullptr;                      ///< Static event name (string literal)
+        uint64_t start = 0;                              ///< Start tick (event time for counters and instants)
+        uint64_t end = 0;                                ///< End tick (scopes only)
+        int64_t value = 0;                               ///< Counter value
+        uint32_t thread = 0;                             ///< Pool slot of the recording thread (reused after it exits)
+        ProfileEventType type = ProfileEventType::Scope; ///< Event kind
+    };
+
+    /**
+     * @brief Low-overhead event recorder behind the GUITAR_IO_PROFILE_* macros
+     *
+     * Each thread records into its own single-producer ring taken from a fixed pool of MAX_THREADS
+     * rings, allocated once when profiling is first enabled. A thread claims a free ring with one
+     * compare-exchange on its first event and releases it when the thread exits, so recording never
+     * locks or allocates and stream restarts on fresh threads reuse the pool. Events from a thread
+     * that finds the pool exhausted, or its ring full, are dropped and counted. Collect() drains
+     * every ring from a non-real-time thread.
+     *
+     * The macros compile to nothing unless the library is configured with
+     * GUITAR_IO_ENABLE_PROFILING. When compiled in, recording is gated by SetEnabled(): a disabled
+     * profiler costs one relaxed load and a predicted branch per site. Timestamps come from the
+     * CPU timestamp counter (RDTSC on x86, CNTVCT on AArch64) with a steady_clock fallback.
+     */
+    class Profiler
+    {
+    public:
+        static constexpr size_t THREAD_CAPACITY = 16384; ///< Events buffered per thread between Collect() calls
+        static constexpr size_t MAX_THREADS = 16;        ///< Threads that can record at the same time
+
+        /**
+         * @brief Enables or disables recording at runtime
+         *
+         * The first enable allocates the ring pool (not real-time safe).
+         *
+         * @param enable true to record events
+         */
+        static void SetEnabled(bool enable);
+
+        /**
+         * @brief Checks whether recording is enabled
+         */
+        [[nodiscard]] static bool IsEnabled()
+        {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Claims a ring for the calling thread ahead of its first event
+         *
+         * Recording claims a ring on a thread's first event anyway; calling this first also registers
+         * the thread-exit release with the C++ runtime off the audio thread.
+         */
+        static void RegisterThread();
+
+        /**
+         * @brief Reads the timestamp counter
+         * @return Current tick count
+         */
+        [[nodiscard]] static uint64_t ReadTimestamp()
+        {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#elif defined(__aarch64__)
+            uint64_t ticks = 0;
+            __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+            return ticks;
+#else
+            const auto now = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+#endif
+        }
+
+        /**
+         * @brief Gets the timestamp frequency (calibrated against steady_clock on first call)
+         * @return Ticks per second
+         */
+        [[nodiscard]] static double GetTicksPerSecond();
+
+        /**
+         * @brief Records a timed scope
+         * @param name Static event name
+         * @param start Tick at scope entry
+         * @param end Tick at scope exit
+         */
+        static void RecordScope(const char *name, uint64_t start, uint64_t end);
+
+        /**
+         * @brief Records a counter sample
+         * @param name Static counter name
+         * @param value Sampled value
+         */
+        static void RecordCounter(const char *name, int64_t value);
+
+        /**
+         * @brief Records an instant trace marker
+         * @param name Static event name
+         */
+        static void RecordInstant(const char *name);
+
+        /**
+         * @brief Moves every buffered event into a vector (non-real-time thread)
+         * @param events Destination; events are appended grouped by thread, in order per thread
+         * @return Number of events appended
+         */
+        static size_t Collect(std::vector<ProfileEvent> &events);
+
+        /**
+         * @brief Gets the number of events dropped because a thread's ring was full or no ring was free
+         */
+        [[nodiscard]] static uint64_t GetDroppedEvents();
+
+    private:
+        /**
+         * @brief Pooled event ring, owned by at most one thread at a time
+         */
+        struct ThreadBuffer
+        {
+            /**
+             * @brief Allocates the ring
+             */
+            ThreadBuffer() : events(THREAD_CAPACITY)
+            {
+            }
+
+            SpscRingBuffer<ProfileEvent> events; ///< Owning thread -> Collect()
+            std::atomic<bool> claimed = false;   ///< Owned by a live thread
+            uint32_t index = 0;                  ///< Pool slot
+        };
+
+        struct Registry;
+        struct ThreadSlot;
+
+        /**
+         * @brief Gets the registry owning the ring pool (allocated on first call)
+         */
+        static Registry &GetRegistry();
+
+        /**
+         * @brief Gets the calling thread's buffer, claiming a free pool slot on first use
+         * @return Buffer, or null if every slot is owned by another thread
+         */
+        static ThreadBuffer *GetThreadBuffer();
+
+        /**
+         * @brief Appends an event to the calling thread's ring
+         * @param event Event to record
+         */
+        static void Record(ProfileEvent event);
+
+        static std::atomic<bool> enabled;     ///< Runtime recording switch
+        static std::atomic<uint64_t> dropped; ///< Events lost to full rings
+    };
+
+    /**
+     * @brief RAII timer recording a Profiler scope event on destruction
+     */
+    class ProfileScope
+    {
+    public:
+        /**
+         * @brief Starts timing if the profiler is enabled
+         * @param name Static event name
+         */
+        explicit ProfileScope(const char *name) : name(name)
+        {
+            if (Profiler::IsEnabled()) [[unlikely]]
+            {
+                start = Profiler::ReadTimestamp();
+            }
+        }
+
+        /**
+         * @brief Records the scope if timing started
+         */
+        ~ProfileScope()
+        {
+            if (start != 0) [[unlikely]]
+            {
+                Profiler::RecordScope(name, start, Profiler::ReadTimestamp());
+            }
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        const char *name;   ///< Static event name
+        uint64_t start = 0; ///< Entry tick (0 = not recording)
+    };
+
+} // namespace GuitarIO
+
+#define GUITAR_IO_PROFILE_CONCAT_INNER(a, b) a##b
+#define GUITAR_IO_PROFILE_CONCAT(a, b) GUITAR_IO_PROFILE_CONCAT_INNER(a, b)
+
+#if defined(GUITAR_IO_PROFILING)
+
+/// Times the enclosing scope under a static name
+#define GUITAR_IO_PROFILE_SCOPE(name)                                                                                  \
+    const ::GuitarIO::ProfileScope GUITAR_IO_PROFILE_CONCAT(guitarIoProfileScope, __LINE__)(name)
+
+/// Records a counter sample
+#define GUITAR_IO_PROFILE_COUNTER(name, value)                                                                         \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (::GuitarIO::Profiler::IsEnabled()) [[unlikely]]                                                            \
+        {                                                                                                              \
+            ::GuitarIO::Profiler::RecordCounter(name, static_cast<int64_t>(value));                                    \
+        }                                                                                                              \
+    } while (0)
+
+/// Records an instant trace marker
+#define GUITAR_IO_PROFILE_EVENT(name)                                                                                  \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (::GuitarIO::Profiler::IsEnabled()) [[unlikely]]                                                            \
+        {                                                                                                              \
+            ::GuitarIO::Profiler::RecordInstant(name);                                                                 \
+        }                                                                                                              \
+    } while (0)
+
+#else
+
+#define GUITAR_IO_PROFILE_SCOPE(name) static_cast<void>(0)
+#define GUITAR_IO_PROFILE_COUNTER(name, value) static_cast<void>(0)
+#define GUITAR_IO_PROFILE_EVENT(name) static_cast<void>(0)
+
+#endif
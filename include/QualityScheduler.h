@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Quality scheduler configuration
+     *
+     * Loads are fractions of the buffer period (1.0 = the callback took the whole period).
+     */
+    struct QualitySchedulerConfig
+    {
+        float targetLoad = 0.7f;     ///< Load above which quality steps down
+        float recoverLoad = 0.45f;   ///< Smoothed load below which quality may step back up
+        uint32_t stepDownBlocks = 2; ///< Consecutive over-budget blocks before stepping down
+        uint32_t stepUpBlocks = 500; ///< Consecutive relaxed blocks before stepping up
+        float loadSmoothing = 0.05f; ///< Weight of the newest block in the smoothed load
+    };
+
+    /**
+     * @brief Quality scheduler statistics
+     */
+    struct QualitySchedulerStats
+    {
+        float load = 0.0f;      ///< Smoothed callback load
+        float peakLoad = 0.0f;  ///< Highest single-block load since Reset()
+        uint32_t level = 0;     ///< Current degradation level (0 = full quality)
+        uint64_t stepDowns = 0; ///< Number of quality reductions
+        uint64_t stepUps = 0;   ///< Number of quality restorations
+    };
+
+    /**
+     * @brief Trades processing quality for headroom when the audio callback nears its deadline
+     *
+     * Processors register fallbacks with a number of cheaper levels (fewer voices, shorter FFTs,
+     * lower oversampling, skipped analysis hops). The scheduler measures each callback with
+     * BeginBlock()/EndBlock() (or takes an external measurement via ReportLoad()) and steps the
+     * global degradation level down or up with hysteresis. One step degrades the first fallback
+     * that still has a cheaper level, in registration order, so register the least audible first.
+     *
+     * Fallback callbacks run on the audio thread and must be real-time safe.
+     */
+    class QualityScheduler
+    {
+    public:
+        /**
+         * @brief Applies a fallback level (0 = full quality)
+         */
+        using Fallback = std::function<void(uint32_t level)>;
+
+        /**
+         * @brief Constructs a scheduler
+         * @param config Scheduler configuration
+         */
+        explicit QualityScheduler(const QualitySchedulerConfig &config = {});
+
+        /**
+         * @brief Registers a fallback (setup only, not real-time safe)
+         * @param name Human-readable name for diagnostics
+         * @param levels Number of cheaper levels the fallback offers
+         * @param apply Callback applying a level
+         * @return Fallback index
+         */
+        size_t AddFallback(std::string name, uint32_t levels, Fallback apply);
+
+        /**
+         * @brief Sets the buffer period the load is measured against
+         * @param sampleRate Audio sample rate in Hz
+         * @param bufferSize Frames per callback
+         */
+        void Prepare(double sampleRate, uint32_t bufferSize);
+
+        /**
+         * @brief Marks the start of a callback (audio thread)
+         */
+        void BeginBlock();
+
+        /**
+         * @brief Marks the end of a callback and updates the level (audio thread)
+         */
+        void EndBlock();
+
+        /**
+         * @brief Feeds an externally measured load and updates the level (audio thread)
+         * @param load Callback time as a fraction of the buffer period
+         */
+        void ReportLoad(float load);
+
+        /**
+         * @brief Restores full quality and clears statistics (audio thread or stopped stream)
+         */
+        void Reset();
+
+        /**
+         * @brief Gets the current degradation level (0 = full quality)
+         */
+        [[nodiscard]] uint32_t GetLevel() const;
+
+        /**
+         * @brief Gets the deepest available degradation level
+         */
+        [[nodiscard]] uint32_t GetMaxLevel() const;
+
+        /**
+         * @brief Gets the current fallback level of a registered fallback
+         * @param index Fallback index returned by AddFallback()
+         */
+        [[nodiscard]] uint32_t GetFallbackLevel(size_t index) const;
+
+        /**
+         * @brief Gets the name of a registered fallback
+         * @param index Fallback index returned by AddFallback()
+         */
+        [[nodiscard]] std::string GetFallbackName(size_t index) const;
+
+        /**
+         * @brief Gets a snapshot of the statistics (safe from any thread)
+         */
+        [[nodiscard]] QualitySchedulerStats GetStats() const;
+
+    private:
+        /**
+         * @brief Registered fallback
+         */
+        struct FallbackSlot
+        {
+            std::string name; ///< Diagnostic name
+            uint32_t levels;  ///< Number of cheaper levels
+            Fallback apply;   ///< Level callback
+        };
+
+        /**
+         * @brief Moves the global level and applies the affected fallback
+         * @param newLevel Level to move to (one step away from the current level)
+         */
+        void ApplyLevel(uint32_t newLevel);
+
+        /**
+         * @brief Splits a global level into the level of one fallback
+         * @param level Global degradation level
+         * @param index Fallback index
+         * @return Fallback level
+         */
+        [[nodiscard]] uint32_t FallbackLevelAt(uint32_t level, size_t index) const;
+
+        QualitySchedulerConfig config;                    ///< Scheduler configuration
+        std::vector<FallbackSlot> fallbacks;              ///< Registered fallbacks
+        uint32_t maxLevel = 0;                            ///< Sum of fallback levels
+        double periodSeconds = 0.0;                       ///< Buffer period
+        std::chrono::steady_clock::time_point blockStart; ///< Start of the current block
+        uint32_t overBudgetBlocks = 0;                    ///< Consecutive blocks above targetLoad
+        uint32_t relaxedBlocks = 0;                       ///< Consecutive blocks below recoverLoad
+        float smoothedLoad = 0.0f;                        ///< Exponentially smoothed load
+        std::atomic<uint32_t> level = 0;                  ///< Current degradation level
+        std::atomic<float> publishedLoad = 0.0f;          ///< Smoothed load for GetStats()
+        std::atomic<float> peakLoad = 0.0f;               ///< Highest block load
+        std::atomic<uint64_t> stepDowns = 0;              ///< Quality reductions
+        std::atomic<uint64_t> stepUps = 0;                ///< Quality restorations
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "MemoryAccounting.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Integer-factor downsampler with a windowed-sinc anti-aliasing filter
+     *
+     * Works on interleaved blocks and keeps its phase across calls, so block sizes need not be
+     * multiples of the factor. Only every factor-th output is computed.
+     */
+    class Decimator
+    {
+    public:
+        static constexpr uint32_t DEFAULT_TAPS_PER_PHASE = 16; ///< Filter length per unit of factor
+
+        /**
+         * @brief Designs the filter and allocates history (not real-time safe)
+         * @param factor Downsampling factor (1 = pass-through)
+         * @param channels Number of interleaved channels
+         * @param tapsPerPhase Filter length divided by the factor
+         */
+        void Prepare(uint32_t factor, uint32_t channels, uint32_t tapsPerPhase = DEFAULT_TAPS_PER_PHASE);
+
+        /**
+         * @brief Downsamples a block
+         * @param input Interleaved input at the high rate
+         * @param output Interleaved output at the low rate (room for input frames / factor + 1)
+         * @return Number of output frames written
+         */
+        size_t Process(std::span<const float> input, std::span<float> output);
+
+        /**
+         * @brief Clears the filter history and phase
+         */
+        void Reset();
+
+        /**
+         * @brief Gets the filter group delay in high-rate samples
+         */
+        [[nodiscard]] uint32_t GetLatencySamples() const;
+
+    private:
+        uint32_t factor = 1;                         ///< Downsampling factor
+        uint32_t channels = 1;                       ///< Interleaved channels
+        uint32_t phase = 0;                          ///< Input samples since the last output
+        size_t position = 0;                         ///< Next history write index
+        TaggedVector<float, MemoryTag::Tables> taps; ///< Filter coefficients (reversed)
+        TaggedVector<float> history;                 ///< Per-channel mirrored history (2 * taps each)
+    };
+
+    /**
+     * @brief Integer-factor upsampler with a polyphase windowed-sinc interpolation filter
+     */
+    class Interpolator
+    {
+    public:
+        static constexpr uint32_t DEFAULT_TAPS_PER_PHASE = 16; ///< Filter length per unit of factor
+
+        /**
+         * @brief Designs the filter and allocates history (not real-time safe)
+         * @param factor Upsampling factor (1 = pass-through)
+         * @param channels Number of interleaved channels
+         * @param tapsPerPhase Filter taps evaluated per output sample
+         */
+        void Prepare(uint32_t factor, uint32_t channels, uint32_t tapsPerPhase = DEFAULT_TAPS_PER_PHASE);
+
+        /**
+         * @brief Upsamples a block
+         * @param input Interleaved input at the low rate
+         * @param output Interleaved output at the high rate (room for input frames * factor)
+         * @return Number of output frames written
+         */
+        size_t Process(std::span<const float> input, std::span<float> output);
+
+        /**
+         * @brief Clears the filter history
+         */
+        void Reset();
+
+        /**
+         * @brief Gets the filter group delay in high-rate samples
+         */
+        [[nodiscard]] uint32_t GetLatencySamples() const;
+
+    private:
+        uint32_t factor = 1;                           ///< Upsampling factor
+        uint32_t channels = 1;                         ///< Interleaved channels
+        uint32_t tapsPerPhase = 1;                     ///< Taps per polyphase branch
+        size_t position = 0;                           ///< Next history write index
+        TaggedVector<float, MemoryTag::Tables> phases; ///< Polyphase coefficients [phase][tap], scaled by factor
+        TaggedVector<float> history;                   ///< Per-channel mirrored history (2 * tapsPerPhase each)
+    };
+
+} // namespace GuitarIO
@@ -1,11 +1,33 @@
 #pragma once
 
 #include "AudioDevice.h"
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <RtAudio.h>
 
 namespace GuitarIO
 {
+    class CallbackRecorder;
+    struct AudioStreamMetrics;
+
+    /**
+     * @brief Lifecycle state of an audio stream
+     *
+     * Transitional states (Opening, Starting, Stopping, Closing) are held by exactly one thread
+     * while it calls into the backend; other threads observe them and back off.
+     */
+    enum class StreamState : uint8_t
+    {
+        Closed,   ///< No stream
+        Opening,  ///< Open() in progress
+        Open,     ///< Stream open and stopped
+        Starting, ///< Start() in progress
+        Running,  ///< Stream running
+        Stopping, ///< Stop() in progress
+        Closing   ///< Close() in progress
+    };
+
     /**
      * @brief RtAudio-based implementation of AudioDevice interface
      *
@@ -17,6 +39,10 @@ namespace GuitarIO
      *
      * This class is the default production implementation. For testing,
      * use MockAudioDevice instead.
+     *
+     * Stream lifecycle is tracked by an atomic state machine: IsOpen(), IsRunning() and
+     * GetState() never touch the backend and may be polled from any thread, and concurrent
+     * Open()/Start()/Stop()/Close() calls are serialized by state transitions instead of racing.
      */
     class RtAudioDevice : public AudioDevice
     {
@@ -99,6 +125,27 @@ namespace GuitarIO
          */
         [[nodiscard]] bool IsRunning() const override;
 
+        /**
+         * @brief Gets the current stream state (lock-free)
+         * @return Stream state
+         */
+        [[nodiscard]] StreamState GetState() const;
+
+        /**
+         * @brief Attaches a recorder that captures every callback's input, status and output checksum
+         * @param recorder Recorder to feed (nullptr detaches; must outlive the attachment)
+         */
+        void SetRecorder(CallbackRecorder *recorder);
+
+        /**
+         * @brief Attaches health metrics updated on every callback (callback count, xruns, load)
+         *
+         * Load is the callback's duration divided by the buffer period at the negotiated rate.
+         *
+         * @param metrics Metrics to update (nullptr detaches; must outlive the attachment)
+         */
+        void SetMetrics(const AudioStreamMetrics *metrics);
+
         /**
          * @brief Returns the last error message
          * @return Error message string
@@ -106,6 +153,27 @@ namespace GuitarIO
         [[nodiscard]] std::string GetLastError() const override;
 
     private:
+        /**
+         * @brief Atomically moves between two states
+         * @param from Expected current state
+         * @param to New state
+         * @return true if the state was `from` and is now `to`
+         */
+        bool TryTransition(StreamState from, StreamState to);
+
+        /**
+         * @brief Sets the last error message (thread-safe)
+         * @param message Error message
+         */
+        void SetLastError(std::string message);
+
+        /**
+         * @brief Builds the error for a Start()/Stop() call rejected in the given state
+         * @param current State observed when the transition failed
+         * @return Error message
+         */
+        [[nodiscard]] static std::string DescribeRejectedTransition(StreamState current);
+
         /**
          * @brief RtAudio callback function
          * @param outputBuffer Output audio buffer
@@ -123,14 +191,20 @@ namespace GuitarIO
             RtAudioStreamStatus status,
             void *userData);
 
-        mutable RtAudio rtAudio;                ///< RtAudio instance
-        AudioCallback callback;                 ///< User callback function
-        void *userData = nullptr;               ///< User data pointer
-        mutable std::string lastError;          ///< Last error message
-        RtAudio::StreamParameters inputParams;  ///< Input stream parameters
-        RtAudio::StreamParameters outputParams; ///< Output stream parameters
-        bool hasInput = false;                  ///< Flag indicating input is enabled
-        bool hasOutput = false;                 ///< Flag indicating output is enabled
+        mutable RtAudio rtAudio;                              ///< RtAudio instance
+        AudioCallback callback;                               ///< User callback function
+        void *userData = nullptr;                             ///< User data pointer
+        mutable std::mutex errorMutex;                        ///< Guards lastError
+        mutable std::string lastError;                        ///< Last error message
+        RtAudio::StreamParameters inputParams;                ///< Input stream parameters
+        RtAudio::StreamParameters outputParams;               ///< Output stream parameters
+        bool hasInput = false;                                ///< Flag indicating input is enabled
+        bool hasOutput = false;                               ///< Flag indicating output is enabled
+        std::atomic<StreamState> state = StreamState::Closed; ///< Stream lifecycle state
+        std::atomic<CallbackRecorder *> recorder = nullptr;   ///< Optional callback capture
+
+        std::atomic<const AudioStreamMetrics *> metrics = nullptr; ///< Optional health metrics
+        double streamSampleRate = 0.0;                             ///< Sample rate negotiated by Open()
     };
 
 } // namespace GuitarIO
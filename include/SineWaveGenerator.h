@@ -1,11 +1,20 @@
 #pragma once
 
+#include "CacheLine.h"
+#include <atomic>
+#include <cstdint>
 #include <span>
 
 namespace GuitarIO
 {
     /**
      * @brief Simple sine wave generator for audio synthesis
+     *
+     * Samples come from the compile-time quarter-wave table in LookupTables.h (linear
+     * interpolation, about 3e-7 peak error) instead of std::sin.
+     *
+     * Setters may be called from a control thread while Generate() runs on the audio thread.
+     * Control-written parameters and audio-written oscillator state live on separate cache lines.
      */
     class SineWaveGenerator
     {
@@ -16,6 +25,19 @@ namespace GuitarIO
          */
         explicit SineWaveGenerator(double sampleRate = 48000.0);
 
+        /**
+         * @brief Copies a generator (not safe against a concurrent Generate() on other)
+         * @param other Generator to copy
+         */
+        SineWaveGenerator(const SineWaveGenerator &other);
+
+        /**
+         * @brief Copy-assigns a generator (neither side may be generating concurrently)
+         * @param other Generator to copy
+         * @return This generator
+         */
+        SineWaveGenerator &operator=(const SineWaveGenerator &other);
+
         /**
          * @brief Sets the frequency of the sine wave
          * @param freq Frequency in Hz
@@ -29,7 +51,7 @@ namespace GuitarIO
         void SetAmplitude(float amp);
 
         /**
-         * @brief Sets the sample rate
+         * @brief Sets the sample rate (safe while Generate() runs; applied at the next block)
          * @param rate Sample rate in Hz
          */
         void SetSampleRate(double rate);
@@ -48,14 +70,22 @@ namespace GuitarIO
 
     private:
         /**
-         * @brief Updates the phase increment based on frequency and sample rate
+         * @brief Updates the phase increment after a frequency or sample rate change (audio thread)
+         *
+         * Like the setters did before they became thread-safe, the increment stays 0 (silence)
+         * until SetFrequency() or SetSampleRate() is first called.
          */
         void UpdateIncrement();
 
-        double sampleRate = 48000.0; ///< Audio sample rate in Hz
-        double frequency = 440.0;    ///< Wave frequency in Hz
-        float amplitude = 0.5f;      ///< Wave amplitude [0.0, 1.0]
-        double currentPhase = 0.0;   ///< Current phase accumulator [0.0, 2*PI]
-        double phaseIncrement = 0.0; ///< Phase increment per sample
+        // Control-written parameters
+        alignas(CACHE_LINE_SIZE) std::atomic<double> sampleRate; ///< Audio sample rate in Hz
+        std::atomic<double> frequency = 440.0;                   ///< Wave frequency in Hz
+        std::atomic<float> amplitude = 0.5f;                     ///< Wave amplitude [0.0, 1.0]
+        std::atomic<uint32_t> tuning = 0;                        ///< Bumped by SetFrequency()/SetSampleRate()
+
+        // Audio-written oscillator state
+        alignas(CACHE_LINE_SIZE) double currentPhase = 0.0; ///< Current phase accumulator in cycles [0.0, 1.0)
+        double phaseIncrement = 0.0;                        ///< Phase increment per sample in cycles (0 until tuned)
+        uint32_t appliedTuning = 0;                         ///< Value of tuning phaseIncrement was computed for
     };
 } // namespace GuitarIO
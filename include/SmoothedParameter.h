@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CacheLine.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Parameter values at the start and end of one control period
+     *
+     * Kernels such as AudioMixer::ApplyGainRamp() interpolate linearly between the two.
+     */
+    struct ParameterRamp
+    {
+        float start = 0.0f; ///< Value at the first sample of the period
+        float end = 0.0f;   ///< Value one sample past the end of the period
+
+        /**
+         * @brief Checks whether the value is constant over the period
+         */
+        [[nodiscard]] bool IsFlat() const
+        {
+            return start == end;
+        }
+    };
+
+    /**
+     * @brief Parameter smoothed at control rate instead of per sample
+     *
+     * The UI thread calls SetTarget(); the audio thread calls Tick() once every control period
+     * (GetControlInterval() samples) and feeds the returned ramp to a kernel. The smoothed value
+     * is the target plus the modulation offset written by a ModulationMatrix. When neither has
+     * changed and smoothing has settled, Tick() returns a flat ramp without doing any math.
+     */
+    class SmoothedParameter
+    {
+    public:
+        /**
+         * @brief Constructs a parameter
+         * @param initialValue Starting value (target and current)
+         * @param minValue Lower clamp of the modulated value
+         * @param maxValue Upper clamp of the modulated value
+         */
+        explicit SmoothedParameter(float initialValue = 0.0f,
+            float minValue = std::numeric_limits<float>::lowest(),
+            float maxValue = std::numeric_limits<float>::max());
+
+        /**
+         * @brief Copies a parameter (not safe against a concurrent Tick() on other)
+         * @param other Parameter to copy
+         */
+        SmoothedParameter(const SmoothedParameter &other);
+
+        /**
+         * @brief Copy-assigns a parameter (neither side may be ticked concurrently)
+         * @param other Parameter to copy
+         * @return This parameter
+         */
+        SmoothedParameter &operator=(const SmoothedParameter &other);
+
+        /**
+         * @brief Configures timing
+         * @param sampleRate Audio sample rate in Hz
+         * @param controlInterval Samples per control period (for example 16 or 32)
+         * @param smoothingMs Smoothing time constant in milliseconds (0 = jump)
+         */
+        void Prepare(double sampleRate, uint32_t controlInterval = 32, double smoothingMs = 20.0);
+
+        /**
+         * @brief Recomputes the smoothing coefficient for a new sample rate (safe from any thread)
+         *
+         * Keeps the control interval and smoothing time given to Prepare(); the audio thread picks
+         * up the new coefficient at its next Tick().
+         *
+         * @param sampleRate Audio sample rate in Hz
+         */
+        void SetSampleRate(double sampleRate);
+
+        /**
+         * @brief Sets the value to glide to (safe from any thread)
+         * @param value New target value
+         */
+        void SetTarget(float value);
+
+        /**
+         * @brief Jumps to a value without smoothing (audio thread)
+         * @param value New value
+         */
+        void SetImmediate(float value);
+
+        /**
+         * @brief Sets the modulation offset added to the target (audio thread)
+         * @param offset Offset in parameter units
+         */
+        void SetModulation(float offset);
+
+        /**
+         * @brief Advances one control period (audio thread)
+         * @return Value ramp for the period
+         */
+        ParameterRamp Tick();
+
+        /**
+         * @brief Gets the current smoothed value
+         */
+        [[nodiscard]] float GetValue() const;
+
+        /**
+         * @brief Gets the last target set with SetTarget()
+         */
+        [[nodiscard]] float GetTarget() const;
+
+        /**
+         * @brief Checks whether the value has reached its modulated target
+         */
+        [[nodiscard]] bool IsSettled() const;
+
+        /**
+         * @brief Gets the number of samples per control period
+         */
+        [[nodiscard]] uint32_t GetControlInterval() const;
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<float> target; ///< Value requested by the UI (UI-written line)
+        std::atomic<float> coefficient = 1.0f;              ///< One-pole coefficient per control period
+        double smoothingMs = 20.0;                          ///< Smoothing time constant
+
+        alignas(CACHE_LINE_SIZE) float appliedTarget; ///< Target seen by the last Tick()
+        float modulation = 0.0f;                      ///< Offset from the modulation matrix
+        float goal;                                   ///< Clamped target + modulation
+        float current;                                ///< Smoothed value
+        float minValue;                               ///< Lower clamp
+        float maxValue;                               ///< Upper clamp
+        uint32_t controlInterval = 32;                ///< Samples per control period
+        bool modulationChanged = false;               ///< Modulation offset changed since last Tick()
+        bool settled = true;                          ///< Current value equals goal
+    };
+
+} // namespace GuitarIO
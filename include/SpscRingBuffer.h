@@ -0,0 +1,185 @@
+#pragma once
+
+#include "CacheLine.h"
+#include "MemoryAccounting.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Lock-free single-producer/single-consumer ring buffer
+     *
+     * One thread may call Write() while another calls Read(); both sides are wait-free
+     * and never allocate. Capacity is rounded up to a power of two so indices wrap with a mask.
+     *
+     * @tparam T Trivially copyable element type
+     */
+    template<typename T> class SpscRingBuffer
+    {
+    public:
+        /**
+         * @brief Constructs a ring buffer
+         * @param minCapacity Minimum number of elements (rounded up to a power of two)
+         */
+        explicit SpscRingBuffer(size_t minCapacity = 0)
+        {
+            Resize(minCapacity);
+        }
+
+        /**
+         * @brief Reallocates storage and discards contents (not thread-safe)
+         * @param minCapacity Minimum number of elements (rounded up to a power of two)
+         */
+        void Resize(size_t minCapacity)
+        {
+            size_t capacity = 1;
+            while (capacity < minCapacity)
+            {
+                capacity <<= 1;
+            }
+
+            buffer.assign(capacity, T{});
+            mask = capacity - 1;
+            writeIndex.store(0, std::memory_order_relaxed);
+            readIndex.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Writes as many elements as fit (producer side)
+         * @param data Elements to write
+         * @return Number of elements written
+         */
+        size_t Write(std::span<const T> data)
+        {
+            const size_t write = writeIndex.load(std::memory_order_relaxed);
+            const size_t read = readIndex.load(std::memory_order_acquire);
+            const size_t count = std::min(data.size(), buffer.size() - (write - read));
+
+            const size_t start = write & mask;
+            const size_t firstPart = std::min(count, buffer.size() - start);
+            std::copy_n(data.begin(), firstPart, buffer.begin() + static_cast<std::ptrdiff_t>(start));
+            std::copy_n(data.begin() + static_cast<std::ptrdiff_t>(firstPart), count - firstPart, buffer.begin());
+
+            writeIndex.store(write + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Writes several spans as one unit, or nothing if they do not all fit (producer side)
+         *
+         * The consumer sees either none or all of the elements, never a prefix.
+         *
+         * @param parts Spans written back to back
+         * @return true if written, false if there was not enough space
+         */
+        bool WriteAll(std::initializer_list<std::span<const T>> parts)
+        {
+            size_t total = 0;
+            for (std::span<const T> part : parts)
+            {
+                total += part.size();
+            }
+
+            const size_t write = writeIndex.load(std::memory_order_relaxed);
+            const size_t read = readIndex.load(std::memory_order_acquire);
+            if (total > buffer.size() - (write - read))
+            {
+                return false;
+            }
+
+            size_t position = write;
+            for (std::span<const T> part : parts)
+            {
+                const size_t start = position & mask;
+                const size_t firstPart = std::min(part.size(), buffer.size() - start);
+                std::copy_n(part.begin(), firstPart, buffer.begin() + static_cast<std::ptrdiff_t>(start));
+                std::copy_n(
+                    part.begin() + static_cast<std::ptrdiff_t>(firstPart), part.size() - firstPart, buffer.begin());
+                position += part.size();
+            }
+
+            writeIndex.store(position, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Reads up to data.size() elements (consumer side)
+         * @param data Destination buffer
+         * @return Number of elements read
+         */
+        size_t Read(std::span<T> data)
+        {
+            const size_t count = Peek(data);
+            readIndex.store(readIndex.load(std::memory_order_relaxed) + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Copies up to data.size() elements without consuming them (consumer side)
+         * @param data Destination buffer
+         * @return Number of elements copied
+         */
+        size_t Peek(std::span<T> data) const
+        {
+            const size_t read = readIndex.load(std::memory_order_relaxed);
+            const size_t write = writeIndex.load(std::memory_order_acquire);
+            const size_t count = std::min(data.size(), write - read);
+
+            const size_t start = read & mask;
+            const size_t firstPart = std::min(count, buffer.size() - start);
+            std::copy_n(buffer.begin() + static_cast<std::ptrdiff_t>(start), firstPart, data.begin());
+            std::copy_n(buffer.begin(), count - firstPart, data.begin() + static_cast<std::ptrdiff_t>(firstPart));
+
+            return count;
+        }
+
+        /**
+         * @brief Discards up to count elements (consumer side)
+         * @param count Number of elements to skip
+         * @return Number of elements skipped
+         */
+        size_t Skip(size_t count)
+        {
+            const size_t read = readIndex.load(std::memory_order_relaxed);
+            const size_t skipped = std::min(count, writeIndex.load(std::memory_order_acquire) - read);
+            readIndex.store(read + skipped, std::memory_order_release);
+            return skipped;
+        }
+
+        /**
+         * @brief Number of elements ready to be read
+         */
+        [[nodiscard]] size_t GetReadAvailable() const
+        {
+            const size_t read = readIndex.load(std::memory_order_acquire);
+            return writeIndex.load(std::memory_order_acquire) - read;
+        }
+
+        /**
+         * @brief Number of elements that can be written without overwriting unread data
+         */
+        [[nodiscard]] size_t GetWriteAvailable() const
+        {
+            return buffer.size() - GetReadAvailable();
+        }
+
+        /**
+         * @brief Total number of elements the buffer can hold
+         */
+        [[nodiscard]] size_t GetCapacity() const
+        {
+            return buffer.size();
+        }
+
+    private:
+        TaggedVector<T, MemoryTag::Rings> buffer;                    ///< Element storage (power-of-two size)
+        size_t mask = 0;                                             ///< Index wrap mask (capacity - 1)
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> writeIndex = 0; ///< Monotonic producer position
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> readIndex = 0;  ///< Monotonic consumer position
+    };
+} // namespace GuitarIO
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "MemoryAccounting.h"
+#include "ProcessorChain.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Stream host configuration
+     */
+    struct StreamHostConfig
+    {
+        uint32_t workerCount = 0;   ///< Worker threads (0 = hardware concurrency)
+        uint32_t maxStreams = 4096; ///< Capacity of the stream table
+        bool pinWorkers = false;    ///< Pin worker N to core N (Linux only)
+    };
+
+    /**
+     * @brief Virtual stream configuration
+     */
+    struct VirtualStreamConfig
+    {
+        uint32_t sampleRate = 48000;   ///< Sample rate (Hz), informational
+        uint32_t blockSize = 256;      ///< Frames per processing block
+        uint32_t channels = 1;         ///< Number of interleaved channels
+        uint32_t queueFrames = 16384;  ///< Input queue capacity (frames)
+        float silenceThreshold = 0.0f; ///< Peak level flagging a block silent (negative disables detection)
+    };
+
+    /**
+     * @brief Per-stream processing statistics
+     */
+    struct StreamStats
+    {
+        uint64_t blocksProcessed = 0;  ///< Blocks run through the processor chain
+        uint64_t framesProcessed = 0;  ///< Frames run through the processor chain
+        uint64_t framesDropped = 0;    ///< Frames rejected because the input queue was full
+        uint64_t blocksSilent = 0;     ///< Blocks that left the chain flagged silent
+        double lastLatencyMs = 0.0;    ///< Block ready to block processed, most recent block
+        double averageLatencyMs = 0.0; ///< Block ready to block processed, mean
+        double maxLatencyMs = 0.0;     ///< Block ready to block processed, worst case
+    };
+
+    /**
+     * @brief Aggregate host statistics
+     */
+    struct StreamHostStats
+    {
+        uint32_t streamCount = 0;     ///< Open streams
+        uint32_t workerCount = 0;     ///< Worker threads
+        uint64_t blocksProcessed = 0; ///< Blocks processed by all workers
+        uint64_t framesProcessed = 0; ///< Frames processed by all workers
+        uint64_t steals = 0;          ///< Blocks taken from another worker's run queue
+        double elapsedSeconds = 0.0;  ///< Time since Start()
+        double framesPerSecond = 0.0; ///< Aggregate throughput since Start()
+    };
+
+    /**
+     * @brief Callback receiving each processed block of a virtual stream
+     * @param streamId Stream the block belongs to
+     * @param block Processed interleaved block
+     * @param userData User data pointer
+     */
+    using StreamSink = std::function<void(uint32_t streamId, std::span<const float> block, void *userData)>;
+
+    /**
+     * @brief Headless host running many virtual streams on a worker pool
+     *
+     * Each virtual stream owns an input queue and a ProcessorChain. Whenever a full block
+     * is queued, the stream is scheduled on its home worker's run queue; idle workers steal
+     * from other queues. A stream runs one block per scheduling so thousands of streams
+     * share the pool fairly. Input comes from Push() (one producer thread per stream)
+     * or from attached sockets read by an ingest thread.
+     *
+     * Streams may be created while the host is running. Closed streams stop accepting
+     * input immediately; their memory is released when the host is destroyed.
+     */
+    class StreamHost
+    {
+    public:
+        static constexpr uint32_t INVALID_STREAM = UINT32_MAX; ///< Returned when stream creation fails
+
+        /**
+         * @brief Constructs a stream host
+         * @param config Host configuration
+         */
+        explicit StreamHost(const StreamHostConfig &config = {});
+
+        /**
+         * @brief Destructor (stops the worker pool)
+         */
+        ~StreamHost();
+
+        StreamHost(const StreamHost &) = delete;
+
+        StreamHost &operator=(const StreamHost &) = delete;
+
+        StreamHost(StreamHost &&) = delete;
+
+        StreamHost &operator=(StreamHost &&) = delete;
+
+        /**
+         * @brief Creates a virtual stream
+         * @param config Stream configuration
+         * @param chain Processor chain applied to every block
+         * @param sink Optional callback receiving processed blocks (called on a worker thread)
+         * @param userPtr User data pointer passed to sink
+         * @return Stream ID, or INVALID_STREAM on failure
+         */
+        uint32_t CreateStream(const VirtualStreamConfig &config,
+            ProcessorChain chain,
+            StreamSink sink = nullptr,
+            void *userPtr = nullptr);
+
+        /**
+         * @brief Closes a stream; further input is rejected
+         * @param streamId Stream ID
+         */
+        void CloseStream(uint32_t streamId);
+
+        /**
+         * @brief Queues interleaved samples for a stream (one producer thread per stream)
+         * @param streamId Stream ID
+         * @param samples Interleaved samples (whole frames)
+         * @return Number of frames accepted
+         */
+        size_t Push(uint32_t streamId, std::span<const float> samples);
+
+        /**
+         * @brief Feeds a stream from a socket carrying raw interleaved float32 samples
+         *
+         * The socket is read by the host's ingest thread while the host runs. Ownership stays
+         * with the caller; the descriptor must stay valid until DetachSocket() or Stop().
+         * Only supported on POSIX platforms.
+         *
+         * @param streamId Stream ID
+         * @param socketFd Connected stream or datagram socket descriptor
+         * @return true on success, false on failure
+         */
+        bool AttachSocket(uint32_t streamId, int socketFd);
+
+        /**
+         * @brief Stops reading a socket previously attached with AttachSocket()
+         * @param socketFd Socket descriptor
+         */
+        void DetachSocket(int socketFd);
+
+        /**
+         * @brief Starts the worker pool and the ingest thread
+         * @return true on success, false on failure
+         */
+        bool Start();
+
+        /**
+         * @brief Stops the worker pool; queued input is kept
+         */
+        void Stop();
+
+        /**
+         * @brief Checks if the worker pool is running
+         */
+        [[nodiscard]] bool IsRunning() const;
+
+        /**
+         * @brief Gets statistics for one stream
+         * @param streamId Stream ID
+         * @return Stream statistics (zeroed if the stream does not exist)
+         */
+        [[nodiscard]] StreamStats GetStreamStats(uint32_t streamId) const;
+
+        /**
+         * @brief Gets aggregate statistics for all streams
+         */
+        [[nodiscard]] StreamHostStats GetStats() const;
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        struct VirtualStream;
+
+        /**
+         * @brief Per-worker run queue and thread
+         */
+        struct Worker
+        {
+            std::mutex mutex;                  ///< Guards queue
+            std::deque<VirtualStream *> queue; ///< Streams with a block ready
+            std::thread thread;                ///< Worker thread
+        };
+
+        /**
+         * @brief Socket feeding a stream
+         */
+        struct SocketInput
+        {
+            int fd = -1;                ///< Socket descriptor
+            uint32_t streamId = 0;      ///< Destination stream
+            bool datagram = false;      ///< Datagram socket (empty reads are not end-of-stream)
+            TaggedVector<char> pending; ///< Bytes of a partially received frame (sized to one frame)
+            size_t pendingBytes = 0;    ///< Valid bytes in pending
+        };
+
+        /**
+         * @brief Stores an error message for GetLastError()
+         */
+        void SetLastError(std::string message);
+
+        /**
+         * @brief Looks up an open stream
+         */
+        [[nodiscard]] VirtualStream *FindStream(uint32_t streamId) const;
+
+        /**
+         * @brief Marks a stream runnable and queues it on its home worker
+         */
+        void Schedule(VirtualStream &stream);
+
+        /**
+         * @brief Takes a stream from the given worker's queue or steals one from another worker
+         */
+        VirtualStream *TakeWork(size_t workerIndex);
+
+        /**
+         * @brief Processes one block of a stream and reschedules it if more input is queued
+         */
+        void RunStream(VirtualStream &stream);
+
+        /**
+         * @brief Worker thread entry point
+         */
+        void WorkerLoop(size_t workerIndex);
+
+        /**
+         * @brief Ingest thread entry point (polls attached sockets)
+         */
+        void IngestLoop();
+
+        std::vector<std::unique_ptr<VirtualStream>> streams; ///< Stream table (fixed capacity)
+        std::atomic<uint32_t> streamCount = 0;               ///< Number of used stream slots
+        std::mutex streamsMutex;                             ///< Serializes stream creation
+
+        std::vector<std::unique_ptr<Worker>> workers; ///< Worker pool
+        std::mutex sleepMutex;                        ///< Guards idle worker sleep
+        std::condition_variable wakeup;               ///< Signals queued work or shutdown
+        std::atomic<size_t> queuedStreams = 0;        ///< Streams waiting in any run queue
+        std::atomic<bool> running = false;            ///< Worker pool running flag
+        bool pinWorkers = false;                      ///< Pin workers to cores
+
+        std::vector<SocketInput> sockets;         ///< Attached sockets
+        std::mutex socketsMutex;                  ///< Guards sockets
+        std::atomic<bool> socketsChanged = false; ///< Ingest thread must reload sockets
+        std::thread ingestThread;                 ///< Socket reader thread
+
+        std::atomic<uint64_t> totalBlocks = 0;           ///< Blocks processed since Start()
+        std::atomic<uint64_t> totalFrames = 0;           ///< Frames processed since Start()
+        std::atomic<uint64_t> totalSteals = 0;           ///< Steals since Start()
+        std::chrono::steady_clock::time_point startTime; ///< Time of last Start()
+        std::chrono::steady_clock::time_point stopTime;  ///< Time of last Stop()
+        mutable std::mutex errorMutex;                   ///< Guards lastError
+        std::string lastError;                           ///< Last error message
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "AudioDevice.h"
+#include "CallbackTrace.h"
+#include "MemoryAccounting.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Trace replay options
+     */
+    struct TraceReplayOptions
+    {
+        bool realTime = false;    ///< Pace blocks at the recorded sample rate instead of running flat out
+        bool verifyOutput = true; ///< Compare output checksums against the ones stored in the trace
+    };
+
+    /**
+     * @brief Callbacks driven by a replay
+     */
+    struct TraceReplayHandlers
+    {
+        AudioCallback process;                                         ///< Same callback used with the device
+        std::function<void(uint32_t id, float value)> parameter;       ///< Parameter events (optional)
+        std::function<void(uint32_t status, double streamTime)> block; ///< Per-block metadata (optional)
+    };
+
+    /**
+     * @brief Outcome of a replay
+     */
+    struct TraceReplayResult
+    {
+        uint64_t blocks = 0;             ///< Blocks replayed
+        uint64_t parameterEvents = 0;    ///< Parameter events delivered
+        uint64_t statusEvents = 0;       ///< Blocks recorded with a non-zero stream status (xruns)
+        uint64_t checksumsCompared = 0;  ///< Blocks with a stored output checksum
+        uint64_t checksumsSkipped = 0;   ///< Stored checksums after a gap, not compared
+        uint64_t checksumMismatches = 0; ///< Blocks whose output differed from the recording
+        int64_t firstMismatchBlock = -1; ///< Index of the first differing block (-1 = none)
+        uint64_t outputChecksum = 0;     ///< Checksum chained over every output block
+        uint64_t gaps = 0;               ///< Gap records (places where the recorder dropped records)
+        uint64_t droppedBlocks = 0;      ///< Blocks dropped during capture
+        uint64_t droppedParameters = 0;  ///< Parameter events dropped during capture
+        double elapsedSeconds = 0.0;     ///< Wall-clock replay time
+    };
+
+    /**
+     * @brief Replays a CallbackRecorder trace through a processing callback offline
+     *
+     * The whole trace is loaded by Open(), so replay performs no I/O. Parameter events are
+     * delivered before the block they preceded during capture, making replay deterministic:
+     * two replays of the same trace through the same processor yield the same outputChecksum.
+     *
+     * Where the recorder dropped blocks or parameter events, the trace holds a gap record. The
+     * processor state no longer matches the capture after a gap, so stored checksums that follow
+     * it are counted as skipped instead of compared.
+     */
+    class TraceReplayer
+    {
+    public:
+        /**
+         * @brief Loads a trace file
+         * @param path Trace file path
+         * @return true on success, false if the file is missing or malformed
+         */
+        bool Open(const std::string &path);
+
+        /**
+         * @brief Gets the recorded stream format
+         */
+        [[nodiscard]] AudioStreamConfig GetConfig() const;
+
+        /**
+         * @brief Replays the loaded trace
+         * @param handlers Processing and event callbacks
+         * @param result Receives replay statistics and checksums
+         * @param options Replay options
+         * @param userPtr User data pointer passed to the processing callback
+         * @return true if the whole trace was replayed, false on a malformed record or a stop request
+         */
+        bool Replay(const TraceReplayHandlers &handlers,
+            TraceReplayResult &result,
+            const TraceReplayOptions &options = {},
+            void *userPtr = nullptr);
+
+        /**
+         * @brief Returns the last error message
+         */
+        [[nodiscard]] std::string GetLastError() const;
+
+    private:
+        TraceHeader header;         ///< Loaded trace header
+        TaggedVector<uint8_t> data; ///< Records following the header
+        std::string lastError;      ///< Last error message
+    };
+
+} // namespace GuitarIO
@@ -0,0 +1,73 @@
+#include "AsyncExecutor.h"
+#include <algorithm>
+
+namespace GuitarIO
+{
+    AsyncExecutor::AsyncExecutor(uint32_t workerCount)
+    {
+        if (workerCount == 0)
+        {
+            workerCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            workers.emplace_back(&AsyncExecutor::WorkerLoop, this);
+        }
+    }
+
+    AsyncExecutor::~AsyncExecutor()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    void AsyncExecutor::Schedule(std::coroutine_handle<> handle)
+    {
+        {
+            std::lock_guard lock(mutex);
+            pending.push_back(handle);
+        }
+        wakeup.notify_one();
+    }
+
+    AsyncExecutor::ScheduleAwaiter AsyncExecutor::Schedule()
+    {
+        return ScheduleAwaiter(*this);
+    }
+
+    uint32_t AsyncExecutor::GetWorkerCount() const
+    {
+        return static_cast<uint32_t>(workers.size());
+    }
+
+    void AsyncExecutor::WorkerLoop()
+    {
+        while (true)
+        {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock lock(mutex);
+                wakeup.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (pending.empty())
+                {
+                    return;
+                }
+
+                handle = pending.front();
+                pending.pop_front();
+            }
+
+            handle.resume();
+        }
+    }
+
+} // namespace GuitarIO
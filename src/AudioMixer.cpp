@@ -1,9 +1,26 @@
 #include "AudioMixer.h"
+#include "Profiler.h"
+#include <cmath>
 
 namespace GuitarIO
 {
+    AudioMixer::Kernels AudioMixer::SelectKernels(uint32_t channels, uint32_t frames)
+    {
+        switch (channels)
+        {
+        case 1:
+            return SelectFrames<1>(frames);
+        case 2:
+            return SelectFrames<2>(frames);
+        default:
+            return {};
+        }
+    }
+
     void AudioMixer::Mix(std::span<const float> input, std::span<float> output, float gain)
     {
+        GUITAR_IO_PROFILE_SCOPE("AudioMixer::Mix");
+
         if (input.empty() || output.empty() || input.size() != output.size())
         {
             return;
@@ -15,6 +32,89 @@ namespace GuitarIO
         }
     }
 
+    void AudioMixer::Mix(const AudioBlock &input, AudioBlock &output, float gain)
+    {
+        if (input.silent || gain == 0.0f)
+        {
+            return;
+        }
+
+        Mix(input.samples, output.samples, gain);
+        output.silent = false;
+    }
+
+    void AudioMixer::MixRamp(std::span<const float> input,
+        std::span<float> output,
+        float startGain,
+        float endGain,
+        uint32_t channels)
+    {
+        GUITAR_IO_PROFILE_SCOPE("AudioMixer::MixRamp");
+
+        if (input.empty() || output.empty() || input.size() != output.size() || channels == 0)
+        {
+            return;
+        }
+
+        if (startGain == endGain)
+        {
+            Mix(input, output, startGain);
+            return;
+        }
+
+        const size_t frames = output.size() / channels;
+        const float step = (endGain - startGain) / static_cast<float>(frames);
+
+        if (channels == 1)
+        {
+            for (size_t i = 0; i < frames; ++i)
+            {
+                output[i] += input[i] * (startGain + step * static_cast<float>(i));
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            const float gain = startGain + step * static_cast<float>(i);
+            for (size_t c = 0; c < channels; ++c)
+            {
+                output[i * channels + c] += input[i * channels + c] * gain;
+            }
+        }
+    }
+
+    void AudioMixer::ApplyGainRamp(std::span<float> buffer, float startGain, float endGain, uint32_t channels)
+    {
+        GUITAR_IO_PROFILE_SCOPE("AudioMixer::ApplyGainRamp");
+
+        if (buffer.empty() || channels == 0)
+        {
+            return;
+        }
+
+        const size_t frames = buffer.size() / channels;
+        const float step = (endGain - startGain) / static_cast<float>(frames);
+
+        if (channels == 1)
+        {
+            for (size_t i = 0; i < frames; ++i)
+            {
+                buffer[i] *= startGain + step * static_cast<float>(i);
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            const float gain = startGain + step * static_cast<float>(i);
+            for (size_t c = 0; c < channels; ++c)
+            {
+                buffer[i * channels + c] *= gain;
+            }
+        }
+    }
+
     void AudioMixer::Clear(std::span<float> buffer)
     {
         std::ranges::fill(buffer, 0.0f);
@@ -22,9 +122,111 @@ namespace GuitarIO
 
     void AudioMixer::Limit(std::span<float> buffer, float threshold)
     {
+        GUITAR_IO_PROFILE_SCOPE("AudioMixer::Limit");
+
         for (float &sample : buffer)
         {
             sample = std::clamp(sample, -threshold, threshold);
         }
     }
+
+    bool AudioMixer::IsSilent(std::span<const float> buffer, float threshold)
+    {
+        // Branch-free inner loop over fixed chunks vectorizes to compare/or; exit per chunk
+        constexpr size_t CHUNK = 64;
+
+        const float *data = buffer.data();
+        const size_t size = buffer.size();
+
+        size_t i = 0;
+        for (; i + CHUNK <= size; i += CHUNK)
+        {
+            int loud = 0;
+            for (size_t j = 0; j < CHUNK; ++j)
+            {
+                loud |= static_cast<int>(std::fabs(data[i + j]) > threshold);
+            }
+            if (loud != 0)
+            {
+                return false;
+            }
+        }
+
+        int loud = 0;
+        for (; i < size; ++i)
+        {
+            loud |= static_cast<int>(std::fabs(data[i]) > threshold);
+        }
+
+        return loud == 0;
+    }
+
+    template<uint32_t Channels, uint32_t Frames> AudioMixer::Kernels AudioMixer::MakeKernels()
+    {
+        return { &MixFixed<Channels, Frames>,
+            &MixRampFixed<Channels, Frames>,
+            &ApplyGainRampFixed<Channels, Frames>,
+            true };
+    }
+
+    template<uint32_t Channels> AudioMixer::Kernels AudioMixer::SelectFrames(uint32_t frames)
+    {
+        switch (frames)
+        {
+        case 64:
+            return MakeKernels<Channels, 64>();
+        case 128:
+            return MakeKernels<Channels, 128>();
+        case 256:
+            return MakeKernels<Channels, 256>();
+        default:
+            return {};
+        }
+    }
+
+    template<uint32_t Channels, uint32_t Frames>
+    void AudioMixer::MixFixed(std::span<const float> input, std::span<float> output, float gain)
+    {
+        constexpr size_t SIZE = static_cast<size_t>(Channels) * Frames;
+        if (input.size() != SIZE || output.size() != SIZE)
+        {
+            Mix(input, output, gain);
+            return;
+        }
+
+        GUITAR_IO_PROFILE_SCOPE("AudioMixer::Mix<Channels, Frames>");
+        Mix<Channels, Frames>(input.first<SIZE>(), output.first<SIZE>(), gain);
+    }
+
+    template<uint32_t Channels, uint32_t Frames>
+    void AudioMixer::MixRampFixed(std::span<const float> input,
+        std::span<float> output,
+        float startGain,
+        float endGain,
+        uint32_t channels)
+    {
+        constexpr size_t SIZE = static_cast<size_t>(Channels) * Frames;
+        if (input.size() != SIZE || output.size() != SIZE || channels != Channels)
+        {
+            MixRamp(input, output, startGain, endGain, channels);
+            return;
+        }
+
+        GUITAR_IO_PROFILE_SCOPE("AudioMixer::MixRamp<Channels, Frames>");
+        MixRamp<Channels, Frames>(input.first<SIZE>(), output.first<SIZE>(), startGain, endGain);
+    }
+
+    template<uint32_t Channels, uint32_t Frames>
+    void AudioMixer::ApplyGainRampFixed(std::span<float> buffer, float startGain, float endGain, uint32_t channels)
+    {
+        constexpr size_t SIZE = static_cast<size_t>(Channels) * Frames;
+        if (buffer.size() != SIZE || channels != Channels)
+        {
+            ApplyGainRamp(buffer, startGain, endGain, channels);
+            return;
+        }
+
+        GUITAR_IO_PROFILE_SCOPE("AudioMixer::ApplyGainRamp<Channels, Frames>");
+        ApplyGainRamp<Channels, Frames>(buffer.first<SIZE>(), startGain, endGain);
+    }
 } // namespace GuitarIO
@@ -0,0 +1,279 @@
+#include "BlockStream.h"
+#include <algorithm>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr uint64_t SLOT_WRITING = UINT64_MAX; ///< Slot sequence while the producer overwrites it
+        constexpr uint32_t MIN_CAPACITY_BLOCKS = 2;   ///< One block being written, one readable
+    } // namespace
+
+    BlockStream::BlockStream(AsyncExecutor &executor, const BlockStreamConfig &config)
+        : executor(executor), config(config)
+    {
+        this->config.channels = std::max(1u, config.channels);
+        this->config.blockFrames = std::max(1u, config.blockFrames);
+        this->config.capacityBlocks = std::max(MIN_CAPACITY_BLOCKS, config.capacityBlocks);
+
+        blockSamples = static_cast<size_t>(this->config.blockFrames) * this->config.channels;
+        slots.assign(blockSamples * this->config.capacityBlocks, 0.0f);
+        slotSequence = std::make_unique<std::atomic<uint64_t>[]>(this->config.capacityBlocks);
+
+        dispatcher = std::thread(&BlockStream::DispatchLoop, this);
+    }
+
+    BlockStream::~BlockStream()
+    {
+        Close();
+        if (dispatcher.joinable())
+        {
+            dispatcher.join();
+        }
+    }
+
+    void BlockStream::Publish(std::span<const float> samples)
+    {
+        if (closed.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        size_t offset = 0;
+        while (offset < samples.size())
+        {
+            const uint64_t block = published.load(std::memory_order_relaxed);
+            const size_t slot = static_cast<size_t>(block % config.capacityBlocks);
+
+            // Seqlock write side: invalidate the slot before its samples change
+            if (writeOffset == 0)
+            {
+                slotSequence[slot].store(SLOT_WRITING, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+
+            const size_t count = std::min(samples.size() - offset, blockSamples - writeOffset);
+            float *destination = slots.data() + slot * blockSamples + writeOffset;
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::atomic_ref<float>(destination[i]).store(samples[offset + i], std::memory_order_relaxed);
+            }
+
+            offset += count;
+            writeOffset += count;
+            if (writeOffset < blockSamples)
+            {
+                break;
+            }
+
+            writeOffset = 0;
+            slotSequence[slot].store(block + 1, std::memory_order_release);
+            published.store(block + 1, std::memory_order_seq_cst);
+
+            // Pairs with the seq_cst increment in AddWaiter(): either the waiter sees the new block or we see it
+            if (waiterCount.load(std::memory_order_seq_cst) > 0)
+            {
+                Signal();
+            }
+        }
+    }
+
+    void BlockStream::Close()
+    {
+        {
+            std::lock_guard lock(waitersMutex);
+            if (closed.exchange(true, std::memory_order_acq_rel))
+            {
+                return;
+            }
+        }
+        Signal();
+    }
+
+    bool BlockStream::IsClosed() const
+    {
+        return closed.load(std::memory_order_acquire);
+    }
+
+    uint64_t BlockStream::GetPublishedBlocks() const
+    {
+        return published.load(std::memory_order_acquire);
+    }
+
+    const BlockStreamConfig &BlockStream::GetConfig() const
+    {
+        return config;
+    }
+
+    bool BlockStream::CopyBlock(uint64_t block, std::span<float> destination)
+    {
+        const size_t slot = static_cast<size_t>(block % config.capacityBlocks);
+        if (slotSequence[slot].load(std::memory_order_acquire) != block + 1)
+        {
+            return false;
+        }
+
+        float *source = slots.data() + slot * blockSamples;
+        for (size_t i = 0; i < blockSamples; ++i)
+        {
+            destination[i] = std::atomic_ref<float>(source[i]).load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slotSequence[slot].load(std::memory_order_relaxed) == block + 1;
+    }
+
+    bool BlockStream::AddWaiter(std::coroutine_handle<> handle, uint64_t block)
+    {
+        std::lock_guard lock(waitersMutex);
+        if (closed.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        waiterCount.fetch_add(1, std::memory_order_seq_cst);
+        if (published.load(std::memory_order_seq_cst) > block)
+        {
+            waiterCount.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        waiters.push_back(Waiter{ handle, block });
+        return true;
+    }
+
+    void BlockStream::Signal()
+    {
+        wakeSignal.fetch_add(1, std::memory_order_release);
+        wakeSignal.notify_one();
+    }
+
+    void BlockStream::DispatchLoop()
+    {
+        std::vector<std::coroutine_handle<>> ready;
+
+        while (true)
+        {
+            const uint32_t signal = wakeSignal.load(std::memory_order_acquire);
+            bool finished = false;
+            {
+                std::lock_guard lock(waitersMutex);
+                const uint64_t available = published.load(std::memory_order_acquire);
+                const bool isClosed = closed.load(std::memory_order_relaxed);
+
+                // Readers wanting an unpublished block stay parked unless the stream closed
+                const auto parked = std::partition(waiters.begin(), waiters.end(), [&](const Waiter &waiter) {
+                    return waiter.block >= available && !isClosed;
+                });
+                for (auto it = parked; it != waiters.end(); ++it)
+                {
+                    ready.push_back(it->handle);
+                }
+                waiters.erase(parked, waiters.end());
+                waiterCount.store(static_cast<uint32_t>(waiters.size()), std::memory_order_relaxed);
+                finished = isClosed;
+            }
+
+            for (std::coroutine_handle<> handle : ready)
+            {
+                executor.Schedule(handle);
+            }
+            ready.clear();
+
+            if (finished)
+            {
+                return;
+            }
+
+            wakeSignal.wait(signal, std::memory_order_acquire);
+        }
+    }
+
+    BlockStreamReader::BlockStreamReader(BlockStream &stream)
+        : stream(stream), block(stream.blockSamples), next(stream.GetPublishedBlocks())
+    {
+    }
+
+    BlockStreamReader::NextBlockAwaiter BlockStreamReader::NextBlock()
+    {
+        return NextBlockAwaiter(*this);
+    }
+
+    std::span<const float> BlockStreamReader::TryNextBlock()
+    {
+        if (!Fetch())
+        {
+            return {};
+        }
+        return block;
+    }
+
+    uint64_t BlockStreamReader::GetDroppedBlocks() const
+    {
+        return dropped;
+    }
+
+    uint64_t BlockStreamReader::GetPosition() const
+    {
+        return next;
+    }
+
+    bool BlockStreamReader::Fetch()
+    {
+        const uint64_t capacity = stream.config.capacityBlocks;
+
+        while (true)
+        {
+            const uint64_t available = stream.published.load(std::memory_order_acquire);
+            if (next >= available)
+            {
+                return false;
+            }
+
+            // The slot of block (available - capacity) is being refilled; a lagging reader jumps to the newest block
+            if (available - next >= capacity)
+            {
+                dropped += available - 1 - next;
+                next = available - 1;
+            }
+
+            if (stream.CopyBlock(next, block))
+            {
+                ++next;
+                return true;
+            }
+
+            ++dropped;
+            ++next;
+        }
+    }
+
+    bool BlockStreamReader::NextBlockAwaiter::await_ready()
+    {
+        fetched = reader.Fetch();
+        return fetched || reader.stream.IsClosed();
+    }
+
+    bool BlockStreamReader::NextBlockAwaiter::await_suspend(std::coroutine_handle<> handle)
+    {
+        while (!reader.stream.AddWaiter(handle, reader.next))
+        {
+            fetched = reader.Fetch();
+            if (fetched || reader.stream.IsClosed())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::span<const float> BlockStreamReader::NextBlockAwaiter::await_resume()
+    {
+        if (!fetched && !reader.Fetch())
+        {
+            return {};
+        }
+        return reader.block;
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,229 @@
+#include "BlockingAudioStream.h"
+#include <algorithm>
+
+namespace GuitarIO
+{
+    BlockingAudioStream::BlockingAudioStream(AudioDevice &device, const BlockingStreamConfig &config)
+        : device(device), config(config)
+    {
+    }
+
+    BlockingAudioStream::~BlockingAudioStream()
+    {
+        Close();
+    }
+
+    bool BlockingAudioStream::Open(uint32_t deviceId, const AudioStreamConfig &streamConfig)
+    {
+        Prepare(streamConfig);
+        const auto callback = [this](std::span<const float> in, std::span<float> out, void *) {
+            return Process(in, out);
+        };
+        if (!device.Open(deviceId, streamConfig, callback))
+        {
+            lastError = device.GetLastError();
+            return false;
+        }
+        return true;
+    }
+
+    bool BlockingAudioStream::OpenDefault(const AudioStreamConfig &streamConfig)
+    {
+        Prepare(streamConfig);
+        const auto callback = [this](std::span<const float> in, std::span<float> out, void *) {
+            return Process(in, out);
+        };
+        if (!device.OpenDefault(streamConfig, callback))
+        {
+            lastError = device.GetLastError();
+            return false;
+        }
+        return true;
+    }
+
+    bool BlockingAudioStream::Start()
+    {
+        running.store(true, std::memory_order_release);
+        if (!device.Start())
+        {
+            running.store(false, std::memory_order_release);
+            lastError = device.GetLastError();
+            return false;
+        }
+        return true;
+    }
+
+    bool BlockingAudioStream::Stop()
+    {
+        running.store(false, std::memory_order_release);
+        WakeAll();
+
+        if (device.IsRunning() && !device.Stop())
+        {
+            lastError = device.GetLastError();
+            return false;
+        }
+        return true;
+    }
+
+    void BlockingAudioStream::Close()
+    {
+        Stop();
+        device.Close();
+    }
+
+    template<typename ReadyFn>
+    void BlockingAudioStream::Park(size_t want,
+        ReadyFn ready,
+        std::atomic<size_t> &wantSlot,
+        std::atomic<uint32_t> &signal)
+    {
+        const uint32_t observed = signal.load(std::memory_order_acquire);
+
+        // Publish the demand before re-checking the FIFO; pairs with the fence in Process()
+        wantSlot.store(want, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (ready() < want && running.load(std::memory_order_acquire))
+        {
+            signal.wait(observed, std::memory_order_acquire);
+        }
+        wantSlot.store(0, std::memory_order_relaxed);
+    }
+
+    size_t BlockingAudioStream::Read(std::span<float> samples)
+    {
+        const size_t batch = std::max<size_t>(1, static_cast<size_t>(wakeupFrames) * inputChannels);
+
+        size_t done = 0;
+        while (true)
+        {
+            done += input.Read(samples.subspan(done));
+            if (done == samples.size() || !running.load(std::memory_order_acquire))
+            {
+                return done;
+            }
+
+            const auto readable = [this] { return input.GetReadAvailable(); };
+            Park(std::min(samples.size() - done, batch), readable, readerWant, readerSignal);
+        }
+    }
+
+    size_t BlockingAudioStream::Write(std::span<const float> samples)
+    {
+        const size_t batch = std::max<size_t>(1, static_cast<size_t>(wakeupFrames) * outputChannels);
+
+        size_t done = 0;
+        while (true)
+        {
+            done += output.Write(samples.subspan(done));
+            if (done == samples.size() || !running.load(std::memory_order_acquire))
+            {
+                return done;
+            }
+
+            const auto writable = [this] { return output.GetWriteAvailable(); };
+            Park(std::min(samples.size() - done, batch), writable, writerWant, writerSignal);
+        }
+    }
+
+    size_t BlockingAudioStream::GetReadAvailable() const
+    {
+        return inputChannels > 0 ? input.GetReadAvailable() / inputChannels : 0;
+    }
+
+    size_t BlockingAudioStream::GetWriteAvailable() const
+    {
+        return outputChannels > 0 ? output.GetWriteAvailable() / outputChannels : 0;
+    }
+
+    uint64_t BlockingAudioStream::GetInputOverflows() const
+    {
+        return inputOverflows.load(std::memory_order_relaxed);
+    }
+
+    uint64_t BlockingAudioStream::GetOutputUnderflows() const
+    {
+        return outputUnderflows.load(std::memory_order_relaxed);
+    }
+
+    uint64_t BlockingAudioStream::GetWakeups() const
+    {
+        return wakeups.load(std::memory_order_relaxed);
+    }
+
+    std::string BlockingAudioStream::GetLastError() const
+    {
+        return lastError;
+    }
+
+    void BlockingAudioStream::Prepare(const AudioStreamConfig &streamConfig)
+    {
+        inputChannels = streamConfig.inputChannels;
+        outputChannels = streamConfig.outputChannels;
+
+        const uint32_t fifoFrames = std::max(config.fifoFrames, streamConfig.bufferSize);
+        input.Resize(static_cast<size_t>(fifoFrames) * inputChannels);
+        output.Resize(static_cast<size_t>(fifoFrames) * outputChannels);
+
+        // A batch larger than the FIFO could never become ready
+        wakeupFrames = config.wakeupFrames > 0 ? config.wakeupFrames : streamConfig.bufferSize;
+        wakeupFrames = std::clamp(wakeupFrames, 1u, fifoFrames);
+    }
+
+    int BlockingAudioStream::Process(std::span<const float> in, std::span<float> out)
+    {
+        if (!in.empty() && inputChannels > 0)
+        {
+            // Whole frames only, so a dropped tail never shifts the channel interleaving
+            const size_t room = input.GetWriteAvailable() / inputChannels * inputChannels;
+            const size_t count = std::min(in.size(), room);
+            input.Write(in.first(count));
+            if (count < in.size())
+            {
+                inputOverflows.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            WakeIfReady(readerWant, input.GetReadAvailable(), readerSignal);
+        }
+
+        if (!out.empty() && outputChannels > 0)
+        {
+            const size_t queued = output.GetReadAvailable() / outputChannels * outputChannels;
+            const size_t count = output.Read(out.first(std::min(out.size(), queued)));
+            if (count < out.size())
+            {
+                std::fill(out.begin() + static_cast<std::ptrdiff_t>(count), out.end(), 0.0f);
+                outputUnderflows.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            WakeIfReady(writerWant, output.GetWriteAvailable(), writerSignal);
+        }
+
+        return 0;
+    }
+
+    void BlockingAudioStream::WakeIfReady(std::atomic<size_t> &want, size_t ready, std::atomic<uint32_t> &signal)
+    {
+        size_t needed = want.load(std::memory_order_relaxed);
+        if (needed == 0 || ready < needed || !want.compare_exchange_strong(needed, 0, std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        signal.fetch_add(1, std::memory_order_release);
+        signal.notify_one();
+        wakeups.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void BlockingAudioStream::WakeAll()
+    {
+        readerSignal.fetch_add(1, std::memory_order_release);
+        readerSignal.notify_all();
+        writerSignal.fetch_add(1, std::memory_order_release);
+        writerSignal.notify_all();
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,285 @@
+#include "CallbackRecorder.h"
+#include "MemoryAccounting.h"
+#include <array>
+#include <vector>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr size_t WRITER_CHUNK_BYTES = 64 * 1024; ///< Bytes moved to disk per write call
+        constexpr auto WRITER_IDLE_SLEEP = std::chrono::milliseconds(2);
+
+        /**
+         * @brief Appends a trivially copyable value to a record header
+         * @param head Destination header
+         * @param offset Write position, advanced past the value
+         * @param value Value to append
+         */
+        template<typename T, size_t N> void Put(std::array<uint8_t, N> &head, size_t &offset, const T &value)
+        {
+            std::memcpy(head.data() + offset, &value, sizeof(T));
+            offset += sizeof(T);
+        }
+
+        /**
+         * @brief Marks an audio-thread hook as running for its scope, so Stop() can wait for it
+         */
+        class HookScope
+        {
+        public:
+            explicit HookScope(std::atomic<uint32_t> &active) : active(active)
+            {
+                active.fetch_add(1);
+            }
+
+            ~HookScope()
+            {
+                active.fetch_sub(1, std::memory_order_release);
+            }
+
+            HookScope(const HookScope &) = delete;
+
+            HookScope &operator=(const HookScope &) = delete;
+
+        private:
+            std::atomic<uint32_t> &active; ///< Recorder's running hook count
+        };
+    } // namespace
+
+    CallbackRecorder::CallbackRecorder(const CallbackRecorderConfig &config) : config(config)
+    {
+    }
+
+    CallbackRecorder::~CallbackRecorder()
+    {
+        Stop();
+    }
+
+    bool CallbackRecorder::Start(const std::string &path, const AudioStreamConfig &streamConfig)
+    {
+        if (writerRunning.load())
+        {
+            lastError = "Recorder already running";
+            return false;
+        }
+
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            lastError = "Failed to create trace file: " + path;
+            return false;
+        }
+
+        TraceHeader header;
+        header.sampleRate = streamConfig.sampleRate;
+        header.bufferSize = streamConfig.bufferSize;
+        header.inputChannels = streamConfig.inputChannels;
+        header.outputChannels = streamConfig.outputChannels;
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        // Stop() left no hook running, and hooks started since see recording == false and leave
+        // the ring alone, so resizing it here cannot race with the audio thread
+        ring.Resize(config.bufferBytes);
+        recordedBlocks.store(0);
+        droppedRecords.store(0);
+        lastBlockDropped = false;
+        gapBlocks = 0;
+        gapParameters = 0;
+        gapFrames = 0;
+        startTime = std::chrono::steady_clock::now();
+
+        writerRunning.store(true);
+        writer = std::thread(&CallbackRecorder::WriterLoop, this);
+        recording.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void CallbackRecorder::Stop()
+    {
+        // Sequentially consistent with the hooks' increment-then-check: once the count reads zero,
+        // every later hook sees recording == false
+        recording.store(false);
+        while (activeHooks.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+
+        // Drops at the very end still get their gap record; the writer frees space as it drains
+        while (writerRunning.load() && (gapBlocks != 0 || gapParameters != 0)
+            && !ring.WriteAll({ std::span<const uint8_t>(MakeGap()) }))
+        {
+            std::this_thread::sleep_for(WRITER_IDLE_SLEEP);
+        }
+        gapBlocks = 0;
+        gapParameters = 0;
+        gapFrames = 0;
+
+        writerRunning.store(false);
+        if (writer.joinable())
+        {
+            writer.join();
+        }
+
+        if (file.is_open())
+        {
+            file.close();
+        }
+    }
+
+    bool CallbackRecorder::IsRecording() const
+    {
+        return recording.load(std::memory_order_acquire);
+    }
+
+    void CallbackRecorder::RecordBlock(std::span<const float> input,
+        uint32_t frames,
+        double streamTime,
+        uint32_t status)
+    {
+        HookScope scope(activeHooks);
+        if (!recording.load())
+        {
+            return;
+        }
+
+        std::array<uint8_t, CallbackTrace::BLOCK_HEADER_SIZE> head{};
+        size_t offset = 0;
+        Put(head, offset, CallbackTrace::RECORD_BLOCK);
+        Put(head, offset, frames);
+        Put(head, offset, static_cast<uint32_t>(input.size()));
+        Put(head, offset, status);
+        Put(head, offset, streamTime);
+        Put(head, offset, Timestamp());
+
+        lastBlockDropped = !Push(head, input);
+        if (lastBlockDropped)
+        {
+            ++gapBlocks;
+            gapFrames += frames;
+        }
+        else
+        {
+            recordedBlocks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void CallbackRecorder::RecordOutput(std::span<const float> output)
+    {
+        HookScope scope(activeHooks);
+        if (!recording.load() || !config.recordOutputChecksums || lastBlockDropped)
+        {
+            return;
+        }
+
+        std::array<uint8_t, CallbackTrace::CHECKSUM_SIZE> head{};
+        size_t offset = 0;
+        Put(head, offset, CallbackTrace::RECORD_OUTPUT_CHECKSUM);
+        Put(head, offset, CallbackTrace::Checksum(output));
+        Push(head);
+    }
+
+    void CallbackRecorder::RecordParameter(uint32_t id, float value)
+    {
+        HookScope scope(activeHooks);
+        if (!recording.load())
+        {
+            return;
+        }
+
+        std::array<uint8_t, CallbackTrace::PARAMETER_SIZE> head{};
+        size_t offset = 0;
+        Put(head, offset, CallbackTrace::RECORD_PARAMETER);
+        Put(head, offset, id);
+        Put(head, offset, value);
+        Put(head, offset, Timestamp());
+        if (!Push(head))
+        {
+            ++gapParameters;
+        }
+    }
+
+    uint64_t CallbackRecorder::GetRecordedBlocks() const
+    {
+        return recordedBlocks.load(std::memory_order_relaxed);
+    }
+
+    uint64_t CallbackRecorder::GetDroppedRecords() const
+    {
+        return droppedRecords.load(std::memory_order_relaxed);
+    }
+
+    size_t CallbackRecorder::GetBacklogBytes() const
+    {
+        return ring.GetReadAvailable();
+    }
+
+    std::string CallbackRecorder::GetLastError() const
+    {
+        return lastError;
+    }
+
+    bool CallbackRecorder::Push(std::span<const uint8_t> head, std::span<const float> payload)
+    {
+        const std::span<const uint8_t> payloadBytes(reinterpret_cast<const uint8_t *>(payload.data()),
+            payload.size_bytes());
+        const bool gap = gapBlocks != 0 || gapParameters != 0;
+        const std::array<uint8_t, CallbackTrace::GAP_SIZE> gapRecord = MakeGap();
+        const std::span<const uint8_t> gapBytes(gapRecord.data(), gap ? gapRecord.size() : 0);
+
+        if (!ring.WriteAll({ gapBytes, head, payloadBytes }))
+        {
+            droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        gapBlocks = 0;
+        gapParameters = 0;
+        gapFrames = 0;
+        return true;
+    }
+
+    std::array<uint8_t, CallbackTrace::GAP_SIZE> CallbackRecorder::MakeGap() const
+    {
+        std::array<uint8_t, CallbackTrace::GAP_SIZE> gap{};
+        size_t offset = 0;
+        Put(gap, offset, CallbackTrace::RECORD_GAP);
+        Put(gap, offset, gapBlocks);
+        Put(gap, offset, gapParameters);
+        Put(gap, offset, gapFrames);
+        return gap;
+    }
+
+    uint64_t CallbackRecorder::Timestamp() const
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - startTime;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    void CallbackRecorder::WriterLoop()
+    {
+        TaggedVector<uint8_t> chunk(WRITER_CHUNK_BYTES);
+
+        while (true)
+        {
+            // Read the flag before draining so records pushed before Stop() are never lost
+            const bool keepRunning = writerRunning.load();
+            const size_t count = ring.Read(chunk);
+            if (count > 0)
+            {
+                file.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(count));
+                continue;
+            }
+
+            if (!keepRunning)
+            {
+                break;
+            }
+
+            std::this_thread::sleep_for(WRITER_IDLE_SLEEP);
+        }
+
+        file.flush();
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,267 @@
+#include "Compressor.h"
+#include "AudioMixer.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr float MAX_REDUCTION_DB = 96.0f;
+        constexpr float LEVEL_FLOOR = 1e-10f; // -200 dB, keeps Log2 away from zero and denormals
+
+        float PeriodCoefficient(float milliseconds, double sampleRate)
+        {
+            const double periodFrames = milliseconds * 0.001 * sampleRate;
+            const double periods = static_cast<double>(Compressor::CONTROL_INTERVAL) / periodFrames;
+            return periodFrames > 0.0 ? static_cast<float>(std::exp(-periods)) : 0.0f;
+        }
+    } // namespace
+
+    Compressor::Compressor(const CompressorSettings &settings) : settings(settings)
+    {
+    }
+
+    bool Compressor::Prepare(const ProcessSpec &spec)
+    {
+        if (spec.sampleRate <= 0.0 || spec.channels == 0)
+        {
+            lastError = "Invalid stream format";
+            return false;
+        }
+
+        channels = spec.channels;
+        levels.assign(channels, 0.0f);
+        reductions.assign(channels, 0.0f);
+        gains.assign(channels, 1.0f);
+        SetSampleRate(spec.sampleRate);
+        Reset();
+        return true;
+    }
+
+    void Compressor::SetSampleRate(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        PublishCoefficients();
+    }
+
+    void Compressor::Process(std::span<float> buffer, uint32_t bufferChannels)
+    {
+        if (bufferChannels != channels || channels == 0)
+        {
+            return;
+        }
+
+        ProcessKeyed(buffer, buffer, channels);
+    }
+
+    void Compressor::Process(std::span<float> buffer,
+        uint32_t bufferChannels,
+        std::span<const float> sidechain,
+        uint32_t sidechainChannels)
+    {
+        if (bufferChannels != channels || channels == 0)
+        {
+            return;
+        }
+
+        const size_t frames = buffer.size() / channels;
+        if (sidechainChannels == 0 || sidechain.size() < frames * sidechainChannels)
+        {
+            ProcessKeyed(buffer, buffer, channels);
+            return;
+        }
+
+        ProcessKeyed(buffer, sidechain, sidechainChannels);
+    }
+
+    void Compressor::Reset()
+    {
+        // Acquire rather than Get: straight after Prepare() nothing has been acquired yet
+        const float makeup = FastMath::DbToAmplitude(coefficients.Acquire().makeup);
+        std::ranges::fill(reductions, 0.0f);
+        std::ranges::fill(gains, makeup);
+        gainReductionDb.store(0.0f, std::memory_order_relaxed);
+    }
+
+    uint32_t Compressor::GetTailFrames() const
+    {
+        return 0;
+    }
+
+    void Compressor::SetSettings(const CompressorSettings &newSettings)
+    {
+        settings = newSettings;
+        PublishCoefficients();
+    }
+
+    CompressorSettings Compressor::GetSettings() const
+    {
+        return settings;
+    }
+
+    float Compressor::GetGainReductionDb() const
+    {
+        return gainReductionDb.load(std::memory_order_relaxed);
+    }
+
+    std::string Compressor::GetLastError() const
+    {
+        return lastError;
+    }
+
+    void Compressor::PublishCoefficients()
+    {
+        if (sampleRate <= 0.0)
+        {
+            return;
+        }
+
+        Coefficients next;
+        next.threshold = settings.thresholdDb;
+        next.slope = 1.0f / std::max(settings.ratio, 1.0f) - 1.0f;
+        next.knee = std::max(settings.kneeDb, 0.0f);
+        next.expanderThreshold = settings.expanderThresholdDb;
+        next.expanderSlope = std::max(settings.expanderRatio, 1.0f) - 1.0f;
+        next.attack = PeriodCoefficient(settings.attackMs, sampleRate);
+        next.release = PeriodCoefficient(settings.releaseMs, sampleRate);
+        next.makeup = settings.makeupDb;
+        next.detector = settings.detector;
+        next.link = settings.link;
+        coefficients.Publish(next);
+    }
+
+    void Compressor::Detect(std::span<const float> key, uint32_t keyChannels, bool linked, DetectorMode detector)
+    {
+        const size_t frames = key.size() / keyChannels;
+        const bool peak = detector == DetectorMode::Peak;
+
+        // Linked detection is one reduction over the contiguous period, independent one per key channel
+        if (linked)
+        {
+            float level = 0.0f;
+            if (peak)
+            {
+                for (const float sample : key)
+                {
+                    level = std::max(level, std::fabs(sample));
+                }
+            }
+            else
+            {
+                for (const float sample : key)
+                {
+                    level += sample * sample;
+                }
+                level /= static_cast<float>(key.size());
+            }
+            levels[0] = level;
+        }
+        else
+        {
+            const uint32_t used = std::min(keyChannels, channels);
+            std::fill_n(levels.begin(), used, 0.0f);
+            for (size_t i = 0; i < frames; ++i)
+            {
+                const float *frame = key.data() + i * keyChannels;
+                for (uint32_t k = 0; k < used; ++k)
+                {
+                    levels[k] = peak ? std::max(levels[k], std::fabs(frame[k])) : levels[k] + frame[k] * frame[k];
+                }
+            }
+            if (!peak)
+            {
+                const float scale = 1.0f / static_cast<float>(frames);
+                for (uint32_t k = 0; k < used; ++k)
+                {
+                    levels[k] *= scale;
+                }
+            }
+        }
+
+        // Mean squares take half the log to become RMS levels
+        const float dbScale = peak ? FastMath::DB_PER_LOG2 : 0.5f * FastMath::DB_PER_LOG2;
+        const uint32_t count = linked ? 1 : std::min(keyChannels, channels);
+        for (uint32_t k = 0; k < count; ++k)
+        {
+            levels[k] = dbScale * FastMath::Log2(std::max(levels[k], LEVEL_FLOOR));
+        }
+    }
+
+    void Compressor::ProcessKeyed(std::span<float> buffer, std::span<const float> key, uint32_t keyChannels)
+    {
+        const Coefficients &current = coefficients.Acquire();
+        const bool linked = current.link == ChannelLink::Linked;
+        const uint32_t gainChannels = linked ? 1 : channels;
+        const size_t frames = buffer.size() / channels;
+        float deepest = 0.0f;
+
+        for (size_t offset = 0; offset < frames; offset += CONTROL_INTERVAL)
+        {
+            const auto count = static_cast<uint32_t>(std::min<size_t>(CONTROL_INTERVAL, frames - offset));
+            Detect(key.subspan(offset * keyChannels, static_cast<size_t>(count) * keyChannels),
+                keyChannels,
+                linked,
+                current.detector);
+
+            // A short period at the block tail smooths by its share of a full period, which keeps
+            // the attack and release times independent of the host block size
+            float attack = current.attack;
+            float release = current.release;
+            if (count < CONTROL_INTERVAL)
+            {
+                const float share = static_cast<float>(count) / static_cast<float>(CONTROL_INTERVAL);
+                attack = std::pow(attack, share);
+                release = std::pow(release, share);
+            }
+
+            // Gain computer in dB: soft-knee compression above the threshold, expansion below its own
+            for (uint32_t g = 0; g < gainChannels; ++g)
+            {
+                const float level = levels[linked ? 0 : g % keyChannels];
+                const float over = level - current.threshold;
+                float target = 0.0f;
+                if (2.0f * over >= current.knee)
+                {
+                    target = current.slope * over;
+                }
+                else if (2.0f * over > -current.knee)
+                {
+                    const float into = over + 0.5f * current.knee;
+                    target = current.slope * into * into / (2.0f * current.knee);
+                }
+                target -= current.expanderSlope * std::max(current.expanderThreshold - level, 0.0f);
+                target = std::max(target, -MAX_REDUCTION_DB);
+
+                const float coefficient = target < reductions[g] ? attack : release;
+                reductions[g] = target + coefficient * (reductions[g] - target);
+                deepest = std::min(deepest, reductions[g]);
+            }
+
+            const std::span<float> block = buffer.subspan(offset * channels, static_cast<size_t>(count) * channels);
+            if (linked)
+            {
+                const float gain = FastMath::DbToAmplitude(reductions[0] + current.makeup);
+                AudioMixer::ApplyGainRamp(block, gains[0], gain, channels);
+                gains[0] = gain;
+                continue;
+            }
+
+            const float step = 1.0f / static_cast<float>(count);
+            for (uint32_t g = 0; g < channels; ++g)
+            {
+                const float gain = FastMath::DbToAmplitude(reductions[g] + current.makeup);
+                const float slope = (gain - gains[g]) * step;
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    block[i * channels + g] *= gains[g] + slope * static_cast<float>(i);
+                }
+                gains[g] = gain;
+            }
+        }
+
+        gainReductionDb.store(deepest, std::memory_order_relaxed);
+    }
+
+} // namespace GuitarIO
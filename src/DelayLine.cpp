@@ -0,0 +1,224 @@
+#include "DelayLine.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr uint32_t WINDOW_FRAMES = 4;          // Widest interpolation window (Lagrange)
+        constexpr uint64_t MAX_CAPACITY = 1ULL << 30; // Keeps positions well inside int32/float range
+
+        // Clamps to non-negative bounds with integer min/max on the bit patterns (non-negative floats
+        // order like their bits, negative ones below all of them), so the position loops vectorize:
+        // std::clamp returns a reference and float min/max defeats if-conversion under trapping math
+        float ClampDelay(float delay, float lowest, float longest)
+        {
+            const int32_t bits = std::max(std::bit_cast<int32_t>(delay), std::bit_cast<int32_t>(lowest));
+            return std::bit_cast<float>(std::min(bits, std::bit_cast<int32_t>(longest)));
+        }
+    } // namespace
+
+    bool DelayLine::Prepare(uint32_t maxDelayFrames, uint32_t maxBlockFrames)
+    {
+        const uint64_t required = static_cast<uint64_t>(maxDelayFrames) + maxBlockFrames + WINDOW_FRAMES;
+        if (maxBlockFrames == 0 || required > MAX_CAPACITY)
+        {
+            return false;
+        }
+
+        capacity = static_cast<uint32_t>(std::bit_ceil(required));
+        mask = capacity - 1;
+        mirror = maxBlockFrames + WINDOW_FRAMES;
+        maxDelay = maxDelayFrames;
+        maxBlock = maxBlockFrames;
+        writePosition = 0;
+
+        data.assign(static_cast<size_t>(capacity) + mirror, 0.0f);
+        indices.assign(maxBlock, 0);
+        fractions.assign(maxBlock, 0.0f);
+        points.assign(static_cast<size_t>(WINDOW_FRAMES) * maxBlock, 0.0f);
+        return true;
+    }
+
+    void DelayLine::Reset()
+    {
+        std::ranges::fill(data, 0.0f);
+        writePosition = 0;
+    }
+
+    void DelayLine::Write(std::span<const float> input)
+    {
+        const uint32_t count = static_cast<uint32_t>(std::min<size_t>(input.size(), maxBlock));
+        const uint32_t start = writePosition & mask;
+        const uint32_t first = std::min(count, capacity - start);
+
+        std::copy_n(input.begin(), first, data.begin() + start);
+        std::copy_n(input.begin() + first, count - first, data.begin());
+
+        // Keep the tail past the ring identical to its head so windows starting near the end stay contiguous
+        if (start < mirror)
+        {
+            const uint32_t end = std::min(start + first, mirror);
+            std::copy(data.begin() + start, data.begin() + end, data.begin() + capacity + start);
+        }
+        if (count > first)
+        {
+            std::copy_n(data.begin(), std::min(count - first, mirror), data.begin() + capacity);
+        }
+
+        writePosition += count;
+    }
+
+    void DelayLine::ReadFixed(float delay, std::span<float> output) const
+    {
+        const uint32_t count = static_cast<uint32_t>(std::min<size_t>(output.size(), maxBlock));
+        const float clamped = std::clamp(delay, 0.0f, static_cast<float>(maxDelay));
+        const auto whole = static_cast<uint32_t>(clamped);
+        const float fraction = clamped - static_cast<float>(whole);
+        const float complement = 1.0f - fraction;
+
+        // window[i + 1] is the sample whole frames before output i, window[i] the one before that
+        const float *window = data.data() + ((writePosition - count - whole - 1) & mask);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            output[i] = fraction * window[i] + complement * window[i + 1];
+        }
+    }
+
+    void DelayLine::ReadLinear(std::span<const float> delays, std::span<float> output)
+    {
+        const size_t count = std::min({ delays.size(), output.size(), static_cast<size_t>(maxBlock) });
+        ComputePositions(delays.first(count), 0.0f, 0);
+        GatherWindows(count, 2);
+
+        const float *p0 = points.data();
+        const float *p1 = p0 + maxBlock;
+        const float *fraction = fractions.data();
+        float *out = output.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = p0[i] + fraction[i] * (p1[i] - p0[i]);
+        }
+    }
+
+    void DelayLine::ReadLagrange(std::span<const float> delays, std::span<float> output)
+    {
+        const size_t count = std::min({ delays.size(), output.size(), static_cast<size_t>(maxBlock) });
+        ComputePositions(delays.first(count), 1.0f, -1);
+        GatherWindows(count, 4);
+
+        const float *p0 = points.data();
+        const float *p1 = p0 + maxBlock;
+        const float *p2 = p1 + maxBlock;
+        const float *p3 = p2 + maxBlock;
+        const float *fraction = fractions.data();
+        float *out = output.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Third-order Lagrange weights for points at -1, 0, 1, 2 around the fractional position
+            const float f = fraction[i];
+            const float fPlus = f + 1.0f;
+            const float fMinus = f - 1.0f;
+            const float fMinus2 = f - 2.0f;
+            const float half = 0.5f * fPlus * fMinus2;
+            const float sixth = (1.0f / 6.0f) * f * fMinus;
+            out[i] = -sixth * fMinus2 * p0[i] + half * fMinus * p1[i] - half * f * p2[i] + sixth * fPlus * p3[i];
+        }
+    }
+
+    void DelayLine::ReadAllpass(std::span<const float> delays, std::span<float> output, float &state)
+    {
+        const auto count =
+            static_cast<uint32_t>(std::min({ delays.size(), output.size(), static_cast<size_t>(maxBlock) }));
+        const uint32_t base = writePosition - count - 1;
+        const float longest = static_cast<float>(maxDelay);
+
+        // Split each delay into whole frames M and an allpass delay in [0.5, 1.5), where the
+        // first-order allpass has its flattest phase delay; fractions[] holds the coefficient.
+        // delay - 0.5 is positive, so truncation is the floor
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const float delay = ClampDelay(delays[i], 1.0f, longest);
+            const auto whole = static_cast<int32_t>(delay - 0.5f);
+            const float fraction = delay - static_cast<float>(whole);
+            indices[i] = (base + i - static_cast<uint32_t>(whole)) & mask;
+            fractions[i] = (1.0f - fraction) / (1.0f + fraction);
+        }
+        GatherWindows(count, 2);
+
+        const float *p0 = points.data();
+        const float *p1 = p0 + maxBlock;
+        float previous = state;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            previous = fractions[i] * (p1[i] - previous) + p0[i];
+            output[i] = previous;
+        }
+        state = previous;
+    }
+
+    void DelayLine::Read(std::span<const float> delays,
+        std::span<float> output,
+        DelayInterpolation interpolation,
+        float &allpassState)
+    {
+        switch (interpolation)
+        {
+        case DelayInterpolation::Linear:
+            ReadLinear(delays, output);
+            break;
+        case DelayInterpolation::Lagrange:
+            ReadLagrange(delays, output);
+            break;
+        case DelayInterpolation::Allpass:
+            ReadAllpass(delays, output, allpassState);
+            break;
+        }
+    }
+
+    uint32_t DelayLine::GetMaxDelayFrames() const
+    {
+        return maxDelay;
+    }
+
+    uint32_t DelayLine::GetCapacity() const
+    {
+        return capacity;
+    }
+
+    void DelayLine::ComputePositions(std::span<const float> delays, float minDelay, int32_t windowStart)
+    {
+        const auto count = static_cast<uint32_t>(delays.size());
+        const uint32_t base = writePosition - count + static_cast<uint32_t>(windowStart) - 1;
+        const float longest = static_cast<float>(maxDelay);
+
+        // Position i - delay is split as (i - whole - 1) + fraction with fraction in (0, 1]: the
+        // clamped delay is non-negative, so truncation gives its floor without std::floor (which
+        // has no vector form before SSE4.1). Integer delays land on fraction 1, the same sample
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const float delay = ClampDelay(delays[i], minDelay, longest);
+            const auto whole = static_cast<int32_t>(delay);
+            indices[i] = (base + i - static_cast<uint32_t>(whole)) & mask;
+            fractions[i] = 1.0f - (delay - static_cast<float>(whole));
+        }
+    }
+
+    void DelayLine::GatherWindows(size_t count, uint32_t width)
+    {
+        const float *ring = data.data();
+        const uint32_t *index = indices.data();
+        for (uint32_t point = 0; point < width; ++point)
+        {
+            float *destination = points.data() + static_cast<size_t>(point) * maxBlock;
+            const float *source = ring + point;
+            for (size_t i = 0; i < count; ++i)
+            {
+                destination[i] = source[index[i]];
+            }
+        }
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,287 @@
+#include "FdnReverb.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr uint32_t PRIME_HEADROOM = 256; // Room for rounding line lengths up to distinct primes
+        constexpr float MIN_DECAY_SECONDS = 0.05f;
+        constexpr float DENORMAL_GUARD = 1e-18f; // Inaudible bias that keeps decaying tails out of denormals
+
+        // Sign patterns for injecting the input and tapping the two output mixes; the output rows
+        // are orthogonal so even and odd channels are decorrelated
+        constexpr std::array<float, 16> INPUT_SIGNS = { 1, -1, -1, 1, -1, 1, 1, 1, -1, -1, 1, -1, 1, 1, -1, -1 };
+        constexpr std::array<float, 16> LEFT_SIGNS = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+        constexpr std::array<float, 16> RIGHT_SIGNS = { 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1 };
+
+        bool IsPrime(uint32_t value)
+        {
+            if (value < 2)
+            {
+                return false;
+            }
+            for (uint32_t divisor = 2; divisor * divisor <= value; ++divisor)
+            {
+                if (value % divisor == 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // In-place unnormalized Walsh-Hadamard transform of one frame
+        template<size_t N> void Hadamard(float *v)
+        {
+            for (size_t half = 1; half < N; half *= 2)
+            {
+                for (size_t start = 0; start < N; start += 2 * half)
+                {
+                    for (size_t i = start; i < start + half; ++i)
+                    {
+                        const float a = v[i];
+                        const float b = v[i + half];
+                        v[i] = a + b;
+                        v[i + half] = a - b;
+                    }
+                }
+            }
+        }
+
+        // In-place Householder reflection (I - 2/N * ones) of one frame
+        template<size_t N> void Householder(float *v)
+        {
+            float sum = 0.0f;
+            for (size_t i = 0; i < N; ++i)
+            {
+                sum += v[i];
+            }
+
+            const float reflection = sum * (2.0f / static_cast<float>(N));
+            for (size_t i = 0; i < N; ++i)
+            {
+                v[i] -= reflection;
+            }
+        }
+    } // namespace
+
+    template<size_t Lines>
+    FdnReverb<Lines>::FdnReverb(const FdnReverbConfig &config)
+        : mix(std::clamp(config.mix, 0.0f, 1.0f)), config(config)
+    {
+    }
+
+    template<size_t Lines> bool FdnReverb<Lines>::Prepare(const ProcessSpec &spec)
+    {
+        maxSampleRate = spec.GetMaxSampleRate();
+        if (maxSampleRate <= 0.0 || spec.channels == 0 || config.sizeMs <= 0.0f || config.spread <= 0.0f
+            || config.spread > 1.0f)
+        {
+            lastError = "Invalid stream format or reverb size";
+            return false;
+        }
+
+        const auto maxDelayFrames =
+            static_cast<uint32_t>(std::ceil(config.sizeMs * 0.001 * maxSampleRate)) + PRIME_HEADROOM;
+        for (DelayLine &line : lines)
+        {
+            if (!line.Prepare(maxDelayFrames, MAX_CHUNK_FRAMES))
+            {
+                lastError = "Reverb too large: " + std::to_string(config.sizeMs) + " ms";
+                return false;
+            }
+        }
+
+        lineBlocks.assign(Lines * MAX_CHUNK_FRAMES, 0.0f);
+        lanes.assign(Lines * MAX_CHUNK_FRAMES, 0.0f);
+        input.assign(MAX_CHUNK_FRAMES, 0.0f);
+        for (size_t line = 0; line < Lines; ++line)
+        {
+            writeBlocks[line] = std::span<float>(lineBlocks).subspan(line * MAX_CHUNK_FRAMES, MAX_CHUNK_FRAMES);
+            readBlocks[line] = writeBlocks[line];
+        }
+
+        channels = spec.channels;
+        SetSampleRate(spec.sampleRate);
+        Reset();
+        return true;
+    }
+
+    template<size_t Lines> void FdnReverb<Lines>::SetSampleRate(double newSampleRate)
+    {
+        sampleRate = std::min(newSampleRate, maxSampleRate);
+        PublishCoefficients();
+    }
+
+    template<size_t Lines> void FdnReverb<Lines>::Process(std::span<float> buffer, uint32_t bufferChannels)
+    {
+        if (bufferChannels != channels || channels == 0)
+        {
+            return;
+        }
+
+        const Coefficients &current = coefficients.Acquire();
+        const float currentMix = mix.load(std::memory_order_relaxed);
+        const size_t chunkSamples = static_cast<size_t>(current.chunkFrames) * channels;
+
+        for (size_t offset = 0; offset < buffer.size(); offset += chunkSamples)
+        {
+            ProcessChunk(buffer.subspan(offset, std::min(chunkSamples, buffer.size() - offset)), current, currentMix);
+        }
+    }
+
+    template<size_t Lines> void FdnReverb<Lines>::Reset()
+    {
+        for (DelayLine &line : lines)
+        {
+            line.Reset();
+        }
+        dampingState = {};
+    }
+
+    template<size_t Lines> uint32_t FdnReverb<Lines>::GetTailFrames() const
+    {
+        return coefficients.Get().tailFrames;
+    }
+
+    template<size_t Lines> void FdnReverb<Lines>::SetDecay(float seconds)
+    {
+        config.decaySeconds = seconds;
+        PublishCoefficients();
+    }
+
+    template<size_t Lines> void FdnReverb<Lines>::SetDamping(float hz)
+    {
+        config.dampingHz = hz;
+        PublishCoefficients();
+    }
+
+    template<size_t Lines> void FdnReverb<Lines>::SetMix(float newMix)
+    {
+        mix.store(std::clamp(newMix, 0.0f, 1.0f), std::memory_order_relaxed);
+    }
+
+    template<size_t Lines> std::string FdnReverb<Lines>::GetLastError() const
+    {
+        return lastError;
+    }
+
+    template<size_t Lines> void FdnReverb<Lines>::PublishCoefficients()
+    {
+        if (sampleRate <= 0.0)
+        {
+            return;
+        }
+
+        Coefficients next;
+        next.sampleRate = sampleRate;
+
+        // Exponentially spaced lengths rounded up to distinct primes, so no two lines share echoes
+        const uint32_t longest = lines[0].GetMaxDelayFrames();
+        const double decayFrames = std::max(config.decaySeconds, MIN_DECAY_SECONDS) * sampleRate;
+        const double scale = config.matrix == FdnMatrix::Hadamard ? 1.0 / std::sqrt(static_cast<double>(Lines)) : 1.0;
+        const double cutoff = std::min(static_cast<double>(config.dampingHz), 0.45 * sampleRate);
+        const float damping =
+            cutoff > 0.0 ? static_cast<float>(1.0 - std::exp(-2.0 * std::numbers::pi * cutoff / sampleRate)) : 1.0f;
+        uint32_t shortest = longest;
+
+        for (size_t line = 0; line < Lines; ++line)
+        {
+            const double position = static_cast<double>(line) / static_cast<double>(Lines - 1);
+            const double ms = config.sizeMs * std::pow(static_cast<double>(config.spread), 1.0 - position);
+            auto frames = static_cast<uint32_t>(std::lround(ms * 0.001 * sampleRate));
+            while (frames < longest
+                && (!IsPrime(frames) || std::find(next.delays.begin(), next.delays.begin() + line, frames)
+                        != next.delays.begin() + line))
+            {
+                ++frames;
+            }
+
+            next.delays[line] = std::clamp(frames, 1u, longest);
+            next.gains[line] = static_cast<float>(std::pow(1e-3, next.delays[line] / decayFrames) * scale);
+            next.damping[line] = damping;
+            shortest = std::min(shortest, next.delays[line]);
+        }
+
+        next.chunkFrames = std::min(MAX_CHUNK_FRAMES, shortest);
+        next.tailFrames = static_cast<uint32_t>(decayFrames) + *std::ranges::max_element(next.delays);
+        coefficients.Publish(next);
+    }
+
+    template<size_t Lines>
+    void FdnReverb<Lines>::ProcessChunk(std::span<float> block, const Coefficients &current, float currentMix)
+    {
+        const auto frames = static_cast<uint32_t>(block.size() / channels);
+        const float inputScale = 1.0f / static_cast<float>(channels);
+        const float outputScale = 1.0f / std::sqrt(static_cast<float>(Lines));
+        const bool hadamard = config.matrix == FdnMatrix::Hadamard;
+
+        for (uint32_t i = 0; i < frames; ++i)
+        {
+            float sum = 0.0f;
+            for (uint32_t channel = 0; channel < channels; ++channel)
+            {
+                sum += block[i * channels + channel];
+            }
+            input[i] = sum * inputScale + DENORMAL_GUARD;
+        }
+
+        // Every line is at least one chunk long, so the chunk's delay outputs are already written
+        for (size_t line = 0; line < Lines; ++line)
+        {
+            lines[line].ReadFixed(static_cast<float>(current.delays[line] - frames), writeBlocks[line].first(frames));
+        }
+
+        const std::span<float> laneBlock = std::span<float>(lanes).first(static_cast<size_t>(frames) * Lines);
+        LaneKernels::Pack<Lines>(readBlocks, laneBlock);
+        LaneKernels::Gain<Lines>(laneBlock, current.gains);
+        LaneKernels::OnePoleLowpass<Lines>(laneBlock, dampingState, current.damping);
+
+        for (uint32_t i = 0; i < frames; ++i)
+        {
+            float *const v = laneBlock.data() + static_cast<size_t>(i) * Lines;
+            float left = 0.0f;
+            float right = 0.0f;
+            for (size_t line = 0; line < Lines; ++line)
+            {
+                left += v[line] * LEFT_SIGNS[line];
+                right += v[line] * RIGHT_SIGNS[line];
+            }
+
+            if (hadamard)
+            {
+                Hadamard<Lines>(v);
+            }
+            else
+            {
+                Householder<Lines>(v);
+            }
+            for (size_t line = 0; line < Lines; ++line)
+            {
+                v[line] += input[i] * INPUT_SIGNS[line];
+            }
+
+            left *= outputScale;
+            right *= outputScale;
+            float *const frame = block.data() + static_cast<size_t>(i) * channels;
+            for (uint32_t channel = 0; channel < channels; ++channel)
+            {
+                const float wet = channels == 1 ? 0.5f * (left + right) : (channel % 2 == 0 ? left : right);
+                frame[channel] += currentMix * (wet - frame[channel]);
+            }
+        }
+
+        LaneKernels::Unpack<Lines>(laneBlock, writeBlocks);
+        for (size_t line = 0; line < Lines; ++line)
+        {
+            lines[line].Write(readBlocks[line].first(frames));
+        }
+    }
+
+    template class FdnReverb<8>;
+    template class FdnReverb<16>;
+
+} // namespace GuitarIO
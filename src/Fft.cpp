@@ -0,0 +1,135 @@
+#include "Fft.h"
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        // Plain complex product; operator* on std::complex goes through the Annex G NaN/infinity
+        // recovery path (a libgcc call per product) unless built with -ffast-math
+        std::complex<float> Multiply(std::complex<float> a, std::complex<float> b)
+        {
+            return { a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real() };
+        }
+    } // namespace
+
+    bool Fft::Prepare(uint32_t newSize)
+    {
+        if (newSize < MIN_SIZE || newSize > MAX_SIZE || !std::has_single_bit(newSize))
+        {
+            return false;
+        }
+
+        size = newSize;
+        const uint32_t points = size / 2;
+        const int bits = std::countr_zero(points);
+
+        twiddles.resize(points);
+        for (uint32_t k = 0; k < points; ++k)
+        {
+            const double angle = -2.0 * std::numbers::pi * k / size;
+            twiddles[k] = { static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)) };
+        }
+
+        bitReversal.resize(points);
+        for (uint32_t i = 0; i < points; ++i)
+        {
+            uint32_t reversed = 0;
+            for (int bit = 0; bit < bits; ++bit)
+            {
+                reversed |= ((i >> bit) & 1u) << (bits - 1 - bit);
+            }
+            bitReversal[i] = reversed;
+        }
+
+        scratch.assign(points, {});
+        return true;
+    }
+
+    void Fft::Forward(std::span<const float> input, std::span<std::complex<float>> output)
+    {
+        const uint32_t points = size / 2;
+        if (size == 0 || input.size() < size || output.size() < points + 1)
+        {
+            return;
+        }
+
+        for (uint32_t n = 0; n < points; ++n)
+        {
+            scratch[n] = { input[2 * n], input[2 * n + 1] };
+        }
+        Transform(false);
+
+        // Split the packed transform into the even- and odd-sample spectra and combine them
+        for (uint32_t k = 0; k <= points; ++k)
+        {
+            const std::complex<float> packed = scratch[k % points];
+            const std::complex<float> mirrored = std::conj(scratch[(points - k) % points]);
+            const std::complex<float> even = 0.5f * (packed + mirrored);
+            const std::complex<float> difference = packed - mirrored;
+            const std::complex<float> odd(0.5f * difference.imag(), -0.5f * difference.real()); // -i/2 * difference
+            const std::complex<float> twiddle = k < points ? twiddles[k] : std::complex<float>(-1.0f, 0.0f);
+            output[k] = even + Multiply(twiddle, odd);
+        }
+    }
+
+    void Fft::Inverse(std::span<const std::complex<float>> input, std::span<float> output)
+    {
+        const uint32_t points = size / 2;
+        if (size == 0 || input.size() < points + 1 || output.size() < size)
+        {
+            return;
+        }
+
+        // Undo the split: rebuild the packed spectrum of even (real) and odd (imaginary) samples
+        for (uint32_t k = 0; k < points; ++k)
+        {
+            const std::complex<float> mirrored = std::conj(input[points - k]);
+            const std::complex<float> even = input[k] + mirrored;
+            const std::complex<float> odd = Multiply(input[k] - mirrored, std::conj(twiddles[k]));
+            scratch[k] = { even.real() - odd.imag(), even.imag() + odd.real() }; // even + i * odd
+        }
+        Transform(true);
+
+        for (uint32_t n = 0; n < points; ++n)
+        {
+            output[2 * n] = scratch[n].real();
+            output[2 * n + 1] = scratch[n].imag();
+        }
+    }
+
+    void Fft::Transform(bool inverse)
+    {
+        const uint32_t points = size / 2;
+        for (uint32_t i = 0; i < points; ++i)
+        {
+            if (i < bitReversal[i])
+            {
+                std::swap(scratch[i], scratch[bitReversal[i]]);
+            }
+        }
+
+        // Iterative radix-2 butterflies; the stage twiddle W_length^j is twiddles[j * size / length]
+        for (uint32_t length = 2; length <= points; length *= 2)
+        {
+            const uint32_t half = length / 2;
+            const uint32_t stride = size / length;
+            for (uint32_t start = 0; start < points; start += length)
+            {
+                for (uint32_t j = 0; j < half; ++j)
+                {
+                    const std::complex<float> base = twiddles[j * stride];
+                    const std::complex<float> twiddle = inverse ? std::conj(base) : base;
+                    const std::complex<float> a = scratch[start + j];
+                    const std::complex<float> b = Multiply(scratch[start + j + half], twiddle);
+                    scratch[start + j] = a + b;
+                    scratch[start + j + half] = a - b;
+                }
+            }
+        }
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,550 @@
+#include "IrCache.h"
+#include "Fft.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numbers>
+#include <random>
+
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MACOS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GUITAR_IO_HAS_MMAP 1
+#endif
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr uint64_t HASH_SEED = 14695981039346656037ull; ///< FNV-1a offset basis
+        constexpr uint64_t HASH_PRIME = 1099511628211ull;       ///< FNV-1a prime
+        constexpr double PASSBAND = 0.95;                       ///< Resampler cutoff relative to the lower Nyquist
+        constexpr double ZERO_CROSSINGS = 16;                   ///< Resampler kernel half-width in zero crossings
+
+        /**
+         * @brief Decoded WAV file
+         */
+        struct WavData
+        {
+            uint32_t sampleRate = 0;                        ///< File sample rate (Hz)
+            uint32_t channels = 0;                          ///< Channels
+            size_t frames = 0;                              ///< Frames per channel
+            TaggedVector<float, MemoryTag::Tables> samples; ///< Planar samples (frames per channel)
+        };
+
+        uint16_t ReadLe16(const uint8_t *bytes)
+        {
+            return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+        }
+
+        uint32_t ReadLe32(const uint8_t *bytes)
+        {
+            return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+                | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+        }
+
+        /**
+         * @brief Hashes file contents (FNV-1a, 64-bit)
+         * @param bytes File contents
+         * @return Content hash
+         */
+        uint64_t HashBytes(std::span<const uint8_t> bytes)
+        {
+            uint64_t hash = HASH_SEED;
+            for (uint8_t byte : bytes)
+            {
+                hash = (hash ^ byte) * HASH_PRIME;
+            }
+            return hash;
+        }
+
+        /**
+         * @brief Decodes a RIFF/WAVE file with integer PCM (16, 24, 32-bit) or 32-bit float samples
+         * @param bytes File contents
+         * @param wav Decoded samples
+         * @param error Set on failure
+         * @return true on success
+         */
+        bool DecodeWav(std::span<const uint8_t> bytes, WavData &wav, std::string &error)
+        {
+            if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0
+                || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0)
+            {
+                error = "Not a WAV file";
+                return false;
+            }
+
+            uint16_t format = 0;
+            uint16_t blockAlign = 0;
+            uint16_t bits = 0;
+            const uint8_t *data = nullptr;
+            size_t dataBytes = 0;
+            for (size_t offset = 12; offset + 8 <= bytes.size();)
+            {
+                const uint8_t *chunk = bytes.data() + offset;
+                const size_t available = bytes.size() - offset - 8;
+                const size_t chunkBytes = std::min<size_t>(ReadLe32(chunk + 4), available);
+                if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkBytes >= 16)
+                {
+                    format = ReadLe16(chunk + 8);
+                    wav.channels = ReadLe16(chunk + 10);
+                    wav.sampleRate = ReadLe32(chunk + 12);
+                    blockAlign = ReadLe16(chunk + 20);
+                    bits = ReadLe16(chunk + 22);
+                    if (format == 0xFFFE && chunkBytes >= 40)
+                    {
+                        format = ReadLe16(chunk + 32); // WAVE_FORMAT_EXTENSIBLE: sub-format GUID starts with the tag
+                    }
+                }
+                else if (std::memcmp(chunk, "data", 4) == 0)
+                {
+                    data = chunk + 8;
+                    dataBytes = chunkBytes; // Truncated files keep the frames they have
+                }
+                offset += 8 + chunkBytes + (chunkBytes & 1);
+            }
+
+            const bool pcm = format == 1 && (bits == 16 || bits == 24 || bits == 32);
+            const bool ieeeFloat = format == 3 && bits == 32;
+            if (!pcm && !ieeeFloat)
+            {
+                error = "Unsupported WAV sample format " + std::to_string(format) + "/" + std::to_string(bits);
+                return false;
+            }
+
+            const uint32_t sampleBytes = bits / 8u;
+            if (wav.channels == 0 || wav.channels > IrCache::MAX_CHANNELS || wav.sampleRate == 0
+                || blockAlign < wav.channels * sampleBytes || data == nullptr)
+            {
+                error = "Invalid WAV layout";
+                return false;
+            }
+
+            wav.frames = dataBytes / blockAlign;
+            wav.samples.resize(wav.frames * wav.channels);
+            for (size_t frame = 0; frame < wav.frames; ++frame)
+            {
+                for (uint32_t channel = 0; channel < wav.channels; ++channel)
+                {
+                    const uint8_t *sample = data + frame * blockAlign + channel * sampleBytes;
+                    float value = 0.0f;
+                    if (ieeeFloat)
+                    {
+                        std::memcpy(&value, sample, sizeof(value));
+                    }
+                    else if (bits == 16)
+                    {
+                        value = static_cast<float>(static_cast<int16_t>(ReadLe16(sample))) / 32768.0f;
+                    }
+                    else if (bits == 24)
+                    {
+                        // Place the 24 bits at the top of a 32-bit word so the sign extends
+                        const auto word = static_cast<int32_t>((static_cast<uint32_t>(sample[0]) << 8)
+                            | (static_cast<uint32_t>(sample[1]) << 16) | (static_cast<uint32_t>(sample[2]) << 24));
+                        value = static_cast<float>(word) / 2147483648.0f;
+                    }
+                    else
+                    {
+                        value = static_cast<float>(static_cast<int32_t>(ReadLe32(sample))) / 2147483648.0f;
+                    }
+
+                    if (!std::isfinite(value))
+                    {
+                        error = "WAV file contains non-finite samples";
+                        return false;
+                    }
+                    wav.samples[channel * wav.frames + frame] = value;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Resamples one channel by an arbitrary ratio with a Blackman-windowed sinc kernel
+         *
+         * Offline only: every kernel tap is evaluated directly. The output is scaled by from / to
+         * so the response keeps its gain as a filter at the new rate.
+         *
+         * @param input Samples at the source rate
+         * @param from Source rate (Hz)
+         * @param to Target rate (Hz)
+         * @param output Resampled samples (ceil(input.size() * to / from))
+         */
+        void Resample(std::span<const float> input, uint32_t from, uint32_t to, std::span<float> output)
+        {
+            const double step = static_cast<double>(from) / to;
+            const double cutoff = PASSBAND * std::min(1.0, 1.0 / step); // In units of the source Nyquist frequency
+            const double halfWidth = ZERO_CROSSINGS / cutoff;
+            const auto size = static_cast<int64_t>(input.size());
+
+            for (size_t n = 0; n < output.size(); ++n)
+            {
+                const double center = static_cast<double>(n) * step;
+                const auto first = static_cast<int64_t>(std::ceil(center - halfWidth));
+                const auto last = static_cast<int64_t>(std::floor(center + halfWidth));
+
+                // Taps past either end still count towards the normalization, so DC is exact in the
+                // middle and the onset is not boosted where the kernel hangs off the start
+                double sum = 0.0;
+                double weights = 0.0;
+                for (int64_t k = first; k <= last; ++k)
+                {
+                    const double x = static_cast<double>(k) - center;
+                    const double phase = std::numbers::pi * cutoff * x;
+                    const double sinc = x == 0.0 ? 1.0 : std::sin(phase) / phase;
+                    const double u = std::numbers::pi * x / halfWidth;
+                    const double weight = sinc * (0.42 + 0.5 * std::cos(u) + 0.08 * std::cos(2.0 * u));
+                    weights += weight;
+                    if (k >= 0 && k < size)
+                    {
+                        sum += weight * input[static_cast<size_t>(k)];
+                    }
+                }
+                output[n] = static_cast<float>(sum / weights * step);
+            }
+        }
+    } // namespace
+
+    IrAsset::~IrAsset()
+    {
+#if defined(GUITAR_IO_HAS_MMAP)
+        if (mapping != nullptr)
+        {
+            ::munmap(mapping, mappingBytes);
+        }
+#endif
+    }
+
+    std::span<const std::complex<float>> IrAsset::GetPartition(uint32_t channel, uint32_t index) const
+    {
+        if (channel >= header.channels || index >= header.partitionCount)
+        {
+            return {};
+        }
+
+        const size_t bins = header.partitionFrames + 1;
+        return { this->bins + (static_cast<size_t>(channel) * header.partitionCount + index) * bins, bins };
+    }
+
+    IrCache::IrCache(std::filesystem::path directory) : directory(std::move(directory))
+    {
+    }
+
+    IrCache::~IrCache()
+    {
+        WaitForWarm();
+    }
+
+    std::shared_ptr<const IrAsset> IrCache::Load(const std::filesystem::path &path,
+        uint32_t sampleRate,
+        uint32_t partitionFrames)
+    {
+        if (sampleRate == 0 || partitionFrames < MIN_PARTITION_FRAMES || partitionFrames > MAX_PARTITION_FRAMES
+            || !std::has_single_bit(partitionFrames))
+        {
+            SetError("Invalid sample rate or partition size");
+            return nullptr;
+        }
+
+        std::error_code status;
+        const uintmax_t size = std::filesystem::file_size(path, status);
+        const std::filesystem::file_time_type modified = status ? std::filesystem::file_time_type{}
+                                                                : std::filesystem::last_write_time(path, status);
+        if (status)
+        {
+            SetError("Failed to open impulse response: " + path.string());
+            return nullptr;
+        }
+
+        const std::string key =
+            path.string() + "|" + std::to_string(sampleRate) + "|" + std::to_string(partitionFrames);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto found = index.find(key);
+            if (found != index.end() && found->second.size == size && found->second.modified == modified)
+            {
+                return found->second.asset;
+            }
+        }
+
+        TaggedVector<uint8_t, MemoryTag::Other> bytes(size);
+        std::ifstream source(path, std::ios::binary);
+        if (!source || !source.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(size)))
+        {
+            SetError("Failed to read impulse response: " + path.string());
+            return nullptr;
+        }
+
+        const uint64_t hash = HashBytes(bytes);
+        char name[64];
+        std::snprintf(name,
+            sizeof(name),
+            "%016llx-%u-%u.girc",
+            static_cast<unsigned long long>(hash),
+            sampleRate,
+            partitionFrames);
+        const std::filesystem::path file = directory / name;
+
+        std::shared_ptr<IrAsset> asset = Open(file, hash, sampleRate, partitionFrames);
+        if (!asset)
+        {
+            std::string error;
+            asset = Build(bytes, hash, sampleRate, partitionFrames, error);
+            if (!asset)
+            {
+                SetError(error + ": " + path.string());
+                return nullptr;
+            }
+
+            // The asset is usable either way; a failed write only costs a rebuild next time
+            if (!Store(file, *asset))
+            {
+                SetError("Failed to write cache file: " + file.string());
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        index[key] = Entry{ modified, size, asset };
+        return asset;
+    }
+
+    void IrCache::Warm(AsyncExecutor &executor,
+        std::vector<std::filesystem::path> paths,
+        uint32_t sampleRate,
+        uint32_t partitionFrames)
+    {
+        for (std::filesystem::path &path : paths)
+        {
+            warming.fetch_add(1);
+            WarmOne(std::move(path), sampleRate, partitionFrames).Start(executor);
+        }
+    }
+
+    bool IrCache::IsWarming() const
+    {
+        return warming.load() > 0;
+    }
+
+    void IrCache::WaitForWarm()
+    {
+        std::unique_lock<std::mutex> lock(warmMutex);
+        warmDone.wait(lock, [this] { return warming.load() == 0; });
+    }
+
+    void IrCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        index.clear();
+    }
+
+    std::string IrCache::GetLastError() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return lastError;
+    }
+
+    std::shared_ptr<IrAsset> IrCache::Open(const std::filesystem::path &file,
+        uint64_t hash,
+        uint32_t sampleRate,
+        uint32_t partitionFrames)
+    {
+        const auto matches = [&](const IrCacheHeader &header, uint64_t fileBytes)
+        {
+            if (header.magic != IrCacheHeader::MAGIC || header.version != IrCacheHeader::VERSION
+                || header.sourceHash != hash || header.sampleRate != sampleRate
+                || header.partitionFrames != partitionFrames || header.channels == 0
+                || header.channels > MAX_CHANNELS || header.partitionCount == 0
+                || header.partitionCount > MAX_LENGTH_FRAMES / MIN_PARTITION_FRAMES)
+            {
+                return false;
+            }
+            const uint64_t bins =
+                static_cast<uint64_t>(header.channels) * header.partitionCount * (partitionFrames + 1);
+            return fileBytes == sizeof(IrCacheHeader) + bins * sizeof(std::complex<float>);
+        };
+
+        std::shared_ptr<IrAsset> asset(new IrAsset());
+#if defined(GUITAR_IO_HAS_MMAP)
+        const int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        struct stat info{};
+        void *base = MAP_FAILED;
+        const auto bytes = ::fstat(fd, &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+        if (bytes >= sizeof(IrCacheHeader))
+        {
+            base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (base == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        asset->mapping = base;
+        asset->mappingBytes = bytes;
+        std::memcpy(&asset->header, base, sizeof(IrCacheHeader));
+        if (!matches(asset->header, bytes))
+        {
+            return nullptr;
+        }
+
+        // Fault the bins in ahead of the first convolution block rather than on the audio thread
+        ::posix_madvise(base, bytes, POSIX_MADV_WILLNEED);
+        asset->bins = reinterpret_cast<const std::complex<float> *>(static_cast<const uint8_t *>(base)
+            + sizeof(IrCacheHeader));
+        asset->mappedFootprint.emplace(MemoryTag::Fft, bytes);
+#else
+        std::ifstream input(file, std::ios::binary);
+        std::error_code status;
+        const uintmax_t bytes = std::filesystem::file_size(file, status);
+        if (!input || status || !input.read(reinterpret_cast<char *>(&asset->header), sizeof(IrCacheHeader))
+            || !matches(asset->header, bytes))
+        {
+            return nullptr;
+        }
+
+        asset->storage.resize((bytes - sizeof(IrCacheHeader)) / sizeof(std::complex<float>));
+        const auto binBytes = static_cast<std::streamsize>(asset->storage.size() * sizeof(std::complex<float>));
+        if (!input.read(reinterpret_cast<char *>(asset->storage.data()), binBytes))
+        {
+            return nullptr;
+        }
+        asset->bins = asset->storage.data();
+#endif
+        return asset;
+    }
+
+    std::shared_ptr<IrAsset> IrCache::Build(std::span<const uint8_t> bytes,
+        uint64_t hash,
+        uint32_t sampleRate,
+        uint32_t partitionFrames,
+        std::string &error)
+    {
+        WavData wav;
+        if (!DecodeWav(bytes, wav, error))
+        {
+            return nullptr;
+        }
+
+        const uint64_t lengthFrames =
+            (static_cast<uint64_t>(wav.frames) * sampleRate + wav.sampleRate - 1) / wav.sampleRate;
+        if (wav.frames == 0 || lengthFrames > MAX_LENGTH_FRAMES)
+        {
+            error = "Impulse response is empty or too long";
+            return nullptr;
+        }
+
+        TaggedVector<float, MemoryTag::Tables> resampled;
+        if (wav.sampleRate != sampleRate)
+        {
+            resampled.resize(lengthFrames * wav.channels);
+            for (uint32_t channel = 0; channel < wav.channels; ++channel)
+            {
+                Resample(std::span<const float>(wav.samples).subspan(channel * wav.frames, wav.frames),
+                    wav.sampleRate,
+                    sampleRate,
+                    std::span<float>(resampled).subspan(channel * lengthFrames, lengthFrames));
+            }
+        }
+        const std::span<const float> samples = resampled.empty() ? wav.samples : resampled;
+
+        std::shared_ptr<IrAsset> asset(new IrAsset());
+        IrCacheHeader &header = asset->header;
+        header.sourceHash = hash;
+        header.sampleRate = sampleRate;
+        header.partitionFrames = partitionFrames;
+        header.partitionCount = static_cast<uint32_t>((lengthFrames + partitionFrames - 1) / partitionFrames);
+        header.channels = wav.channels;
+        header.lengthFrames = static_cast<uint32_t>(lengthFrames);
+
+        const size_t binCount = partitionFrames + 1;
+        asset->storage.resize(static_cast<size_t>(header.channels) * header.partitionCount * binCount);
+        asset->bins = asset->storage.data();
+
+        Fft fft;
+        fft.Prepare(2 * partitionFrames);
+        TaggedVector<float, MemoryTag::Fft> frame(2 * partitionFrames);
+        const float scale = 1.0f / static_cast<float>(2 * partitionFrames);
+        for (uint32_t channel = 0; channel < header.channels; ++channel)
+        {
+            const std::span<const float> response = samples.subspan(channel * lengthFrames, lengthFrames);
+            for (uint32_t partition = 0; partition < header.partitionCount; ++partition)
+            {
+                // Second half stays zero: the padding that turns circular convolution into linear
+                const size_t start = static_cast<size_t>(partition) * partitionFrames;
+                const size_t count = std::min<size_t>(partitionFrames, response.size() - start);
+                std::fill(frame.begin(), frame.end(), 0.0f);
+                for (size_t n = 0; n < count; ++n)
+                {
+                    frame[n] = response[start + n] * scale;
+                }
+
+                const size_t offset = (static_cast<size_t>(channel) * header.partitionCount + partition) * binCount;
+                fft.Forward(frame, std::span<std::complex<float>>(asset->storage).subspan(offset, binCount));
+            }
+        }
+        return asset;
+    }
+
+    bool IrCache::Store(const std::filesystem::path &file, const IrAsset &asset)
+    {
+        std::error_code status;
+        std::filesystem::create_directories(file.parent_path(), status);
+
+        // Concurrent builders of the same key each write their own file; the rename makes one win whole
+        std::filesystem::path temporary = file;
+        temporary += ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream output(temporary, std::ios::binary);
+            const size_t bins = static_cast<size_t>(asset.header.channels) * asset.header.partitionCount
+                * (asset.header.partitionFrames + 1);
+            output.write(reinterpret_cast<const char *>(&asset.header), sizeof(IrCacheHeader));
+            output.write(reinterpret_cast<const char *>(asset.bins),
+                static_cast<std::streamsize>(bins * sizeof(std::complex<float>)));
+            if (!output.flush())
+            {
+                output.close();
+                std::filesystem::remove(temporary, status);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, file, status);
+        if (status)
+        {
+            std::filesystem::remove(temporary, status);
+            return false;
+        }
+        return true;
+    }
+
+    AsyncTask IrCache::WarmOne(std::filesystem::path path, uint32_t sampleRate, uint32_t partitionFrames)
+    {
+        Load(path, sampleRate, partitionFrames);
+
+        // Decrement under the lock so WaitForWarm() cannot return, and the cache be destroyed,
+        // between the count reaching zero and the notification
+        std::lock_guard<std::mutex> lock(warmMutex);
+        if (warming.fetch_sub(1) == 1)
+        {
+            warmDone.notify_all();
+        }
+        co_return;
+    }
+
+    void IrCache::SetError(std::string message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        lastError = std::move(message);
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,372 @@
+#include "JitterBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr uint32_t DEPTH_HYSTERESIS = 2;      ///< Excess packets tolerated before trimming
+        constexpr uint32_t MAX_CONCEAL_PACKETS = 4;   ///< Concealed packets before output fades to silence
+        constexpr float CONCEAL_DECAY = 0.5f;         ///< Gain applied per concealed packet
+        constexpr double MIN_PITCH_HZ = 50.0;         ///< Longest concealment period
+        constexpr double MAX_PITCH_HZ = 1500.0;       ///< Shortest concealment period
+        constexpr size_t CORRELATION_FRAMES = 256;    ///< Window used for period estimation
+        constexpr float JITTER_SMOOTHING = 1.0f / 16; ///< RFC 3550 jitter filter gain
+
+        float ConcealGain(uint32_t losses)
+        {
+            return losses >= MAX_CONCEAL_PACKETS ? 0.0f : std::pow(CONCEAL_DECAY, static_cast<float>(losses));
+        }
+    } // namespace
+
+    JitterBuffer::JitterBuffer(const JitterBufferConfig &config) : config(config)
+    {
+        this->config.channels = std::max(1u, config.channels);
+        this->config.packetFrames = std::max(1u, config.packetFrames);
+        this->config.minDepthPackets = std::max(1u, config.minDepthPackets);
+
+        uint32_t capacity = 1;
+        while (capacity < std::max(config.capacityPackets, this->config.minDepthPackets + DEPTH_HYSTERESIS + 1))
+        {
+            capacity <<= 1;
+        }
+        this->config.capacityPackets = capacity;
+        this->config.maxDepthPackets = std::clamp(config.maxDepthPackets, this->config.minDepthPackets, capacity - 1);
+
+        const size_t channels = this->config.channels;
+        const auto maxPeriod = static_cast<size_t>(this->config.sampleRate / MIN_PITCH_HZ);
+
+        packetSamples = static_cast<size_t>(this->config.packetFrames) * channels;
+        mask = capacity - 1;
+        slots = std::make_unique<Slot[]>(capacity);
+        slotSamples.resize(capacity * packetSamples);
+        current.resize(packetSamples);
+        history.resize((maxPeriod + CORRELATION_FRAMES) * channels);
+
+        Reset();
+    }
+
+    bool JitterBuffer::Insert(uint32_t sequence, std::span<const float> samples)
+    {
+        if (samples.size() != packetSamples)
+        {
+            return false;
+        }
+
+        const auto arrival = std::chrono::steady_clock::now();
+
+        int64_t read = readSequence.load(std::memory_order_acquire);
+        if (read < 0)
+        {
+            // First packet defines the playout position
+            newestSequence.store(sequence, std::memory_order_relaxed);
+            readSequence.store(sequence, std::memory_order_release);
+            read = sequence;
+        }
+
+        const auto offset = static_cast<int32_t>(sequence - static_cast<uint32_t>(read));
+        if (offset < 0)
+        {
+            packetsLate.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (offset >= static_cast<int32_t>(config.capacityPackets))
+        {
+            packetsOverflow.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const size_t index = sequence & mask;
+        Slot &slot = slots[index];
+        if (slot.sequence.load(std::memory_order_acquire) == static_cast<int64_t>(sequence))
+        {
+            packetsDuplicate.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const auto destination = slotSamples.begin() + static_cast<std::ptrdiff_t>(index * packetSamples);
+        std::copy(samples.begin(), samples.end(), destination);
+        slot.sequence.store(sequence, std::memory_order_release);
+
+        if (static_cast<int32_t>(sequence - newestSequence.load(std::memory_order_relaxed)) > 0)
+        {
+            newestSequence.store(sequence, std::memory_order_release);
+        }
+
+        // RFC 3550 interarrival jitter, measured in frames
+        if (hasArrival)
+        {
+            const double arrivalFrames =
+                std::chrono::duration<double>(arrival - lastArrival).count() * config.sampleRate;
+            const double timestampFrames =
+                static_cast<double>(static_cast<int32_t>(sequence - lastArrivalSequence)) * config.packetFrames;
+            const auto deviation = static_cast<float>(std::fabs(arrivalFrames - timestampFrames));
+            const float jitter = jitterFrames.load(std::memory_order_relaxed);
+            jitterFrames.store(jitter + (deviation - jitter) * JITTER_SMOOTHING, std::memory_order_relaxed);
+        }
+        hasArrival = true;
+        lastArrival = arrival;
+        lastArrivalSequence = sequence;
+
+        packetsReceived.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void JitterBuffer::Read(std::span<float> block)
+    {
+        const size_t channels = config.channels;
+        const size_t frames = block.size() / channels;
+
+        size_t written = 0;
+        while (written < frames)
+        {
+            if (currentFrame >= config.packetFrames)
+            {
+                NextPacket();
+            }
+
+            const size_t count = std::min(frames - written, config.packetFrames - currentFrame);
+            std::copy_n(current.begin() + static_cast<std::ptrdiff_t>(currentFrame * channels),
+                count * channels,
+                block.begin() + static_cast<std::ptrdiff_t>(written * channels));
+
+            currentFrame += count;
+            written += count;
+        }
+    }
+
+    void JitterBuffer::Reset()
+    {
+        for (uint32_t i = 0; i < config.capacityPackets; ++i)
+        {
+            slots[i].sequence.store(-1, std::memory_order_relaxed);
+        }
+
+        readSequence.store(-1, std::memory_order_relaxed);
+        newestSequence.store(0, std::memory_order_relaxed);
+        jitterFrames.store(0.0f, std::memory_order_relaxed);
+        targetDepth.store(config.minDepthPackets, std::memory_order_relaxed);
+        hasArrival = false;
+
+        playing = false;
+        std::fill(current.begin(), current.end(), 0.0f);
+        std::fill(history.begin(), history.end(), 0.0f);
+        currentFrame = config.packetFrames;
+        concealPeriod = 0;
+        concealPhase = 0;
+        consecutiveLosses = 0;
+    }
+
+    JitterBufferStats JitterBuffer::GetStats() const
+    {
+        JitterBufferStats stats;
+        stats.packetsReceived = packetsReceived.load(std::memory_order_relaxed);
+        stats.packetsLate = packetsLate.load(std::memory_order_relaxed);
+        stats.packetsDuplicate = packetsDuplicate.load(std::memory_order_relaxed);
+        stats.packetsOverflow = packetsOverflow.load(std::memory_order_relaxed);
+        stats.packetsConcealed = packetsConcealed.load(std::memory_order_relaxed);
+        stats.packetsDiscarded = packetsDiscarded.load(std::memory_order_relaxed);
+        stats.jitterMs = jitterFrames.load(std::memory_order_relaxed) * 1000.0 / config.sampleRate;
+        stats.targetDepthPackets = targetDepth.load(std::memory_order_relaxed);
+
+        const int64_t read = readSequence.load(std::memory_order_acquire);
+        if (read >= 0)
+        {
+            const auto depth = static_cast<int32_t>(
+                                   newestSequence.load(std::memory_order_acquire) - static_cast<uint32_t>(read))
+                               + 1;
+            stats.depthPackets = static_cast<uint32_t>(std::max(depth, 0));
+        }
+
+        return stats;
+    }
+
+    const JitterBufferConfig &JitterBuffer::GetConfig() const
+    {
+        return config;
+    }
+
+    void JitterBuffer::NextPacket()
+    {
+        currentFrame = 0;
+
+        const int64_t read = readSequence.load(std::memory_order_acquire);
+        if (read < 0)
+        {
+            std::fill(current.begin(), current.end(), 0.0f);
+            return;
+        }
+
+        auto sequence = static_cast<uint32_t>(read);
+        const auto depth = static_cast<int32_t>(newestSequence.load(std::memory_order_acquire) - sequence) + 1;
+        const uint32_t target = ComputeTargetDepth();
+        targetDepth.store(target, std::memory_order_relaxed);
+
+        if (!playing)
+        {
+            if (depth < static_cast<int32_t>(target))
+            {
+                std::fill(current.begin(), current.end(), 0.0f);
+                return;
+            }
+            playing = true;
+        }
+
+        // Trim latency that is no longer justified by the measured jitter
+        if (depth > static_cast<int32_t>(target + DEPTH_HYSTERESIS))
+        {
+            ++sequence;
+            packetsDiscarded.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const size_t index = sequence & mask;
+        if (slots[index].sequence.load(std::memory_order_acquire) == static_cast<int64_t>(sequence))
+        {
+            const auto source = slotSamples.begin() + static_cast<std::ptrdiff_t>(index * packetSamples);
+            std::copy_n(source, packetSamples, current.begin());
+
+            if (consecutiveLosses > 0)
+            {
+                // Crossfade from the extrapolated waveform into the real signal
+                const size_t channels = config.channels;
+                const size_t fadeFrames = std::min<size_t>(config.crossfadeFrames, config.packetFrames);
+                const float gain = ConcealGain(consecutiveLosses);
+                for (size_t i = 0; i < fadeFrames; ++i)
+                {
+                    const size_t frame = history.size() / channels - concealPeriod
+                                         + (concealPhase + i) % concealPeriod;
+                    const float t = static_cast<float>(i + 1) / static_cast<float>(fadeFrames + 1);
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        float &sample = current[i * channels + c];
+                        sample = sample * t + history[frame * channels + c] * gain * (1.0f - t);
+                    }
+                }
+                consecutiveLosses = 0;
+            }
+
+            PushHistory(current);
+            readSequence.store(static_cast<int64_t>(sequence + 1), std::memory_order_release);
+            return;
+        }
+
+        Conceal();
+        packetsConcealed.fetch_add(1, std::memory_order_relaxed);
+
+        if (depth > 1)
+        {
+            // Newer packets exist, so this one is lost rather than late
+            readSequence.store(static_cast<int64_t>(sequence + 1), std::memory_order_release);
+        }
+        else if (consecutiveLosses >= MAX_CONCEAL_PACKETS)
+        {
+            // Buffer ran dry: rebuild the target depth before playing again
+            playing = false;
+        }
+        else if (sequence != static_cast<uint32_t>(read))
+        {
+            readSequence.store(static_cast<int64_t>(sequence), std::memory_order_release);
+        }
+    }
+
+    void JitterBuffer::Conceal()
+    {
+        const size_t channels = config.channels;
+        const size_t historyFrames = history.size() / channels;
+
+        if (consecutiveLosses == 0)
+        {
+            concealPeriod = EstimatePeriod();
+            concealPhase = 0;
+        }
+
+        // History stays frozen at the last real packet while concealing, so the phase
+        // continues from where the previous concealed packet stopped
+        const float startGain = ConcealGain(consecutiveLosses);
+        const float endGain = ConcealGain(consecutiveLosses + 1);
+        const float gainStep = (endGain - startGain) / static_cast<float>(config.packetFrames);
+
+        for (size_t i = 0; i < config.packetFrames; ++i)
+        {
+            const size_t frame = historyFrames - concealPeriod + (concealPhase + i) % concealPeriod;
+            const float gain = startGain + gainStep * static_cast<float>(i);
+            for (size_t c = 0; c < channels; ++c)
+            {
+                current[i * channels + c] = history[frame * channels + c] * gain;
+            }
+        }
+
+        concealPhase = (concealPhase + config.packetFrames) % concealPeriod;
+        ++consecutiveLosses;
+    }
+
+    size_t JitterBuffer::EstimatePeriod() const
+    {
+        const size_t channels = config.channels;
+        const size_t historyFrames = history.size() / channels;
+        const size_t minPeriod = std::max<size_t>(1, static_cast<size_t>(config.sampleRate / MAX_PITCH_HZ));
+        const size_t maxPeriod = historyFrames - CORRELATION_FRAMES;
+        const size_t windowStart = historyFrames - CORRELATION_FRAMES;
+
+        auto correlation = [&](size_t lag) {
+            float product = 0.0f;
+            float energy = 0.0f;
+            for (size_t i = 0; i < CORRELATION_FRAMES; ++i)
+            {
+                const float sample = history[(windowStart + i) * channels];
+                const float lagged = history[(windowStart + i - lag) * channels];
+                product += sample * lagged;
+                energy += lagged * lagged;
+            }
+            return energy > 0.0f ? product / std::sqrt(energy) : 0.0f;
+        };
+
+        // Coarse search on even lags, then refine around the best one
+        size_t bestLag = maxPeriod;
+        float bestScore = 0.0f;
+        for (size_t lag = minPeriod; lag <= maxPeriod; lag += 2)
+        {
+            const float score = correlation(lag);
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestLag = lag;
+            }
+        }
+
+        const size_t coarseLag = bestLag;
+        for (size_t lag = std::max(minPeriod, coarseLag - 1); lag <= std::min(maxPeriod, coarseLag + 1); ++lag)
+        {
+            const float score = correlation(lag);
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestLag = lag;
+            }
+        }
+
+        return bestLag;
+    }
+
+    void JitterBuffer::PushHistory(std::span<const float> packet)
+    {
+        if (packet.size() >= history.size())
+        {
+            std::copy(packet.end() - static_cast<std::ptrdiff_t>(history.size()), packet.end(), history.begin());
+            return;
+        }
+
+        std::copy(history.begin() + static_cast<std::ptrdiff_t>(packet.size()), history.end(), history.begin());
+        std::copy(packet.begin(), packet.end(), history.end() - static_cast<std::ptrdiff_t>(packet.size()));
+    }
+
+    uint32_t JitterBuffer::ComputeTargetDepth() const
+    {
+        const float jitterPackets = jitterFrames.load(std::memory_order_relaxed) * config.jitterMultiplier
+                                    / static_cast<float>(config.packetFrames);
+        const auto depth = static_cast<uint32_t>(std::ceil(jitterPackets)) + 1;
+        return std::clamp(depth, config.minDepthPackets, config.maxDepthPackets);
+    }
+
+} // namespace GuitarIO
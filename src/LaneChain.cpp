@@ -0,0 +1,231 @@
+#include "LaneChain.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace GuitarIO
+{
+    template<size_t Lanes> LaneGain<Lanes>::LaneGain()
+    {
+        gains.fill(1.0f);
+    }
+
+    template<size_t Lanes> void LaneGain<Lanes>::SetGain(size_t lane, float gain)
+    {
+        if (lane < Lanes)
+        {
+            gains[lane] = gain;
+        }
+    }
+
+    template<size_t Lanes> void LaneGain<Lanes>::ProcessLanes(std::span<float> soa)
+    {
+        LaneKernels::Gain<Lanes>(soa, gains);
+    }
+
+    template<size_t Lanes> LaneNoiseGate<Lanes>::LaneNoiseGate(double sampleRate) : sampleRate(sampleRate)
+    {
+        PublishCoefficients();
+    }
+
+    template<size_t Lanes> void LaneNoiseGate<Lanes>::SetThreshold(size_t lane, float threshold)
+    {
+        if (lane < Lanes)
+        {
+            thresholds[lane] = threshold;
+        }
+    }
+
+    template<size_t Lanes> void LaneNoiseGate<Lanes>::SetTimes(double newReleaseMs, double newSmoothingMs)
+    {
+        releaseMs = newReleaseMs;
+        smoothingMs = newSmoothingMs;
+        PublishCoefficients();
+    }
+
+    template<size_t Lanes> bool LaneNoiseGate<Lanes>::Prepare(const ProcessSpec &spec)
+    {
+        if (spec.sampleRate <= 0.0)
+        {
+            return false;
+        }
+
+        maxSampleRate = spec.GetMaxSampleRate();
+        SetSampleRate(spec.sampleRate);
+        Reset();
+        return true;
+    }
+
+    template<size_t Lanes> void LaneNoiseGate<Lanes>::SetSampleRate(double newSampleRate)
+    {
+        sampleRate = maxSampleRate > 0.0 ? std::min(newSampleRate, maxSampleRate) : newSampleRate;
+        PublishCoefficients();
+    }
+
+    template<size_t Lanes> void LaneNoiseGate<Lanes>::ProcessLanes(std::span<float> soa)
+    {
+        const Coefficients &current = coefficients.Acquire();
+        LaneKernels::NoiseGate<Lanes>(soa, state, thresholds, current.release, current.smoothing);
+    }
+
+    template<size_t Lanes> void LaneNoiseGate<Lanes>::Reset()
+    {
+        state = {};
+    }
+
+    template<size_t Lanes> void LaneNoiseGate<Lanes>::PublishCoefficients()
+    {
+        if (sampleRate <= 0.0)
+        {
+            return;
+        }
+
+        Coefficients next;
+        next.release = static_cast<float>(std::exp(-1000.0 / (std::max(releaseMs, 0.01) * sampleRate)));
+        next.smoothing = static_cast<float>(1.0 - std::exp(-1000.0 / (std::max(smoothingMs, 0.01) * sampleRate)));
+        coefficients.Publish(next);
+    }
+
+    template<size_t Lanes> LaneLowpass<Lanes>::LaneLowpass(double sampleRate) : sampleRate(sampleRate)
+    {
+        cutoffs.fill(std::numeric_limits<double>::infinity());
+        PublishCoefficients();
+    }
+
+    template<size_t Lanes> void LaneLowpass<Lanes>::SetCutoff(size_t lane, double cutoff)
+    {
+        if (lane < Lanes)
+        {
+            cutoffs[lane] = cutoff;
+            PublishCoefficients();
+        }
+    }
+
+    template<size_t Lanes> bool LaneLowpass<Lanes>::Prepare(const ProcessSpec &spec)
+    {
+        if (spec.sampleRate <= 0.0)
+        {
+            return false;
+        }
+
+        maxSampleRate = spec.GetMaxSampleRate();
+        SetSampleRate(spec.sampleRate);
+        Reset();
+        return true;
+    }
+
+    template<size_t Lanes> void LaneLowpass<Lanes>::SetSampleRate(double newSampleRate)
+    {
+        sampleRate = maxSampleRate > 0.0 ? std::min(newSampleRate, maxSampleRate) : newSampleRate;
+        PublishCoefficients();
+    }
+
+    template<size_t Lanes> void LaneLowpass<Lanes>::ProcessLanes(std::span<float> soa)
+    {
+        LaneKernels::OnePoleLowpass<Lanes>(soa, state, coefficients.Acquire());
+    }
+
+    template<size_t Lanes> void LaneLowpass<Lanes>::Reset()
+    {
+        state = {};
+    }
+
+    template<size_t Lanes> void LaneLowpass<Lanes>::PublishCoefficients()
+    {
+        if (sampleRate <= 0.0)
+        {
+            return;
+        }
+
+        // An infinite cutoff gives a coefficient of exactly 1 (bypass)
+        std::array<float, Lanes> next{};
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            next[lane] = static_cast<float>(1.0 - std::exp(-2.0 * std::numbers::pi * cutoffs[lane] / sampleRate));
+        }
+        coefficients.Publish(next);
+    }
+
+    template<size_t Lanes> LaneChain<Lanes>::LaneChain(size_t maxFrames) : soa(maxFrames * Lanes)
+    {
+    }
+
+    template<size_t Lanes> void LaneChain<Lanes>::Add(std::unique_ptr<LaneProcessor<Lanes>> processor)
+    {
+        if (processor)
+        {
+            processors.push_back(std::move(processor));
+        }
+    }
+
+    template<size_t Lanes> bool LaneChain<Lanes>::Prepare(const ProcessSpec &spec)
+    {
+        soa.assign(static_cast<size_t>(spec.maxBlockFrames) * Lanes, 0.0f);
+
+        bool prepared = true;
+        for (auto &processor : processors)
+        {
+            prepared = processor->Prepare(spec) && prepared;
+        }
+        return prepared;
+    }
+
+    template<size_t Lanes> void LaneChain<Lanes>::SetSampleRate(double sampleRate)
+    {
+        for (auto &processor : processors)
+        {
+            processor->SetSampleRate(sampleRate);
+        }
+    }
+
+    template<size_t Lanes> void LaneChain<Lanes>::Process(std::span<float> buffer, uint32_t channels)
+    {
+        if (channels != Lanes)
+        {
+            return;
+        }
+
+        for (auto &processor : processors)
+        {
+            processor->ProcessLanes(buffer);
+        }
+    }
+
+    template<size_t Lanes>
+    void LaneChain<Lanes>::ProcessStreams(std::span<const std::span<const float>> inputs,
+        std::span<const std::span<float>> outputs,
+        size_t frames)
+    {
+        const std::span<float> block(soa.data(), std::min(frames, soa.size() / Lanes) * Lanes);
+
+        LaneKernels::Pack<Lanes>(inputs, block);
+        for (auto &processor : processors)
+        {
+            processor->ProcessLanes(block);
+        }
+        LaneKernels::Unpack<Lanes>(block, outputs);
+    }
+
+    template<size_t Lanes> void LaneChain<Lanes>::Reset()
+    {
+        for (auto &processor : processors)
+        {
+            processor->Reset();
+        }
+    }
+
+    template class LaneGain<4>;
+    template class LaneGain<8>;
+    template class LaneGain<16>;
+    template class LaneNoiseGate<4>;
+    template class LaneNoiseGate<8>;
+    template class LaneNoiseGate<16>;
+    template class LaneLowpass<4>;
+    template class LaneLowpass<8>;
+    template class LaneLowpass<16>;
+    template class LaneChain<4>;
+    template class LaneChain<8>;
+    template class LaneChain<16>;
+
+} // namespace GuitarIO
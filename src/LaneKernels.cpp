@@ -0,0 +1,146 @@
+#include "LaneKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GuitarIO
+{
+    template<size_t Lanes> void LaneKernels::Pack(std::span<const std::span<const float>> inputs, std::span<float> soa)
+    {
+        const size_t frames = soa.size() / Lanes;
+        const size_t lanes = std::min(inputs.size(), Lanes);
+
+        std::fill(soa.begin(), soa.end(), 0.0f);
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const std::span<const float> input = inputs[lane];
+            const size_t count = std::min(frames, input.size());
+            for (size_t i = 0; i < count; ++i)
+            {
+                soa[i * Lanes + lane] = input[i];
+            }
+        }
+    }
+
+    template<size_t Lanes>
+    void LaneKernels::Unpack(std::span<const float> soa, std::span<const std::span<float>> outputs)
+    {
+        const size_t frames = soa.size() / Lanes;
+        const size_t lanes = std::min(outputs.size(), Lanes);
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            const std::span<float> output = outputs[lane];
+            const size_t count = std::min(frames, output.size());
+            for (size_t i = 0; i < count; ++i)
+            {
+                output[i] = soa[i * Lanes + lane];
+            }
+        }
+    }
+
+    template<size_t Lanes> void LaneKernels::Gain(std::span<float> soa, const std::array<float, Lanes> &gains)
+    {
+        const size_t frames = soa.size() / Lanes;
+        float *data = soa.data();
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            for (size_t lane = 0; lane < Lanes; ++lane)
+            {
+                data[i * Lanes + lane] *= gains[lane];
+            }
+        }
+    }
+
+    template<size_t Lanes>
+    void LaneKernels::Mix(std::span<const float> input, std::span<float> output, const std::array<float, Lanes> &gains)
+    {
+        if (input.size() != output.size())
+        {
+            return;
+        }
+
+        const size_t frames = output.size() / Lanes;
+        const float *in = input.data();
+        float *out = output.data();
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            for (size_t lane = 0; lane < Lanes; ++lane)
+            {
+                out[i * Lanes + lane] += in[i * Lanes + lane] * gains[lane];
+            }
+        }
+    }
+
+    template<size_t Lanes>
+    void LaneKernels::NoiseGate(std::span<float> soa,
+        LaneGateState<Lanes> &state,
+        const std::array<float, Lanes> &thresholds,
+        float release,
+        float smoothing)
+    {
+        const size_t frames = soa.size() / Lanes;
+        float *data = soa.data();
+
+        // Local copies keep the state in registers across the block
+        std::array<float, Lanes> envelope = state.envelope;
+        std::array<float, Lanes> gain = state.gain;
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            for (size_t lane = 0; lane < Lanes; ++lane)
+            {
+                float &sample = data[i * Lanes + lane];
+                envelope[lane] = std::max(std::fabs(sample), envelope[lane] * release);
+                const float target = envelope[lane] >= thresholds[lane] ? 1.0f : 0.0f;
+                gain[lane] += (target - gain[lane]) * smoothing;
+                sample *= gain[lane];
+            }
+        }
+
+        state.envelope = envelope;
+        state.gain = gain;
+    }
+
+    template<size_t Lanes>
+    void LaneKernels::OnePoleLowpass(std::span<float> soa,
+        LaneFilterState<Lanes> &state,
+        const std::array<float, Lanes> &coefficients)
+    {
+        const size_t frames = soa.size() / Lanes;
+        float *data = soa.data();
+
+        std::array<float, Lanes> z = state.z;
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            for (size_t lane = 0; lane < Lanes; ++lane)
+            {
+                float &sample = data[i * Lanes + lane];
+                z[lane] += (sample - z[lane]) * coefficients[lane];
+                sample = z[lane];
+            }
+        }
+
+        state.z = z;
+    }
+
+#define GUITAR_IO_INSTANTIATE_LANE_KERNELS(LANES)                                                                      \
+    template void LaneKernels::Pack<LANES>(std::span<const std::span<const float>>, std::span<float>);                 \
+    template void LaneKernels::Unpack<LANES>(std::span<const float>, std::span<const std::span<float>>);               \
+    template void LaneKernels::Gain<LANES>(std::span<float>, const std::array<float, LANES> &);                        \
+    template void LaneKernels::Mix<LANES>(std::span<const float>, std::span<float>, const std::array<float, LANES> &); \
+    template void LaneKernels::NoiseGate<LANES>(                                                                       \
+        std::span<float>, LaneGateState<LANES> &, const std::array<float, LANES> &, float, float);                     \
+    template void LaneKernels::OnePoleLowpass<LANES>(                                                                  \
+        std::span<float>, LaneFilterState<LANES> &, const std::array<float, LANES> &);
+
+    GUITAR_IO_INSTANTIATE_LANE_KERNELS(4)
+    GUITAR_IO_INSTANTIATE_LANE_KERNELS(8)
+    GUITAR_IO_INSTANTIATE_LANE_KERNELS(16)
+
+#undef GUITAR_IO_INSTANTIATE_LANE_KERNELS
+
+} // namespace GuitarIO
@@ -0,0 +1,115 @@
+#include "MemoryAccounting.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace GuitarIO
+{
+    std::array<MemoryAccounting::Counters, static_cast<size_t>(MemoryTag::Count)> MemoryAccounting::counters;
+
+    void MemoryAccounting::Add(MemoryTag tag, size_t bytes)
+    {
+        Counters &tagCounters = counters[static_cast<size_t>(tag)];
+        const size_t current = tagCounters.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        tagCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+
+        size_t peak = tagCounters.peak.load(std::memory_order_relaxed);
+        while (current > peak && !tagCounters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void MemoryAccounting::Remove(MemoryTag tag, size_t bytes)
+    {
+        counters[static_cast<size_t>(tag)].current.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    MemoryUsage MemoryAccounting::GetUsage(MemoryTag tag)
+    {
+        const Counters &tagCounters = counters[static_cast<size_t>(tag)];
+        MemoryUsage usage;
+        usage.tag = tag;
+        usage.name = GetTagName(tag);
+        usage.currentBytes = tagCounters.current.load(std::memory_order_relaxed);
+        usage.peakBytes = std::max(usage.currentBytes, tagCounters.peak.load(std::memory_order_relaxed));
+        usage.allocations = tagCounters.allocations.load(std::memory_order_relaxed);
+        return usage;
+    }
+
+    std::vector<MemoryUsage> MemoryAccounting::GetReport()
+    {
+        std::vector<MemoryUsage> report;
+        report.reserve(counters.size());
+        for (size_t i = 0; i < counters.size(); ++i)
+        {
+            report.push_back(GetUsage(static_cast<MemoryTag>(i)));
+        }
+        return report;
+    }
+
+    std::string MemoryAccounting::FormatReport()
+    {
+        std::string text = "tag        current bytes     peak bytes  allocations\n";
+        size_t totalCurrent = 0;
+        size_t totalPeak = 0;
+        char line[96];
+
+        for (const MemoryUsage &usage : GetReport())
+        {
+            std::snprintf(line,
+                sizeof(line),
+                "%-8s %15zu %14zu %12llu\n",
+                usage.name,
+                usage.currentBytes,
+                usage.peakBytes,
+                static_cast<unsigned long long>(usage.allocations));
+            text += line;
+            totalCurrent += usage.currentBytes;
+            totalPeak += usage.peakBytes;
+        }
+
+        // Per-tag peaks need not coincide, so the total peak is an upper bound
+        std::snprintf(line, sizeof(line), "%-8s %15zu %14zu\n", "total", totalCurrent, totalPeak);
+        text += line;
+        return text;
+    }
+
+    size_t MemoryAccounting::GetTotalBytes()
+    {
+        size_t total = 0;
+        for (const Counters &tagCounters : counters)
+        {
+            total += tagCounters.current.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void MemoryAccounting::ResetPeaks()
+    {
+        for (Counters &tagCounters : counters)
+        {
+            tagCounters.peak.store(tagCounters.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    const char *MemoryAccounting::GetTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::Buffers:
+            return "buffers";
+        case MemoryTag::Rings:
+            return "rings";
+        case MemoryTag::Tables:
+            return "tables";
+        case MemoryTag::Voices:
+            return "voices";
+        case MemoryTag::Fft:
+            return "fft";
+        case MemoryTag::Other:
+        case MemoryTag::Count:
+            break;
+        }
+        return "other";
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,357 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        bool IsValidName(const std::string &name)
+        {
+            if (name.empty() || (name[0] >= '0' && name[0] <= '9'))
+            {
+                return false;
+            }
+
+            return std::ranges::all_of(name,
+                [](char c)
+                {
+                    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'
+                        || c == ':';
+                });
+        }
+
+        void AppendNumber(std::string &out, double value)
+        {
+            if (std::isnan(value))
+            {
+                out += "NaN";
+                return;
+            }
+            if (std::isinf(value))
+            {
+                out += value > 0.0 ? "+Inf" : "-Inf";
+                return;
+            }
+
+            // Whole numbers (counters, most gauges) print as integers rather than in shortest form (2e+05)
+            std::array<char, 32> text{};
+            char *const first = text.data();
+            char *const last = text.data() + text.size();
+            const bool whole = std::trunc(value) == value && std::fabs(value) < 9007199254740992.0;
+            const auto result =
+                whole ? std::to_chars(first, last, static_cast<int64_t>(value)) : std::to_chars(first, last, value);
+            out.append(text.data(), result.ptr);
+        }
+
+        void AppendHelp(std::string &out, const std::string &help)
+        {
+            for (const char c : help)
+            {
+                if (c == '\\')
+                {
+                    out += "\\\\";
+                }
+                else if (c == '\n')
+                {
+                    out += "\\n";
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+        }
+
+        const char *TypeName(MetricType type)
+        {
+            switch (type)
+            {
+            case MetricType::Counter:
+                return "counter";
+            case MetricType::Gauge:
+                return "gauge";
+            case MetricType::Histogram:
+                return "histogram";
+            }
+            return "untyped";
+        }
+    } // namespace
+
+    void MetricCounter::Increment(uint64_t amount)
+    {
+        value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    uint64_t MetricCounter::Get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    void MetricGauge::Set(double newValue)
+    {
+        value.store(newValue, std::memory_order_relaxed);
+    }
+
+    void MetricGauge::Add(double delta)
+    {
+        value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    double MetricGauge::Get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    MetricHistogram::MetricHistogram(std::vector<double> upperBounds)
+        : bounds(std::move(upperBounds)), buckets(std::make_unique<std::atomic<uint64_t>[]>(bounds.size() + 1))
+    {
+    }
+
+    void MetricHistogram::Observe(double value)
+    {
+        size_t bucket = 0;
+        while (bucket < bounds.size() && value > bounds[bucket])
+        {
+            ++bucket;
+        }
+
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    const std::vector<double> &MetricHistogram::GetUpperBounds() const
+    {
+        return bounds;
+    }
+
+    std::vector<uint64_t> MetricHistogram::GetBucketCounts() const
+    {
+        std::vector<uint64_t> counts(bounds.size() + 1);
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            counts[i] = buckets[i].load(std::memory_order_relaxed);
+        }
+        return counts;
+    }
+
+    double MetricHistogram::GetSum() const
+    {
+        return sum.load(std::memory_order_relaxed);
+    }
+
+    MetricCounter *MetricsRegistry::AddCounter(const std::string &name, const std::string &help)
+    {
+        const std::lock_guard lock(mutex);
+        const Entry *existing = nullptr;
+        if (!Lookup(name, MetricType::Counter, existing))
+        {
+            return nullptr;
+        }
+        if (existing != nullptr)
+        {
+            return &counters[existing->index];
+        }
+
+        entries.push_back({ name, help, MetricType::Counter, counters.size() });
+        return &counters.emplace_back();
+    }
+
+    MetricGauge *MetricsRegistry::AddGauge(const std::string &name, const std::string &help)
+    {
+        const std::lock_guard lock(mutex);
+        const Entry *existing = nullptr;
+        if (!Lookup(name, MetricType::Gauge, existing))
+        {
+            return nullptr;
+        }
+        if (existing != nullptr)
+        {
+            return &gauges[existing->index];
+        }
+
+        entries.push_back({ name, help, MetricType::Gauge, gauges.size() });
+        return &gauges.emplace_back();
+    }
+
+    MetricHistogram *MetricsRegistry::AddHistogram(const std::string &name,
+        const std::string &help,
+        std::vector<double> upperBounds)
+    {
+        const std::lock_guard lock(mutex);
+        const Entry *existing = nullptr;
+        if (!Lookup(name, MetricType::Histogram, existing))
+        {
+            return nullptr;
+        }
+        if (existing != nullptr)
+        {
+            return &histograms[existing->index];
+        }
+
+        if (!std::ranges::is_sorted(upperBounds)
+            || std::ranges::adjacent_find(upperBounds) != upperBounds.end())
+        {
+            lastError = "Histogram bounds must be strictly increasing: " + name;
+            return nullptr;
+        }
+
+        entries.push_back({ name, help, MetricType::Histogram, histograms.size() });
+        return &histograms.emplace_back(std::move(upperBounds));
+    }
+
+    void MetricsRegistry::AddCollector(std::function<void()> collector)
+    {
+        const std::lock_guard lock(mutex);
+        collectors.push_back(std::move(collector));
+    }
+
+    MetricsSnapshot MetricsRegistry::Snapshot() const
+    {
+        const std::lock_guard lock(mutex);
+        for (const auto &collector : collectors)
+        {
+            collector();
+        }
+
+        MetricsSnapshot snapshot;
+        snapshot.metrics.reserve(entries.size());
+        for (const Entry &entry : entries)
+        {
+            MetricSample &sample = snapshot.metrics.emplace_back();
+            sample.name = entry.name;
+            sample.help = entry.help;
+            sample.type = entry.type;
+
+            switch (entry.type)
+            {
+            case MetricType::Counter:
+                sample.value = static_cast<double>(counters[entry.index].Get());
+                break;
+            case MetricType::Gauge:
+                sample.value = gauges[entry.index].Get();
+                break;
+            case MetricType::Histogram:
+            {
+                // Observations racing the snapshot may show in a bucket before the sum; the count
+                // is derived from the buckets so the exposition stays self-consistent
+                const MetricHistogram &histogram = histograms[entry.index];
+                sample.upperBounds = histogram.GetUpperBounds();
+                sample.bucketCounts = histogram.GetBucketCounts();
+                for (size_t i = 1; i < sample.bucketCounts.size(); ++i)
+                {
+                    sample.bucketCounts[i] += sample.bucketCounts[i - 1];
+                }
+                sample.count = sample.bucketCounts.back();
+                sample.sum = histogram.GetSum();
+                break;
+            }
+            }
+        }
+        return snapshot;
+    }
+
+    std::string MetricsRegistry::ExportPrometheus() const
+    {
+        return FormatPrometheus(Snapshot());
+    }
+
+    std::string MetricsRegistry::FormatPrometheus(const MetricsSnapshot &snapshot)
+    {
+        std::string out;
+        for (const MetricSample &sample : snapshot.metrics)
+        {
+            out += "# HELP " + sample.name + " ";
+            AppendHelp(out, sample.help);
+            out += "\n# TYPE " + sample.name + " " + TypeName(sample.type) + "\n";
+
+            if (sample.type != MetricType::Histogram)
+            {
+                out += sample.name + " ";
+                AppendNumber(out, sample.value);
+                out += "\n";
+                continue;
+            }
+
+            for (size_t i = 0; i < sample.bucketCounts.size(); ++i)
+            {
+                const bool last = i >= sample.upperBounds.size();
+                out += sample.name + "_bucket{le=\"";
+                AppendNumber(out, last ? std::numeric_limits<double>::infinity() : sample.upperBounds[i]);
+                out += "\"} " + std::to_string(sample.bucketCounts[i]) + "\n";
+            }
+            out += sample.name + "_sum ";
+            AppendNumber(out, sample.sum);
+            out += "\n" + sample.name + "_count " + std::to_string(sample.count) + "\n";
+        }
+        return out;
+    }
+
+    std::string MetricsRegistry::GetLastError() const
+    {
+        const std::lock_guard lock(mutex);
+        return lastError;
+    }
+
+    bool MetricsRegistry::Lookup(const std::string &name, MetricType type, const Entry *&existing)
+    {
+        existing = nullptr;
+        if (!IsValidName(name))
+        {
+            lastError = "Invalid metric name: " + name;
+            return false;
+        }
+
+        const auto found = std::ranges::find(entries, name, &Entry::name);
+        if (found == entries.end())
+        {
+            return true;
+        }
+        if (found->type != type)
+        {
+            lastError = "Metric registered with another type: " + name;
+            return false;
+        }
+
+        existing = &*found;
+        return true;
+    }
+
+    AudioStreamMetrics AudioStreamMetrics::Register(MetricsRegistry &registry, const std::string &prefix)
+    {
+        AudioStreamMetrics metrics;
+        metrics.callbacks = registry.AddCounter(prefix + "_callbacks_total", "Audio callbacks processed");
+        metrics.xruns =
+            registry.AddCounter(prefix + "_xruns_total", "Callbacks reporting an input overflow or output underflow");
+        metrics.callbackLoad = registry.AddHistogram(prefix + "_callback_load",
+            "Callback processing time as a fraction of the buffer period",
+            { 0.1, 0.25, 0.5, 0.75, 0.9, 1.0, 1.5 });
+        metrics.lastCallbackLoad =
+            registry.AddGauge(prefix + "_callback_load_last", "Load of the most recent callback");
+        return metrics;
+    }
+
+    void AudioStreamMetrics::RecordCallback(double load, bool xrun) const
+    {
+        if (callbacks != nullptr)
+        {
+            callbacks->Increment();
+        }
+        if (xrun && xruns != nullptr)
+        {
+            xruns->Increment();
+        }
+        if (callbackLoad != nullptr)
+        {
+            callbackLoad->Observe(load);
+        }
+        if (lastCallbackLoad != nullptr)
+        {
+            lastCallbackLoad->Set(load);
+        }
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,215 @@
+#include "MetricsServer.h"
+#include <cstring>
+
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MACOS)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define GUITAR_IO_HAS_SOCKETS 1
+#endif
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr int ACCEPT_POLL_TIMEOUT_MS = 50; ///< Server thread wakeup period
+        constexpr int REQUEST_TIMEOUT_MS = 1000;   ///< Longest wait for a client's request
+        constexpr size_t MAX_REQUEST_BYTES = 8192; ///< Larger request heads are rejected
+
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        void SendAll(int fd, const std::string &data)
+        {
+            size_t sent = 0;
+            while (sent < data.size())
+            {
+                const ssize_t result = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                if (result <= 0)
+                {
+                    return;
+                }
+                sent += static_cast<size_t>(result);
+            }
+        }
+
+        std::string MakeResponse(const char *status, const char *contentType, const std::string &body)
+        {
+            return std::string("HTTP/1.1 ") + status + "\r\nContent-Type: " + contentType
+                + "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+        }
+#endif
+    } // namespace
+
+    MetricsServer::MetricsServer(const MetricsRegistry &registry) : registry(registry)
+    {
+    }
+
+    MetricsServer::~MetricsServer()
+    {
+        Stop();
+    }
+
+    bool MetricsServer::Start([[maybe_unused]] uint16_t localPort, [[maybe_unused]] const std::string &address)
+    {
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        if (running.load())
+        {
+            lastError = "Server already running";
+            return false;
+        }
+
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = htons(localPort);
+        if (::inet_pton(AF_INET, address.c_str(), &local.sin_addr) != 1)
+        {
+            lastError = "Invalid address: " + address;
+            return false;
+        }
+
+        socketFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (socketFd < 0)
+        {
+            lastError = "Failed to create socket";
+            return false;
+        }
+
+        const int reuse = 1;
+        ::setsockopt(socketFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        if (::bind(socketFd, reinterpret_cast<const sockaddr *>(&local), sizeof(local)) != 0
+            || ::listen(socketFd, 4) != 0)
+        {
+            lastError = "Failed to listen on " + address + ":" + std::to_string(localPort);
+            ::close(socketFd);
+            socketFd = -1;
+            return false;
+        }
+
+        socklen_t length = sizeof(local);
+        ::getsockname(socketFd, reinterpret_cast<sockaddr *>(&local), &length);
+        port = ntohs(local.sin_port);
+
+        running.store(true);
+        thread = std::thread(&MetricsServer::ServeLoop, this);
+        return true;
+#else
+        lastError = "Metrics server is not supported on this platform";
+        return false;
+#endif
+    }
+
+    void MetricsServer::Stop()
+    {
+        running.store(false);
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        if (socketFd >= 0)
+        {
+            ::close(socketFd);
+            socketFd = -1;
+        }
+#endif
+    }
+
+    bool MetricsServer::IsRunning() const
+    {
+        return running.load();
+    }
+
+    uint16_t MetricsServer::GetPort() const
+    {
+        return port;
+    }
+
+    uint64_t MetricsServer::GetRequestCount() const
+    {
+        return requests.load(std::memory_order_relaxed);
+    }
+
+    std::string MetricsServer::GetLastError() const
+    {
+        return lastError;
+    }
+
+    void MetricsServer::ServeLoop()
+    {
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        pollfd pollFd{ socketFd, POLLIN, 0 };
+        while (running.load(std::memory_order_acquire))
+        {
+            if (::poll(&pollFd, 1, ACCEPT_POLL_TIMEOUT_MS) <= 0)
+            {
+                continue;
+            }
+
+            const int clientFd = ::accept(socketFd, nullptr, nullptr);
+            if (clientFd < 0)
+            {
+                continue;
+            }
+
+            HandleClient(clientFd);
+            ::close(clientFd);
+        }
+#endif
+    }
+
+    void MetricsServer::HandleClient([[maybe_unused]] int clientFd)
+    {
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        // Read until the end of the request head; the body (if any) is ignored
+        std::string request;
+        char chunk[1024];
+        pollfd pollFd{ clientFd, POLLIN, 0 };
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES)
+        {
+            if (::poll(&pollFd, 1, REQUEST_TIMEOUT_MS) <= 0)
+            {
+                return;
+            }
+
+            const ssize_t received = ::recv(clientFd, chunk, sizeof(chunk), 0);
+            if (received <= 0)
+            {
+                return;
+            }
+            request.append(chunk, static_cast<size_t>(received));
+        }
+
+        const size_t lineEnd = request.find("\r\n");
+        const std::string requestLine = request.substr(0, lineEnd);
+        const size_t methodEnd = requestLine.find(' ');
+        const size_t pathEnd = requestLine.find(' ', methodEnd + 1);
+        if (methodEnd == std::string::npos || pathEnd == std::string::npos)
+        {
+            SendAll(clientFd, MakeResponse("400 Bad Request", "text/plain", "Bad request\n"));
+            return;
+        }
+
+        const std::string method = requestLine.substr(0, methodEnd);
+        std::string path = requestLine.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+        path = path.substr(0, path.find('?'));
+
+        if (method != "GET")
+        {
+            SendAll(clientFd, MakeResponse("405 Method Not Allowed", "text/plain", "Only GET is supported\n"));
+            return;
+        }
+        if (path != "/metrics")
+        {
+            SendAll(clientFd, MakeResponse("404 Not Found", "text/plain", "Metrics are served at /metrics\n"));
+            return;
+        }
+
+        SendAll(clientFd, MakeResponse("200 OK", "text/plain; version=0.0.4", registry.ExportPrometheus()));
+        requests.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,323 @@
+#include "ModulatedDelay.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        // Keeps every read at least this far behind the write head; a feedback run of
+        // (delay - 2) frames then never reaches an unwritten sample with any interpolation
+        constexpr float MIN_DELAY_FRAMES = 3.0f;
+        constexpr float MAX_FEEDBACK = 0.95f;
+        constexpr double SILENCE = 1e-3; // -60 dB
+    } // namespace
+
+    ModulatedDelay::ModulatedDelay(const ModulatedDelaySettings &settings)
+        : rateHz(settings.rateHz), delayMs(settings.delayMs), depthMs(settings.depthMs),
+          feedback(std::clamp(settings.feedback, -MAX_FEEDBACK, MAX_FEEDBACK)),
+          mix(std::clamp(settings.mix, 0.0f, 1.0f)), settings(settings), voices(std::max(1u, settings.voices))
+    {
+    }
+
+    bool ModulatedDelay::Prepare(const ProcessSpec &spec)
+    {
+        maxSampleRate = spec.GetMaxSampleRate();
+        if (maxSampleRate <= 0.0 || spec.channels == 0 || settings.maxDelayMs <= 0.0f)
+        {
+            lastError = "Invalid stream format";
+            return false;
+        }
+
+        const auto maxDelayFrames =
+            static_cast<uint32_t>(std::ceil(settings.maxDelayMs * 0.001 * maxSampleRate + MIN_DELAY_FRAMES));
+
+        channels = spec.channels;
+        lines.resize(channels);
+        for (DelayLine &line : lines)
+        {
+            if (!line.Prepare(maxDelayFrames, CONTROL_INTERVAL))
+            {
+                lastError = "Delay too long: " + std::to_string(settings.maxDelayMs) + " ms";
+                return false;
+            }
+        }
+
+        taps.clear();
+        for (uint32_t channel = 0; channel < channels; ++channel)
+        {
+            for (uint32_t voice = 0; voice < voices; ++voice)
+            {
+                Tap &tap = taps.emplace_back();
+                tap.lfo.SetShape(settings.shape);
+                tap.lfo.SetRate(rateHz.load(std::memory_order_relaxed));
+                const double phase = static_cast<double>(voice) / voices + channel * settings.stereoPhase;
+                tap.startPhase = phase - std::floor(phase);
+            }
+        }
+
+        delays.assign(static_cast<size_t>(voices) * CONTROL_INTERVAL, 0.0f);
+        dry.assign(CONTROL_INTERVAL, 0.0f);
+        wet.assign(CONTROL_INTERVAL, 0.0f);
+        tapOutput.assign(CONTROL_INTERVAL, 0.0f);
+        shifted.assign(CONTROL_INTERVAL, 0.0f);
+
+        appliedSampleRate = 0.0;
+        SetSampleRate(spec.sampleRate);
+        Reset();
+        return true;
+    }
+
+    void ModulatedDelay::SetSampleRate(double newSampleRate)
+    {
+        sampleRate.store(std::min(newSampleRate, maxSampleRate), std::memory_order_relaxed);
+    }
+
+    void ModulatedDelay::Process(std::span<float> buffer, uint32_t bufferChannels)
+    {
+        if (bufferChannels != channels || lines.empty())
+        {
+            return;
+        }
+
+        ApplySampleRate();
+        const float currentFeedback = feedback.load(std::memory_order_relaxed);
+        const float currentMix = mix.load(std::memory_order_relaxed);
+        const size_t frames = buffer.size() / channels;
+
+        // Chunks end at control period boundaries, which carry over from the previous block
+        size_t count = 0;
+        for (size_t offset = 0; offset < frames; offset += count)
+        {
+            count = std::min<size_t>(CONTROL_INTERVAL - periodPosition, frames - offset);
+            float *const block = buffer.data() + offset * channels;
+
+            for (uint32_t channel = 0; channel < channels; ++channel)
+            {
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    dry[i] = block[i * channels + channel];
+                }
+
+                const float minDelay = ComputeDelays(channel, static_cast<uint32_t>(count));
+                RenderChannel(channel, static_cast<uint32_t>(count), currentFeedback, minDelay);
+
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    block[i * channels + channel] = dry[i] + currentMix * (wet[i] - dry[i]);
+                }
+            }
+
+            periodPosition = (periodPosition + static_cast<uint32_t>(count)) % CONTROL_INTERVAL;
+        }
+    }
+
+    void ModulatedDelay::Reset()
+    {
+        for (DelayLine &line : lines)
+        {
+            line.Reset();
+        }
+
+        for (Tap &tap : taps)
+        {
+            tap.lfo.SetPhase(tap.startPhase);
+            tap.target = -1.0f;
+            tap.allpassState = 0.0f;
+        }
+        periodPosition = 0;
+    }
+
+    uint32_t ModulatedDelay::GetTailFrames() const
+    {
+        if (lines.empty())
+        {
+            return 0;
+        }
+
+        const double longest = lines.front().GetMaxDelayFrames();
+        const double gain = std::fabs(feedback.load(std::memory_order_relaxed));
+        const double repeats = gain > 0.0 ? std::ceil(std::log(SILENCE) / std::log(gain)) + 1.0 : 1.0;
+        return static_cast<uint32_t>(std::min(longest * repeats, static_cast<double>(TAIL_INFINITE - 1)));
+    }
+
+    void ModulatedDelay::SetRate(float newRateHz)
+    {
+        rateHz.store(newRateHz, std::memory_order_relaxed);
+        for (Tap &tap : taps)
+        {
+            tap.lfo.SetRate(newRateHz);
+        }
+    }
+
+    void ModulatedDelay::SetDelay(float newDelayMs)
+    {
+        delayMs.store(newDelayMs, std::memory_order_relaxed);
+    }
+
+    void ModulatedDelay::SetDepth(float newDepthMs)
+    {
+        depthMs.store(newDepthMs, std::memory_order_relaxed);
+    }
+
+    void ModulatedDelay::SetFeedback(float newFeedback)
+    {
+        feedback.store(std::clamp(newFeedback, -MAX_FEEDBACK, MAX_FEEDBACK), std::memory_order_relaxed);
+    }
+
+    void ModulatedDelay::SetMix(float newMix)
+    {
+        mix.store(std::clamp(newMix, 0.0f, 1.0f), std::memory_order_relaxed);
+    }
+
+    std::string ModulatedDelay::GetLastError() const
+    {
+        return lastError;
+    }
+
+    void ModulatedDelay::ApplySampleRate()
+    {
+        const double rate = sampleRate.load(std::memory_order_relaxed);
+        if (rate == appliedSampleRate)
+        {
+            return;
+        }
+
+        appliedSampleRate = rate;
+        for (Tap &tap : taps)
+        {
+            tap.lfo.Prepare(rate, CONTROL_INTERVAL);
+        }
+    }
+
+    float ModulatedDelay::ComputeDelays(uint32_t channel, uint32_t frames)
+    {
+        const auto longest = static_cast<float>(lines[channel].GetMaxDelayFrames());
+        float minDelay = longest;
+
+        for (uint32_t voice = 0; voice < voices; ++voice)
+        {
+            Tap &tap = taps[static_cast<size_t>(channel) * voices + voice];
+            if (periodPosition == 0)
+            {
+                const auto framesPerMs = static_cast<float>(appliedSampleRate * 0.001);
+                const float centre = delayMs.load(std::memory_order_relaxed) * framesPerMs;
+                const float depth = depthMs.load(std::memory_order_relaxed) * framesPerMs;
+                const float next = std::clamp(centre + depth * tap.lfo.Tick(), MIN_DELAY_FRAMES, longest);
+                tap.start = tap.target < 0.0f ? next : tap.target;
+                tap.target = next;
+            }
+
+            // The ramp reaches the target at the end of the period, however it is chunked
+            const float slope = (tap.target - tap.start) / static_cast<float>(CONTROL_INTERVAL);
+            const float first = tap.start + slope * static_cast<float>(periodPosition);
+            float *const ramp = delays.data() + static_cast<size_t>(voice) * CONTROL_INTERVAL;
+            for (uint32_t i = 0; i < frames; ++i)
+            {
+                ramp[i] = first + slope * static_cast<float>(i + 1);
+            }
+            minDelay = std::min({ minDelay, first, ramp[frames - 1] });
+        }
+        return minDelay;
+    }
+
+    void ModulatedDelay::RenderChannel(uint32_t channel, uint32_t frames, float currentFeedback, float minDelay)
+    {
+        DelayLine &line = lines[channel];
+        const float voiceGain = 1.0f / static_cast<float>(voices);
+        std::fill_n(wet.begin(), frames, 0.0f);
+
+        if (currentFeedback == 0.0f)
+        {
+            line.Write(std::span<const float>(dry).first(frames));
+            for (uint32_t voice = 0; voice < voices; ++voice)
+            {
+                Tap &tap = taps[static_cast<size_t>(channel) * voices + voice];
+                const float *start = delays.data() + static_cast<size_t>(voice) * CONTROL_INTERVAL;
+                const std::span<const float> ramp(start, frames);
+                const std::span<float> output = std::span<float>(tapOutput).first(frames);
+                line.Read(ramp, output, settings.interpolation, tap.allpassState);
+                for (uint32_t i = 0; i < frames; ++i)
+                {
+                    wet[i] += voiceGain * output[i];
+                }
+            }
+            return;
+        }
+
+        // Read each run before writing it; runs stay 2 frames shorter than the smallest delay
+        const uint32_t run = std::max(1u, static_cast<uint32_t>(minDelay) - 2);
+        for (uint32_t start = 0; start < frames; start += run)
+        {
+            const uint32_t length = std::min(run, frames - start);
+            const std::span<float> rebased = std::span<float>(shifted).first(length);
+            const std::span<float> output = std::span<float>(tapOutput).first(length);
+
+            for (uint32_t voice = 0; voice < voices; ++voice)
+            {
+                Tap &tap = taps[static_cast<size_t>(channel) * voices + voice];
+                const float *ramp = delays.data() + static_cast<size_t>(voice) * CONTROL_INTERVAL + start;
+                for (uint32_t i = 0; i < length; ++i)
+                {
+                    rebased[i] = ramp[i] - static_cast<float>(length);
+                }
+
+                line.Read(rebased, output, settings.interpolation, tap.allpassState);
+                for (uint32_t i = 0; i < length; ++i)
+                {
+                    wet[start + i] += voiceGain * output[i];
+                }
+            }
+
+            for (uint32_t i = 0; i < length; ++i)
+            {
+                output[i] = dry[start + i] + currentFeedback * wet[start + i];
+            }
+            line.Write(output);
+        }
+    }
+
+    ModulatedDelaySettings Chorus::DefaultSettings()
+    {
+        ModulatedDelaySettings defaults;
+        defaults.voices = 3;
+        return defaults;
+    }
+
+    Chorus::Chorus(const ModulatedDelaySettings &settings) : ModulatedDelay(settings)
+    {
+    }
+
+    ModulatedDelaySettings Flanger::DefaultSettings()
+    {
+        ModulatedDelaySettings defaults;
+        defaults.delayMs = 2.5f;
+        defaults.depthMs = 2.0f;
+        defaults.rateHz = 0.2f;
+        defaults.feedback = 0.6f;
+        defaults.maxDelayMs = 20.0f;
+        defaults.shape = Lfo::Shape::Triangle;
+        return defaults;
+    }
+
+    Flanger::Flanger(const ModulatedDelaySettings &settings) : ModulatedDelay(settings)
+    {
+    }
+
+    ModulatedDelaySettings Vibrato::DefaultSettings()
+    {
+        ModulatedDelaySettings defaults;
+        defaults.delayMs = 4.0f;
+        defaults.depthMs = 3.0f;
+        defaults.rateHz = 5.0f;
+        defaults.mix = 1.0f;
+        defaults.maxDelayMs = 20.0f;
+        defaults.stereoPhase = 0.0f;
+        return defaults;
+    }
+
+    Vibrato::Vibrato(const ModulatedDelaySettings &settings) : ModulatedDelay(settings)
+    {
+    }
+
+} // namespace GuitarIO
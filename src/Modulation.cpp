@@ -0,0 +1,258 @@
+#include "Modulation.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace GuitarIO
+{
+    Lfo::Lfo(float rateHz, Shape shape) : rate(rateHz), shape(shape)
+    {
+    }
+
+    void Lfo::Prepare(double sampleRate, uint32_t controlInterval)
+    {
+        periodSeconds = sampleRate > 0.0 ? static_cast<double>(controlInterval) / sampleRate : 0.0;
+    }
+
+    float Lfo::Tick()
+    {
+        const double current = phase;
+        phase += static_cast<double>(rate.load(std::memory_order_relaxed)) * periodSeconds;
+        phase -= std::floor(phase);
+
+        switch (shape.load(std::memory_order_relaxed))
+        {
+        case Shape::Sine:
+            return static_cast<float>(std::sin(2.0 * std::numbers::pi * current));
+        case Shape::Triangle:
+            return static_cast<float>(1.0 - 4.0 * std::fabs(current - 0.5));
+        case Shape::Square:
+            return current < 0.5 ? 1.0f : -1.0f;
+        case Shape::Saw:
+            return static_cast<float>(2.0 * current - 1.0);
+        }
+
+        return 0.0f;
+    }
+
+    void Lfo::Reset()
+    {
+        phase = 0.0;
+    }
+
+    void Lfo::SetRate(float rateHz)
+    {
+        rate.store(rateHz, std::memory_order_relaxed);
+    }
+
+    void Lfo::SetShape(Shape newShape)
+    {
+        shape.store(newShape, std::memory_order_relaxed);
+    }
+
+    void Lfo::SetPhase(double newPhase)
+    {
+        phase = newPhase - std::floor(newPhase);
+    }
+
+    double Lfo::GetPhase() const
+    {
+        return phase;
+    }
+
+    Envelope::Envelope(const EnvelopeSettings &settings) : settings(settings)
+    {
+    }
+
+    void Envelope::Prepare(double sampleRate, uint32_t controlInterval)
+    {
+        const double periodMs = sampleRate > 0.0 ? 1000.0 * controlInterval / sampleRate : 0.0;
+        const auto step = [periodMs](float milliseconds, float distance) {
+            return milliseconds > 0.0f ? static_cast<float>(distance * periodMs / milliseconds) : distance;
+        };
+
+        const float sustain = std::clamp(settings.sustain, 0.0f, 1.0f);
+        attackStep = step(settings.attackMs, 1.0f);
+        decayStep = std::max(step(settings.decayMs, 1.0f - sustain), 1e-9f);
+        releaseStep = step(settings.releaseMs, 1.0f);
+    }
+
+    float Envelope::Tick()
+    {
+        const uint32_t currentNoteOns = noteOns.load(std::memory_order_acquire);
+        if (currentNoteOns != seenNoteOns)
+        {
+            seenNoteOns = currentNoteOns;
+            stage = Stage::Attack;
+        }
+        else if (!gate.load(std::memory_order_relaxed) && stage != Stage::Idle)
+        {
+            stage = Stage::Release;
+        }
+
+        const float sustain = std::clamp(settings.sustain, 0.0f, 1.0f);
+        switch (stage)
+        {
+        case Stage::Idle:
+            break;
+        case Stage::Attack:
+            level = std::min(level + attackStep, 1.0f);
+            if (level >= 1.0f)
+            {
+                stage = Stage::Decay;
+            }
+            break;
+        case Stage::Decay:
+            level = std::max(level - decayStep, sustain);
+            if (level <= sustain)
+            {
+                stage = Stage::Sustain;
+            }
+            break;
+        case Stage::Sustain:
+            level = sustain;
+            break;
+        case Stage::Release:
+            level = std::max(level - releaseStep, 0.0f);
+            if (level <= 0.0f)
+            {
+                stage = Stage::Idle;
+            }
+            break;
+        }
+
+        return level;
+    }
+
+    void Envelope::Reset()
+    {
+        seenNoteOns = noteOns.load(std::memory_order_acquire);
+        stage = Stage::Idle;
+        level = 0.0f;
+    }
+
+    void Envelope::NoteOn()
+    {
+        gate.store(true, std::memory_order_relaxed);
+        noteOns.fetch_add(1, std::memory_order_release);
+    }
+
+    void Envelope::NoteOff()
+    {
+        gate.store(false, std::memory_order_relaxed);
+    }
+
+    bool Envelope::IsActive() const
+    {
+        return stage != Stage::Idle;
+    }
+
+    size_t ModulationMatrix::AddRoute(ModulationSource &source, SmoothedParameter &destination, float depth)
+    {
+        auto sourceSlot = std::find_if(
+            sources.begin(), sources.end(), [&source](const SourceSlot &slot) { return slot.source == &source; });
+        if (sourceSlot == sources.end())
+        {
+            sources.push_back({ &source });
+            sourceSlot = sources.end() - 1;
+        }
+
+        auto destinationSlot = std::find_if(destinations.begin(),
+            destinations.end(),
+            [&destination](const DestinationSlot &slot) { return slot.parameter == &destination; });
+        if (destinationSlot == destinations.end())
+        {
+            destinations.push_back({ &destination });
+            destinationSlot = destinations.end() - 1;
+        }
+
+        Route &route = routes.emplace_back();
+        route.source = static_cast<size_t>(sourceSlot - sources.begin());
+        route.destination = static_cast<size_t>(destinationSlot - destinations.begin());
+        route.depth.store(depth, std::memory_order_relaxed);
+        route.appliedDepth = depth;
+        destinationSlot->dirty = true;
+        return routes.size() - 1;
+    }
+
+    void ModulationMatrix::SetDepth(size_t route, float depth)
+    {
+        if (route < routes.size())
+        {
+            routes[route].depth.store(depth, std::memory_order_relaxed);
+        }
+    }
+
+    void ModulationMatrix::Prepare(double sampleRate, uint32_t controlInterval)
+    {
+        for (SourceSlot &slot : sources)
+        {
+            slot.source->Prepare(sampleRate, controlInterval);
+        }
+
+        for (DestinationSlot &slot : destinations)
+        {
+            slot.dirty = true;
+        }
+    }
+
+    void ModulationMatrix::Tick()
+    {
+        for (SourceSlot &slot : sources)
+        {
+            const float value = slot.source->Tick();
+            slot.changed = value != slot.value;
+            slot.value = value;
+        }
+
+        for (Route &route : routes)
+        {
+            const float depth = route.depth.load(std::memory_order_relaxed);
+            if (sources[route.source].changed || depth != route.appliedDepth)
+            {
+                route.appliedDepth = depth;
+                destinations[route.destination].dirty = true;
+            }
+        }
+
+        // Second pass sums every route of a dirty destination; routes per destination are few
+        for (size_t index = 0; index < destinations.size(); ++index)
+        {
+            DestinationSlot &slot = destinations[index];
+            if (!slot.dirty)
+            {
+                continue;
+            }
+
+            float offset = 0.0f;
+            for (const Route &route : routes)
+            {
+                if (route.destination == index)
+                {
+                    offset += sources[route.source].value * route.appliedDepth;
+                }
+            }
+
+            slot.parameter->SetModulation(offset);
+            slot.dirty = false;
+        }
+    }
+
+    void ModulationMatrix::Clear()
+    {
+        for (DestinationSlot &slot : destinations)
+        {
+            slot.parameter->SetModulation(0.0f);
+        }
+
+        routes.clear();
+        sources.clear();
+        destinations.clear();
+    }
+
+    size_t ModulationMatrix::GetRouteCount() const
+    {
+        return routes.size();
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,237 @@
+#include "MultiRateChain.h"
+#include <algorithm>
+#include <map>
+
+namespace GuitarIO
+{
+    size_t MultiRateChain::AddDomain(const RateDomainConfig &config, ProcessorChain chain)
+    {
+        Domain &domain = domains.emplace_back();
+        domain.config = config;
+        domain.chain = std::move(chain);
+        return domains.size() - 1;
+    }
+
+    bool MultiRateChain::Prepare(double newSampleRate, uint32_t newBlockSize, uint32_t newChannels)
+    {
+        if (newSampleRate <= 0.0 || newBlockSize == 0 || newChannels == 0)
+        {
+            lastError = "Invalid stream format";
+            return false;
+        }
+
+        // Analysis domains sharing a cadence are spread over the callbacks of one cycle
+        std::map<size_t, size_t> cadenceSlots;
+
+        for (size_t i = 0; i < domains.size(); ++i)
+        {
+            Domain &domain = domains[i];
+            const uint32_t divisor = domain.config.divisor;
+            if (divisor == 0 || newBlockSize % divisor != 0)
+            {
+                lastError = "Domain " + std::to_string(i) + ": divisor must divide the block size";
+                return false;
+            }
+
+            const size_t callbackFrames = newBlockSize / divisor;
+            size_t blockFrames = callbackFrames;
+            if (!domain.config.feedsOutput && domain.config.blockFrames != 0)
+            {
+                blockFrames = domain.config.blockFrames;
+                if (blockFrames % callbackFrames != 0)
+                {
+                    lastError = "Domain " + std::to_string(i) + ": blockFrames must be a multiple of "
+                                + std::to_string(callbackFrames);
+                    return false;
+                }
+            }
+
+            domain.decimator.Prepare(divisor, newChannels);
+            domain.interpolator.Prepare(divisor, newChannels);
+            domain.buffer.assign(blockFrames * newChannels, 0.0f);
+            domain.queued.assign(domain.config.feedsOutput ? (callbackFrames + 1) * divisor * newChannels : 0, 0.0f);
+            domain.queuedFrames = domain.config.feedsOutput ? divisor - 1 : 0;
+
+            const size_t callbacksPerRun = blockFrames / callbackFrames;
+            const size_t slot = cadenceSlots[callbacksPerRun]++ % callbacksPerRun;
+            domain.staggerFrames = slot * callbackFrames;
+            domain.filled = domain.staggerFrames;
+        }
+
+        decimated.assign(static_cast<size_t>(newBlockSize) * newChannels, 0.0f);
+        sampleRate = newSampleRate;
+        blockSize = newBlockSize;
+        channels = newChannels;
+        return true;
+    }
+
+    bool MultiRateChain::Prepare(const ProcessSpec &spec)
+    {
+        if (!Prepare(spec.sampleRate, spec.maxBlockFrames, spec.channels))
+        {
+            return false;
+        }
+
+        maxSampleRate = spec.GetMaxSampleRate();
+
+        bool prepared = true;
+        for (Domain &domain : domains)
+        {
+            ProcessSpec domainSpec = spec;
+            domainSpec.sampleRate = spec.sampleRate / domain.config.divisor;
+            domainSpec.maxSampleRate = maxSampleRate / domain.config.divisor;
+            domainSpec.maxBlockFrames = static_cast<uint32_t>(domain.buffer.size() / channels);
+            prepared = domain.chain.Prepare(domainSpec) && prepared;
+        }
+
+        if (!prepared)
+        {
+            lastError = "A domain processor rejected its stream format";
+        }
+        return prepared;
+    }
+
+    void MultiRateChain::SetSampleRate(double newSampleRate)
+    {
+        sampleRate = maxSampleRate > 0.0 ? std::min(newSampleRate, maxSampleRate) : newSampleRate;
+        for (Domain &domain : domains)
+        {
+            domain.chain.SetSampleRate(sampleRate / domain.config.divisor);
+        }
+    }
+
+    void MultiRateChain::Process(std::span<float> buffer, uint32_t bufferChannels)
+    {
+        if (bufferChannels != channels || blockSize == 0)
+        {
+            return;
+        }
+
+        const size_t maxSamples = static_cast<size_t>(blockSize) * channels;
+        for (size_t offset = 0; offset < buffer.size(); offset += maxSamples)
+        {
+            ProcessBlock(buffer.subspan(offset, std::min(maxSamples, buffer.size() - offset)));
+        }
+    }
+
+    void MultiRateChain::Reset()
+    {
+        for (Domain &domain : domains)
+        {
+            domain.chain.Reset();
+            domain.decimator.Reset();
+            domain.interpolator.Reset();
+            std::fill(domain.buffer.begin(), domain.buffer.end(), 0.0f);
+            std::fill(domain.queued.begin(), domain.queued.end(), 0.0f);
+            domain.queuedFrames = domain.config.feedsOutput ? domain.config.divisor - 1 : 0;
+            domain.filled = domain.staggerFrames;
+        }
+    }
+
+    size_t MultiRateChain::GetDomainCount() const
+    {
+        return domains.size();
+    }
+
+    ProcessorChain *MultiRateChain::GetChain(size_t index)
+    {
+        return index < domains.size() ? &domains[index].chain : nullptr;
+    }
+
+    double MultiRateChain::GetDomainSampleRate(size_t index) const
+    {
+        return index < domains.size() && domains[index].config.divisor > 0
+                   ? sampleRate / domains[index].config.divisor
+                   : 0.0;
+    }
+
+    uint32_t MultiRateChain::GetLatencyFrames() const
+    {
+        uint32_t latency = 0;
+        for (const Domain &domain : domains)
+        {
+            if (!domain.config.feedsOutput)
+            {
+                continue;
+            }
+
+            latency += domain.chain.GetLatencyFrames() * domain.config.divisor;
+            if (domain.config.divisor > 1)
+            {
+                latency += domain.decimator.GetLatencySamples() + domain.interpolator.GetLatencySamples()
+                           + domain.config.divisor - 1;
+            }
+        }
+        return latency;
+    }
+
+    std::string MultiRateChain::GetLastError() const
+    {
+        return lastError;
+    }
+
+    void MultiRateChain::ProcessBlock(std::span<float> block)
+    {
+        for (Domain &domain : domains)
+        {
+            if (!domain.config.feedsOutput)
+            {
+                ProcessAnalysisDomain(domain, block);
+            }
+            else if (domain.config.divisor == 1)
+            {
+                domain.chain.Process(block, channels);
+            }
+            else
+            {
+                ProcessOutputDomain(domain, block);
+            }
+        }
+    }
+
+    void MultiRateChain::ProcessOutputDomain(Domain &domain, std::span<float> block)
+    {
+        // The decimator carries its phase across blocks, so a block ending part way through a
+        // group yields only the completed groups. Their interpolated frames queue behind the
+        // divisor - 1 frames held back at Prepare(); the queue then always holds a full block
+        const size_t frames = domain.decimator.Process(block, domain.buffer);
+        if (frames > 0)
+        {
+            const std::span<float> low = std::span<float>(domain.buffer).first(frames * channels);
+            domain.chain.Process(low, channels);
+            const std::span<float> tail = std::span<float>(domain.queued).subspan(domain.queuedFrames * channels);
+            domain.queuedFrames += domain.interpolator.Process(low, tail);
+        }
+
+        const size_t ready = std::min(block.size() / channels, domain.queuedFrames);
+        const auto readyEnd = domain.queued.begin() + static_cast<std::ptrdiff_t>(ready * channels);
+        std::copy(domain.queued.begin(), readyEnd, block.begin());
+        std::copy(readyEnd,
+            domain.queued.begin() + static_cast<std::ptrdiff_t>(domain.queuedFrames * channels),
+            domain.queued.begin());
+        domain.queuedFrames -= ready;
+    }
+
+    void MultiRateChain::ProcessAnalysisDomain(Domain &domain, std::span<const float> block)
+    {
+        const size_t frames = domain.decimator.Process(block, decimated);
+        const size_t capacity = domain.buffer.size() / channels;
+
+        for (size_t done = 0; done < frames;)
+        {
+            const size_t count = std::min(capacity - domain.filled, frames - done);
+            std::copy_n(decimated.begin() + static_cast<std::ptrdiff_t>(done * channels),
+                count * channels,
+                domain.buffer.begin() + static_cast<std::ptrdiff_t>(domain.filled * channels));
+            domain.filled += count;
+            done += count;
+
+            if (domain.filled == capacity)
+            {
+                domain.chain.Process(domain.buffer, channels);
+                domain.filled = 0;
+            }
+        }
+    }
+
+} // namespace GuitarIO
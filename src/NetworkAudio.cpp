@@ -0,0 +1,273 @@
+#include "NetworkAudio.h"
+#include "MemoryAccounting.h"
+#include <cstring>
+
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MACOS)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define GUITAR_IO_HAS_SOCKETS 1
+#endif
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr int RECEIVE_POLL_TIMEOUT_MS = 50; ///< Receive thread wakeup period
+
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        bool MakeAddress(const std::string &address, uint16_t port, sockaddr_in &result)
+        {
+            std::memset(&result, 0, sizeof(result));
+            result.sin_family = AF_INET;
+            result.sin_port = htons(port);
+            return ::inet_pton(AF_INET, address.c_str(), &result.sin_addr) == 1;
+        }
+#endif
+    } // namespace
+
+    NetworkAudioReceiver::NetworkAudioReceiver(JitterBuffer &buffer) : buffer(buffer)
+    {
+    }
+
+    NetworkAudioReceiver::~NetworkAudioReceiver()
+    {
+        Close();
+    }
+
+    bool NetworkAudioReceiver::Open([[maybe_unused]] uint16_t localPort, [[maybe_unused]] const std::string &address)
+    {
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        if (socketFd >= 0)
+        {
+            lastError = "Receiver already open";
+            return false;
+        }
+
+        sockaddr_in local{};
+        if (!MakeAddress(address, localPort, local))
+        {
+            lastError = "Invalid address: " + address;
+            return false;
+        }
+
+        socketFd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (socketFd < 0)
+        {
+            lastError = "Failed to create socket";
+            return false;
+        }
+
+        if (::bind(socketFd, reinterpret_cast<const sockaddr *>(&local), sizeof(local)) != 0)
+        {
+            lastError = "Failed to bind " + address + ":" + std::to_string(localPort);
+            ::close(socketFd);
+            socketFd = -1;
+            return false;
+        }
+
+        socklen_t length = sizeof(local);
+        ::getsockname(socketFd, reinterpret_cast<sockaddr *>(&local), &length);
+        port = ntohs(local.sin_port);
+        return true;
+#else
+        lastError = "Network audio is not supported on this platform";
+        return false;
+#endif
+    }
+
+    bool NetworkAudioReceiver::Start()
+    {
+        if (socketFd < 0)
+        {
+            lastError = "Receiver not open";
+            return false;
+        }
+
+        if (running.exchange(true))
+        {
+            lastError = "Receiver already running";
+            return false;
+        }
+
+        thread = std::thread(&NetworkAudioReceiver::ReceiveLoop, this);
+        return true;
+    }
+
+    void NetworkAudioReceiver::Stop()
+    {
+        running.store(false);
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+
+    void NetworkAudioReceiver::Close()
+    {
+        Stop();
+
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        if (socketFd >= 0)
+        {
+            ::close(socketFd);
+            socketFd = -1;
+        }
+#endif
+    }
+
+    uint16_t NetworkAudioReceiver::GetPort() const
+    {
+        return port;
+    }
+
+    uint64_t NetworkAudioReceiver::GetMalformedPackets() const
+    {
+        return malformedPackets.load(std::memory_order_relaxed);
+    }
+
+    std::string NetworkAudioReceiver::GetLastError() const
+    {
+        return lastError;
+    }
+
+    void NetworkAudioReceiver::ReceiveLoop()
+    {
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        const JitterBufferConfig &config = buffer.GetConfig();
+        const size_t payloadSamples = static_cast<size_t>(config.packetFrames) * config.channels;
+
+        TaggedVector<char> packet(NetworkAudioPacket::MAX_SIZE);
+        TaggedVector<float> samples(payloadSamples);
+
+        pollfd pollFd{ socketFd, POLLIN, 0 };
+        while (running.load(std::memory_order_acquire))
+        {
+            if (::poll(&pollFd, 1, RECEIVE_POLL_TIMEOUT_MS) <= 0)
+            {
+                continue;
+            }
+
+            const ssize_t received = ::recv(socketFd, packet.data(), packet.size(), 0);
+            if (received < static_cast<ssize_t>(NetworkAudioPacket::HEADER_SIZE))
+            {
+                continue;
+            }
+
+            uint32_t magic = 0;
+            uint32_t sequence = 0;
+            uint16_t frames = 0;
+            uint16_t channels = 0;
+            std::memcpy(&magic, packet.data(), 4);
+            std::memcpy(&sequence, packet.data() + 4, 4);
+            std::memcpy(&frames, packet.data() + 8, 2);
+            std::memcpy(&channels, packet.data() + 10, 2);
+
+            const size_t payloadBytes = static_cast<size_t>(received) - NetworkAudioPacket::HEADER_SIZE;
+            if (ntohl(magic) != NetworkAudioPacket::MAGIC || ntohs(frames) != config.packetFrames
+                || ntohs(channels) != config.channels || payloadBytes != payloadSamples * sizeof(float))
+            {
+                malformedPackets.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            std::memcpy(samples.data(), packet.data() + NetworkAudioPacket::HEADER_SIZE, payloadBytes);
+            buffer.Insert(ntohl(sequence), samples);
+        }
+#endif
+    }
+
+    NetworkAudioSender::~NetworkAudioSender()
+    {
+        Close();
+    }
+
+    bool NetworkAudioSender::Open([[maybe_unused]] const std::string &address, [[maybe_unused]] uint16_t port)
+    {
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        sockaddr_in remote{};
+        if (!MakeAddress(address, port, remote))
+        {
+            lastError = "Invalid address: " + address;
+            return false;
+        }
+
+        Close();
+        socketFd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (socketFd < 0)
+        {
+            lastError = "Failed to create socket";
+            return false;
+        }
+
+        if (::connect(socketFd, reinterpret_cast<const sockaddr *>(&remote), sizeof(remote)) != 0)
+        {
+            lastError = "Failed to connect to " + address + ":" + std::to_string(port);
+            Close();
+            return false;
+        }
+
+        packet.resize(NetworkAudioPacket::MAX_SIZE);
+        return true;
+#else
+        lastError = "Network audio is not supported on this platform";
+        return false;
+#endif
+    }
+
+    bool NetworkAudioSender::Send([[maybe_unused]] uint32_t sequence,
+        [[maybe_unused]] std::span<const float> samples,
+        [[maybe_unused]] uint32_t channels)
+    {
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        const size_t payloadBytes = samples.size_bytes();
+        if (socketFd < 0 || channels == 0 || samples.size() % channels != 0
+            || NetworkAudioPacket::HEADER_SIZE + payloadBytes > packet.size())
+        {
+            lastError = "Invalid packet";
+            return false;
+        }
+
+        const uint32_t magic = htonl(NetworkAudioPacket::MAGIC);
+        const uint32_t sequenceField = htonl(sequence);
+        const uint16_t frames = htons(static_cast<uint16_t>(samples.size() / channels));
+        const uint16_t channelsField = htons(static_cast<uint16_t>(channels));
+        std::memcpy(packet.data(), &magic, 4);
+        std::memcpy(packet.data() + 4, &sequenceField, 4);
+        std::memcpy(packet.data() + 8, &frames, 2);
+        std::memcpy(packet.data() + 10, &channelsField, 2);
+        std::memcpy(packet.data() + NetworkAudioPacket::HEADER_SIZE, samples.data(), payloadBytes);
+
+        const size_t size = NetworkAudioPacket::HEADER_SIZE + payloadBytes;
+        if (::send(socketFd, packet.data(), size, 0) != static_cast<ssize_t>(size))
+        {
+            lastError = "Failed to send packet";
+            return false;
+        }
+
+        return true;
+#else
+        lastError = "Network audio is not supported on this platform";
+        return false;
+#endif
+    }
+
+    void NetworkAudioSender::Close()
+    {
+#if defined(GUITAR_IO_HAS_SOCKETS)
+        if (socketFd >= 0)
+        {
+            ::close(socketFd);
+            socketFd = -1;
+        }
+#endif
+    }
+
+    std::string NetworkAudioSender::GetLastError() const
+    {
+        return lastError;
+    }
+
+} // namespace GuitarIO
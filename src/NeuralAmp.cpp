@@ -0,0 +1,427 @@
+#include "NeuralAmp.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <bit>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        // Copies values into a zero-padded weight vector
+        void AssignPadded(TaggedVector<float, MemoryTag::Tables> &target, std::span<const float> values, size_t size)
+        {
+            target.assign(size, 0.0f);
+            std::ranges::copy(values, target.begin());
+        }
+
+        // Sequential reader over the flat model weights
+        class WeightCursor
+        {
+        public:
+            explicit WeightCursor(std::span<const float> weights) : weights(weights)
+            {
+            }
+
+            std::span<const float> Take(size_t count)
+            {
+                const std::span<const float> taken = weights.subspan(offset, count);
+                offset += count;
+                return taken;
+            }
+
+        private:
+            std::span<const float> weights; // Flat weights
+            size_t offset = 0;              // Next unread weight
+        };
+    } // namespace
+
+    bool NeuralAmp::SetModel(const NeuralModel &model)
+    {
+        if (model.GetWeights().empty())
+        {
+            lastError = "Model is empty";
+            return false;
+        }
+
+        spec = model.GetSpec();
+        stride = PackedMatrix::PadRows(spec.hiddenSize);
+        if (spec.architecture == NeuralArchitecture::ConvNet)
+        {
+            PackConvNet(model.GetWeights());
+        }
+        else
+        {
+            PackRecurrent(model.GetWeights());
+        }
+
+        hasModel = true;
+        AllocateState();
+        return true;
+    }
+
+    bool NeuralAmp::Prepare(const ProcessSpec &processSpec)
+    {
+        if (!hasModel)
+        {
+            lastError = "No model loaded";
+            return false;
+        }
+
+        if (processSpec.channels == 0 || processSpec.maxBlockFrames == 0)
+        {
+            lastError = "Invalid stream format";
+            return false;
+        }
+
+        channels = processSpec.channels;
+        maxBlockFrames = processSpec.maxBlockFrames;
+        AllocateState();
+        return true;
+    }
+
+    void NeuralAmp::Process(std::span<float> buffer, uint32_t bufferChannels)
+    {
+        if (!hasModel || bufferChannels != channels || states.empty())
+        {
+            return;
+        }
+
+        const size_t frames = buffer.size() / channels;
+        for (size_t offset = 0; offset < frames; offset += maxBlockFrames)
+        {
+            const size_t count = std::min<size_t>(maxBlockFrames, frames - offset);
+            for (uint32_t channel = 0; channel < channels; ++channel)
+            {
+                // Mono streams run in place; otherwise each channel goes through the mono scratch
+                const std::span<float> samples =
+                    channels == 1 ? buffer.subspan(offset, count) : std::span<float>(mono).first(count);
+                if (channels > 1)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        samples[i] = buffer[(offset + i) * channels + channel];
+                    }
+                }
+
+                switch (spec.architecture)
+                {
+                case NeuralArchitecture::Lstm:
+                    ProcessLstm(samples, states[channel]);
+                    break;
+                case NeuralArchitecture::Gru:
+                    ProcessGru(samples, states[channel]);
+                    break;
+                case NeuralArchitecture::ConvNet:
+                    ProcessConvNet(samples, states[channel]);
+                    break;
+                }
+
+                if (channels > 1)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        buffer[(offset + i) * channels + channel] = samples[i];
+                    }
+                }
+            }
+        }
+    }
+
+    void NeuralAmp::Reset()
+    {
+        for (ChannelState &state : states)
+        {
+            std::ranges::fill(state.hidden, 0.0f);
+            std::ranges::fill(state.cell, 0.0f);
+            for (TaggedVector<float> &ring : state.history)
+            {
+                std::ranges::fill(ring, 0.0f);
+            }
+            state.position = 0;
+        }
+    }
+
+    uint32_t NeuralAmp::GetTailFrames() const
+    {
+        if (!hasModel || spec.architecture != NeuralArchitecture::ConvNet)
+        {
+            return hasModel ? TAIL_INFINITE : 0;
+        }
+
+        uint32_t receptiveField = 0;
+        for (const ConvLayer &layer : layers)
+        {
+            receptiveField += (spec.kernelSize - 1) * layer.dilation;
+        }
+        return receptiveField;
+    }
+
+    std::string NeuralAmp::GetLastError() const
+    {
+        return lastError;
+    }
+
+    void NeuralAmp::PackRecurrent(std::span<const float> weights)
+    {
+        const size_t hidden = spec.hiddenSize;
+        const size_t gateRows = (spec.architecture == NeuralArchitecture::Lstm ? 4 : 3) * hidden;
+        const size_t paddedRows = PackedMatrix::PadRows(gateRows);
+
+        WeightCursor cursor(weights);
+        AssignPadded(inputWeights, cursor.Take(gateRows), paddedRows);
+        hiddenWeights.Pack(cursor.Take(gateRows * hidden), gateRows, hidden);
+        AssignPadded(inputBias, cursor.Take(gateRows), paddedRows);
+        AssignPadded(hiddenBias, cursor.Take(gateRows), paddedRows);
+
+        // The LSTM adds both biases to the same pre-activation, so they fold into one
+        if (spec.architecture == NeuralArchitecture::Lstm)
+        {
+            for (size_t row = 0; row < gateRows; ++row)
+            {
+                inputBias[row] += hiddenBias[row];
+            }
+            hiddenBias.clear();
+        }
+
+        AssignPadded(outputWeights, cursor.Take(hidden), stride);
+        outputBias = cursor.Take(1)[0];
+        layers.clear();
+    }
+
+    void NeuralAmp::PackConvNet(std::span<const float> weights)
+    {
+        const size_t width = spec.hiddenSize;
+        const size_t kernel = spec.kernelSize;
+
+        WeightCursor cursor(weights);
+        AssignPadded(inputWeights, cursor.Take(width), stride);
+
+        layers.clear();
+        layers.resize(spec.layers);
+        std::vector<float> tap(width * width);
+        for (size_t index = 0; index < layers.size(); ++index)
+        {
+            ConvLayer &layer = layers[index];
+            layer.dilation = 1u << index;
+
+            // PyTorch stores Conv1d weights [out][in][tap]; each tap becomes its own out x in matrix
+            const std::span<const float> conv = cursor.Take(width * width * kernel);
+            layer.taps.resize(kernel);
+            for (size_t k = 0; k < kernel; ++k)
+            {
+                for (size_t element = 0; element < width * width; ++element)
+                {
+                    tap[element] = conv[element * kernel + k];
+                }
+                layer.taps[k].Pack(tap, width, width);
+            }
+
+            AssignPadded(layer.convBias, cursor.Take(width), stride);
+            layer.residual.Pack(cursor.Take(width * width), width, width);
+            AssignPadded(layer.residualBias, cursor.Take(width), stride);
+        }
+
+        AssignPadded(outputWeights, cursor.Take(width), stride);
+        outputBias = cursor.Take(1)[0];
+        hiddenWeights = {};
+        inputBias.clear();
+        hiddenBias.clear();
+    }
+
+    void NeuralAmp::AllocateState()
+    {
+        if (!hasModel || channels == 0)
+        {
+            return;
+        }
+
+        const size_t gateRows = hiddenWeights.GetPaddedRows();
+        states.assign(channels, {});
+        for (ChannelState &state : states)
+        {
+            state.hidden.assign(stride, 0.0f);
+            state.cell.assign(stride, 0.0f);
+            state.history.resize(layers.size());
+            for (size_t layer = 0; layer < layers.size(); ++layer)
+            {
+                state.history[layer].assign(GetRingFrames(layer) * stride, 0.0f);
+            }
+        }
+
+        gates.assign(gateRows, 0.0f);
+        hiddenGates.assign(gateRows, 0.0f);
+        activation.assign(stride, 0.0f);
+        skip.assign(static_cast<size_t>(maxBlockFrames) * stride, 0.0f);
+        mono.assign(maxBlockFrames, 0.0f);
+    }
+
+    void NeuralAmp::ProcessLstm(std::span<float> samples, ChannelState &state)
+    {
+        const size_t hidden = spec.hiddenSize;
+        const size_t rows = gates.size();
+        float *const h = state.hidden.data();
+        float *const c = state.cell.data();
+        float *const g = gates.data();
+
+        for (float &sample : samples)
+        {
+            const float x = sample;
+            for (size_t row = 0; row < rows; ++row)
+            {
+                g[row] = inputBias[row] + inputWeights[row] * x;
+            }
+            hiddenWeights.MultiplyAdd(state.hidden, gates);
+
+            // Gate rows are i, f, g, o blocks of hidden rows each; activations run as contiguous
+            // passes so they vectorize, then one pass combines them
+            for (size_t row = 0; row < 2 * hidden; ++row)
+            {
+                g[row] = FastMath::Sigmoid(g[row]);
+            }
+            for (size_t row = 2 * hidden; row < 3 * hidden; ++row)
+            {
+                g[row] = FastMath::Tanh(g[row]);
+            }
+            for (size_t row = 3 * hidden; row < 4 * hidden; ++row)
+            {
+                g[row] = FastMath::Sigmoid(g[row]);
+            }
+            for (size_t j = 0; j < hidden; ++j)
+            {
+                c[j] = g[hidden + j] * c[j] + g[j] * g[2 * hidden + j];
+                h[j] = g[3 * hidden + j] * FastMath::Tanh(c[j]);
+            }
+
+            float y = outputBias;
+            for (size_t j = 0; j < hidden; ++j)
+            {
+                y += outputWeights[j] * h[j];
+            }
+
+            sample = spec.inputSkip ? y + x : y;
+        }
+    }
+
+    void NeuralAmp::ProcessGru(std::span<float> samples, ChannelState &state)
+    {
+        const size_t hidden = spec.hiddenSize;
+        const size_t rows = gates.size();
+        float *const h = state.hidden.data();
+        float *const g = gates.data();
+        float *const r = hiddenGates.data();
+
+        for (float &sample : samples)
+        {
+            const float x = sample;
+            for (size_t row = 0; row < rows; ++row)
+            {
+                g[row] = inputBias[row] + inputWeights[row] * x;
+                r[row] = hiddenBias[row];
+            }
+            hiddenWeights.MultiplyAdd(state.hidden, hiddenGates);
+
+            // Gate rows are r, z, n; the reset gate scales only the hidden side of the candidate
+            for (size_t row = 0; row < 2 * hidden; ++row)
+            {
+                g[row] = FastMath::Sigmoid(g[row] + r[row]);
+            }
+            for (size_t j = 0; j < hidden; ++j)
+            {
+                const float candidate = FastMath::Tanh(g[2 * hidden + j] + g[j] * r[2 * hidden + j]);
+                h[j] = candidate + g[hidden + j] * (h[j] - candidate);
+            }
+
+            float y = outputBias;
+            for (size_t j = 0; j < hidden; ++j)
+            {
+                y += outputWeights[j] * h[j];
+            }
+
+            sample = spec.inputSkip ? y + x : y;
+        }
+    }
+
+    void NeuralAmp::ProcessConvNet(std::span<float> samples, ChannelState &state)
+    {
+        const size_t width = spec.hiddenSize;
+        const size_t kernel = spec.kernelSize;
+        const size_t frames = samples.size();
+        const size_t base = state.position;
+
+        // Input 1x1 convolution into the first layer's ring
+        {
+            float *const ring = state.history[0].data();
+            const size_t mask = GetRingFrames(0) - 1;
+            for (size_t t = 0; t < frames; ++t)
+            {
+                float *const frame = ring + ((base + t) & mask) * stride;
+                for (size_t channel = 0; channel < stride; ++channel)
+                {
+                    frame[channel] = inputWeights[channel] * samples[t];
+                }
+            }
+        }
+
+        std::fill_n(skip.begin(), frames * stride, 0.0f);
+        for (size_t index = 0; index < layers.size(); ++index)
+        {
+            const ConvLayer &layer = layers[index];
+            const float *const ring = state.history[index].data();
+            const size_t mask = GetRingFrames(index) - 1;
+            const bool last = index + 1 == layers.size();
+            float *const next = last ? nullptr : state.history[index + 1].data();
+            const size_t nextMask = last ? 0 : GetRingFrames(index + 1) - 1;
+
+            for (size_t t = 0; t < frames; ++t)
+            {
+                const size_t n = base + t;
+                std::ranges::copy(layer.convBias, activation.begin());
+                for (size_t k = 0; k < kernel; ++k)
+                {
+                    // Ring positions wrap through the mask, so taps before the first block read silence
+                    const size_t delay = (kernel - 1 - k) * layer.dilation;
+                    layer.taps[k].MultiplyAdd(std::span<const float>(ring + ((n - delay) & mask) * stride, width),
+                        activation);
+                }
+
+                float *const skipFrame = skip.data() + t * stride;
+                for (size_t channel = 0; channel < stride; ++channel)
+                {
+                    activation[channel] = FastMath::Tanh(activation[channel]);
+                    skipFrame[channel] += activation[channel];
+                }
+
+                // The last layer's residual output feeds nothing, so it is skipped
+                if (!last)
+                {
+                    const float *const current = ring + (n & mask) * stride;
+                    float *const target = next + (n & nextMask) * stride;
+                    for (size_t channel = 0; channel < stride; ++channel)
+                    {
+                        target[channel] = current[channel] + layer.residualBias[channel];
+                    }
+                    layer.residual.MultiplyAdd(activation, std::span<float>(target, stride));
+                }
+            }
+        }
+
+        for (size_t t = 0; t < frames; ++t)
+        {
+            const float *const skipFrame = skip.data() + t * stride;
+            float y = outputBias;
+            for (size_t channel = 0; channel < stride; ++channel)
+            {
+                y += outputWeights[channel] * skipFrame[channel];
+            }
+            samples[t] = spec.inputSkip ? y + samples[t] : y;
+        }
+
+        state.position += frames;
+    }
+
+    size_t NeuralAmp::GetRingFrames(size_t layer) const
+    {
+        return std::bit_ceil((spec.kernelSize - 1) * static_cast<size_t>(layers[layer].dilation) + maxBlockFrames);
+    }
+
+} // namespace GuitarIO
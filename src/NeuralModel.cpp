@@ -0,0 +1,166 @@
+#include "NeuralModel.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace GuitarIO
+{
+    size_t NeuralModel::GetWeightCount(const NeuralModelSpec &spec)
+    {
+        const size_t h = spec.hiddenSize;
+        switch (spec.architecture)
+        {
+        case NeuralArchitecture::Lstm:
+            return 4 * h + 4 * h * h + 8 * h + h + 1;
+        case NeuralArchitecture::Gru:
+            return 3 * h + 3 * h * h + 6 * h + h + 1;
+        case NeuralArchitecture::ConvNet:
+            return h + spec.layers * (h * h * spec.kernelSize + h + h * h + h) + h + 1;
+        }
+        return 0;
+    }
+
+    bool NeuralModel::Assign(const NeuralModelSpec &newSpec, std::span<const float> newWeights)
+    {
+        if (!Validate(newSpec))
+        {
+            return false;
+        }
+
+        if (newWeights.size() != GetWeightCount(newSpec))
+        {
+            lastError = "Expected " + std::to_string(GetWeightCount(newSpec)) + " weights, got "
+                + std::to_string(newWeights.size());
+            return false;
+        }
+
+        if (!std::ranges::all_of(newWeights, [](float weight) { return std::isfinite(weight); }))
+        {
+            lastError = "Model contains non-finite weights";
+            return false;
+        }
+
+        spec = newSpec;
+        weights.assign(newWeights.begin(), newWeights.end());
+        return true;
+    }
+
+    bool NeuralModel::Load(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            lastError = "Failed to open model file: " + path;
+            return false;
+        }
+
+        NeuralModelHeader header;
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != NeuralModelHeader::MAGIC)
+        {
+            lastError = "Not a neural model file: " + path;
+            return false;
+        }
+
+        if (header.version != NeuralModelHeader::VERSION)
+        {
+            lastError = "Unsupported model version " + std::to_string(header.version);
+            return false;
+        }
+
+        NeuralModelSpec loaded;
+        loaded.architecture = static_cast<NeuralArchitecture>(header.architecture);
+        loaded.hiddenSize = header.hiddenSize;
+        loaded.layers = header.layers;
+        loaded.kernelSize = header.kernelSize;
+        loaded.inputSkip = (header.flags & NeuralModelHeader::FLAG_INPUT_SKIP) != 0;
+        loaded.sampleRate = header.sampleRate;
+        if (!Validate(loaded))
+        {
+            return false;
+        }
+
+        // Checked against the shape before reading, so a corrupt count cannot trigger a huge allocation
+        if (header.weightCount != GetWeightCount(loaded))
+        {
+            lastError = "Weight count does not match the model shape";
+            return false;
+        }
+
+        TaggedVector<float, MemoryTag::Tables> data(header.weightCount);
+        const auto bytes = static_cast<std::streamsize>(data.size() * sizeof(float));
+        if (!file.read(reinterpret_cast<char *>(data.data()), bytes))
+        {
+            lastError = "Truncated model file: " + path;
+            return false;
+        }
+
+        return Assign(loaded, data);
+    }
+
+    bool NeuralModel::Save(const std::string &path)
+    {
+        if (weights.empty())
+        {
+            lastError = "No model to save";
+            return false;
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+        {
+            lastError = "Failed to create model file: " + path;
+            return false;
+        }
+
+        NeuralModelHeader header;
+        header.architecture = static_cast<uint32_t>(spec.architecture);
+        header.hiddenSize = spec.hiddenSize;
+        header.layers = spec.layers;
+        header.kernelSize = spec.kernelSize;
+        header.flags = spec.inputSkip ? NeuralModelHeader::FLAG_INPUT_SKIP : 0;
+        header.sampleRate = spec.sampleRate;
+        header.weightCount = static_cast<uint32_t>(weights.size());
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(weights.data()),
+            static_cast<std::streamsize>(weights.size() * sizeof(float)));
+        if (!file)
+        {
+            lastError = "Failed to write model file: " + path;
+            return false;
+        }
+        return true;
+    }
+
+    std::string NeuralModel::GetLastError() const
+    {
+        return lastError;
+    }
+
+    bool NeuralModel::Validate(const NeuralModelSpec &candidate)
+    {
+        const bool recurrent =
+            candidate.architecture == NeuralArchitecture::Lstm || candidate.architecture == NeuralArchitecture::Gru;
+        if (!recurrent && candidate.architecture != NeuralArchitecture::ConvNet)
+        {
+            lastError = "Unknown model architecture " + std::to_string(static_cast<uint32_t>(candidate.architecture));
+            return false;
+        }
+
+        if (candidate.hiddenSize == 0 || candidate.hiddenSize > MAX_HIDDEN_SIZE || candidate.sampleRate == 0)
+        {
+            lastError = "Invalid model size or sample rate";
+            return false;
+        }
+
+        if (recurrent ? candidate.layers != 1
+                      : candidate.layers == 0 || candidate.layers > MAX_LAYERS || candidate.kernelSize == 0
+                            || candidate.kernelSize > MAX_KERNEL_SIZE)
+        {
+            lastError = "Unsupported layer count or kernel size";
+            return false;
+        }
+        return true;
+    }
+
+} // namespace GuitarIO
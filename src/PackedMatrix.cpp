@@ -0,0 +1,153 @@
+#include "PackedMatrix.h"
+#include <algorithm>
+#include <array>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GUITAR_IO_PACKED_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GUITAR_IO_PACKED_SSE 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define GUITAR_IO_PACKED_NEON 1
+#endif
+
+namespace GuitarIO
+{
+    namespace
+    {
+        static_assert(PackedMatrix::LANES == 8, "Kernels below are written for 8-row blocks");
+
+        // One row block: acc starts at zero or at the current output, then one 8-wide multiply-add
+        // per column. Even and odd columns go to separate accumulators so consecutive adds do not
+        // wait on each other's latency.
+        template<bool Accumulate>
+        void MultiplyBlock(const float *w, size_t columns, const float *input, float *out)
+        {
+#if defined(GUITAR_IO_PACKED_AVX)
+            __m256 even = Accumulate ? _mm256_loadu_ps(out) : _mm256_setzero_ps();
+            __m256 odd = _mm256_setzero_ps();
+            size_t column = 0;
+            for (; column + 1 < columns; column += 2, w += 16)
+            {
+                even = _mm256_add_ps(even, _mm256_mul_ps(_mm256_loadu_ps(w), _mm256_set1_ps(input[column])));
+                odd = _mm256_add_ps(odd, _mm256_mul_ps(_mm256_loadu_ps(w + 8), _mm256_set1_ps(input[column + 1])));
+            }
+            if (column < columns)
+            {
+                even = _mm256_add_ps(even, _mm256_mul_ps(_mm256_loadu_ps(w), _mm256_set1_ps(input[column])));
+            }
+            _mm256_storeu_ps(out, _mm256_add_ps(even, odd));
+#elif defined(GUITAR_IO_PACKED_SSE)
+            __m128 evenLow = Accumulate ? _mm_loadu_ps(out) : _mm_setzero_ps();
+            __m128 evenHigh = Accumulate ? _mm_loadu_ps(out + 4) : _mm_setzero_ps();
+            __m128 oddLow = _mm_setzero_ps();
+            __m128 oddHigh = _mm_setzero_ps();
+            size_t column = 0;
+            for (; column + 1 < columns; column += 2, w += 16)
+            {
+                const __m128 x0 = _mm_set1_ps(input[column]);
+                const __m128 x1 = _mm_set1_ps(input[column + 1]);
+                evenLow = _mm_add_ps(evenLow, _mm_mul_ps(_mm_loadu_ps(w), x0));
+                evenHigh = _mm_add_ps(evenHigh, _mm_mul_ps(_mm_loadu_ps(w + 4), x0));
+                oddLow = _mm_add_ps(oddLow, _mm_mul_ps(_mm_loadu_ps(w + 8), x1));
+                oddHigh = _mm_add_ps(oddHigh, _mm_mul_ps(_mm_loadu_ps(w + 12), x1));
+            }
+            if (column < columns)
+            {
+                const __m128 x0 = _mm_set1_ps(input[column]);
+                evenLow = _mm_add_ps(evenLow, _mm_mul_ps(_mm_loadu_ps(w), x0));
+                evenHigh = _mm_add_ps(evenHigh, _mm_mul_ps(_mm_loadu_ps(w + 4), x0));
+            }
+            _mm_storeu_ps(out, _mm_add_ps(evenLow, oddLow));
+            _mm_storeu_ps(out + 4, _mm_add_ps(evenHigh, oddHigh));
+#elif defined(GUITAR_IO_PACKED_NEON)
+            float32x4_t evenLow = Accumulate ? vld1q_f32(out) : vdupq_n_f32(0.0f);
+            float32x4_t evenHigh = Accumulate ? vld1q_f32(out + 4) : vdupq_n_f32(0.0f);
+            float32x4_t oddLow = vdupq_n_f32(0.0f);
+            float32x4_t oddHigh = vdupq_n_f32(0.0f);
+            size_t column = 0;
+            for (; column + 1 < columns; column += 2, w += 16)
+            {
+                evenLow = vmlaq_n_f32(evenLow, vld1q_f32(w), input[column]);
+                evenHigh = vmlaq_n_f32(evenHigh, vld1q_f32(w + 4), input[column]);
+                oddLow = vmlaq_n_f32(oddLow, vld1q_f32(w + 8), input[column + 1]);
+                oddHigh = vmlaq_n_f32(oddHigh, vld1q_f32(w + 12), input[column + 1]);
+            }
+            if (column < columns)
+            {
+                evenLow = vmlaq_n_f32(evenLow, vld1q_f32(w), input[column]);
+                evenHigh = vmlaq_n_f32(evenHigh, vld1q_f32(w + 4), input[column]);
+            }
+            vst1q_f32(out, vaddq_f32(evenLow, oddLow));
+            vst1q_f32(out + 4, vaddq_f32(evenHigh, oddHigh));
+#else
+            std::array<float, PackedMatrix::LANES> acc{};
+            if constexpr (Accumulate)
+            {
+                std::copy_n(out, PackedMatrix::LANES, acc.begin());
+            }
+            for (size_t column = 0; column < columns; ++column, w += PackedMatrix::LANES)
+            {
+                for (size_t lane = 0; lane < PackedMatrix::LANES; ++lane)
+                {
+                    acc[lane] += w[lane] * input[column];
+                }
+            }
+            std::copy_n(acc.begin(), PackedMatrix::LANES, out);
+#endif
+        }
+
+        template<bool Accumulate>
+        void MultiplyBlocks(const float *weights, size_t blockCount, size_t columns, const float *input, float *output)
+        {
+            for (size_t block = 0; block < blockCount; ++block)
+            {
+                MultiplyBlock<Accumulate>(weights + block * columns * PackedMatrix::LANES,
+                    columns,
+                    input,
+                    output + block * PackedMatrix::LANES);
+            }
+        }
+    } // namespace
+
+    void PackedMatrix::Pack(std::span<const float> rowMajor, size_t newRows, size_t newColumns)
+    {
+        rows = newRows;
+        columns = newColumns;
+        blocks.assign(PadRows(rows) * columns, 0.0f);
+
+        const size_t count = std::min(rowMajor.size() / std::max<size_t>(columns, 1), rows);
+        for (size_t row = 0; row < count; ++row)
+        {
+            const size_t block = row / LANES;
+            const size_t lane = row % LANES;
+            for (size_t column = 0; column < columns; ++column)
+            {
+                blocks[(block * columns + column) * LANES + lane] = rowMajor[row * columns + column];
+            }
+        }
+    }
+
+    void PackedMatrix::Multiply(std::span<const float> input, std::span<float> output) const
+    {
+        if (input.size() < columns || output.size() < GetPaddedRows())
+        {
+            return;
+        }
+
+        MultiplyBlocks<false>(blocks.data(), GetPaddedRows() / LANES, columns, input.data(), output.data());
+    }
+
+    void PackedMatrix::MultiplyAdd(std::span<const float> input, std::span<float> output) const
+    {
+        if (input.size() < columns || output.size() < GetPaddedRows())
+        {
+            return;
+        }
+
+        MultiplyBlocks<true>(blocks.data(), GetPaddedRows() / LANES, columns, input.data(), output.data());
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,203 @@
+#include "ParallelChain.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GuitarIO
+{
+    size_t ParallelChain::AddPath(ProcessorChain chain, float gain)
+    {
+        Path &path = paths.emplace_back();
+        path.chain = std::move(chain);
+        path.gain.store(gain, std::memory_order_relaxed);
+        return paths.size() - 1;
+    }
+
+    bool ParallelChain::Prepare(uint32_t newMaxBlockFrames, uint32_t newChannels, uint32_t maxCompensationFrames)
+    {
+        if (newMaxBlockFrames == 0 || newChannels == 0)
+        {
+            lastError = "Invalid stream format";
+            return false;
+        }
+
+        maxBlockFrames = newMaxBlockFrames;
+        channels = newChannels;
+        delayFrames = maxCompensationFrames + 1;
+        kernels = AudioMixer::SelectKernels(channels, maxBlockFrames);
+
+        input.assign(static_cast<size_t>(maxBlockFrames) * channels, 0.0f);
+        scratch.assign(input.size(), 0.0f);
+        for (Path &path : paths)
+        {
+            path.delay.assign(static_cast<size_t>(delayFrames) * channels, 0.0f);
+            path.delayWrite = 0;
+            path.latency = UINT32_MAX; // Forces the first UpdateCompensation() to run
+        }
+
+        UpdateCompensation();
+        return true;
+    }
+
+    bool ParallelChain::Prepare(const ProcessSpec &spec)
+    {
+        bool prepared = true;
+        for (Path &path : paths)
+        {
+            prepared = path.chain.Prepare(spec) && prepared;
+        }
+
+        if (!prepared)
+        {
+            lastError = "A path processor rejected the stream format";
+            return false;
+        }
+
+        // Latencies measured in time grow in frames when SetSampleRate() raises the rate
+        const double rateScale = spec.sampleRate > 0.0 ? spec.GetMaxSampleRate() / spec.sampleRate : 1.0;
+        const auto scaledLatency = static_cast<uint32_t>(std::ceil(GetLatencyFrames() * rateScale));
+        const uint32_t capacity = std::max(scaledLatency, delayFrames > 0 ? delayFrames - 1 : 0);
+        return Prepare(spec.maxBlockFrames, spec.channels, capacity);
+    }
+
+    void ParallelChain::SetSampleRate(double sampleRate)
+    {
+        for (Path &path : paths)
+        {
+            path.chain.SetSampleRate(sampleRate);
+        }
+    }
+
+    void ParallelChain::Process(std::span<float> buffer, uint32_t bufferChannels)
+    {
+        if (bufferChannels != channels || paths.empty())
+        {
+            return;
+        }
+
+        UpdateCompensation();
+
+        const size_t chunkSamples = static_cast<size_t>(maxBlockFrames) * channels;
+        for (size_t offset = 0; offset < buffer.size(); offset += chunkSamples)
+        {
+            const std::span<float> chunk = buffer.subspan(offset, std::min(chunkSamples, buffer.size() - offset));
+            const std::span<float> dry = std::span<float>(input).first(chunk.size());
+            const std::span<float> wet = std::span<float>(scratch).first(chunk.size());
+
+            std::copy(chunk.begin(), chunk.end(), dry.begin());
+            std::fill(chunk.begin(), chunk.end(), 0.0f);
+
+            for (Path &path : paths)
+            {
+                std::copy(dry.begin(), dry.end(), wet.begin());
+                path.chain.Process(wet, channels);
+                ApplyDelay(path, wet);
+                kernels.mix(wet, chunk, path.gain.load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    void ParallelChain::Reset()
+    {
+        for (Path &path : paths)
+        {
+            path.chain.Reset();
+            std::fill(path.delay.begin(), path.delay.end(), 0.0f);
+            path.delayWrite = 0;
+        }
+    }
+
+    uint32_t ParallelChain::GetLatencyFrames() const
+    {
+        uint32_t latency = 0;
+        for (const Path &path : paths)
+        {
+            latency = std::max(latency, path.chain.GetLatencyFrames());
+        }
+        return latency;
+    }
+
+    void ParallelChain::SetPathGain(size_t index, float gain)
+    {
+        if (index < paths.size())
+        {
+            paths[index].gain.store(gain, std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t ParallelChain::GetCompensationFrames(size_t index) const
+    {
+        return index < paths.size() ? paths[index].compensation.load(std::memory_order_relaxed) : 0;
+    }
+
+    size_t ParallelChain::GetPathCount() const
+    {
+        return paths.size();
+    }
+
+    ProcessorChain *ParallelChain::GetChain(size_t index)
+    {
+        return index < paths.size() ? &paths[index].chain : nullptr;
+    }
+
+    std::string ParallelChain::GetLastError() const
+    {
+        return lastError;
+    }
+
+    void ParallelChain::UpdateCompensation()
+    {
+        bool changed = false;
+        uint32_t longest = 0;
+        for (Path &path : paths)
+        {
+            const uint32_t latency = path.chain.GetLatencyFrames();
+            changed = changed || latency != path.latency;
+            path.latency = latency;
+            longest = std::max(longest, latency);
+        }
+
+        if (!changed)
+        {
+            return;
+        }
+
+        for (Path &path : paths)
+        {
+            const uint32_t compensation = std::min(longest - path.latency, delayFrames - 1);
+            if (compensation != path.compensation.load(std::memory_order_relaxed))
+            {
+                // Stale samples would replay at the new offset; restart the line from silence
+                std::fill(path.delay.begin(), path.delay.end(), 0.0f);
+                path.delayWrite = 0;
+                path.compensation.store(compensation, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void ParallelChain::ApplyDelay(Path &path, std::span<float> block) const
+    {
+        const uint32_t compensation = path.compensation.load(std::memory_order_relaxed);
+        if (compensation == 0)
+        {
+            return;
+        }
+
+        const size_t frames = block.size() / channels;
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            const size_t readFrame = (path.delayWrite + delayFrames - compensation) % delayFrames;
+            float *slot = path.delay.data() + path.delayWrite * channels;
+            const float *delayed = path.delay.data() + readFrame * channels;
+            float *sample = block.data() + frame * channels;
+
+            for (uint32_t channel = 0; channel < channels; ++channel)
+            {
+                slot[channel] = sample[channel];
+                sample[channel] = delayed[channel];
+            }
+
+            path.delayWrite = path.delayWrite + 1 == delayFrames ? 0 : path.delayWrite + 1;
+        }
+    }
+
+} // namespace GuitarIO
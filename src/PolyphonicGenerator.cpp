@@ -1,18 +1,28 @@
 #include "PolyphonicGenerator.h"
+#include "AudioMixer.h"
+#include "Profiler.h"
 #include <algorithm>
 #include <cmath>
 
 namespace GuitarIO
 {
 
-    PolyphonicGenerator::PolyphonicGenerator(double sampleRate)
+    PolyphonicGenerator::PolyphonicGenerator(double sampleRate) : outputGain(0.0f)
     {
         for (size_t i = 0; i < MAX_VOICES; ++i)
         {
-            voices[i].SetSampleRate(sampleRate);
-            voices[i].SetAmplitude(0.0f);
-            frequencies[i] = 0.0;
+            voices[i].SetAmplitude(1.0f);
+            frequencies[i].store(0.0, std::memory_order_relaxed);
+            amplitudes[i].store(1.0f, std::memory_order_relaxed);
         }
+
+        for (auto &level : voiceLevels)
+        {
+            level.Prepare(sampleRate, CONTROL_INTERVAL, SMOOTHING_MS);
+        }
+
+        outputGain.Prepare(sampleRate, CONTROL_INTERVAL, SMOOTHING_MS);
+        SetSampleRate(sampleRate);
     }
 
     void PolyphonicGenerator::SetSampleRate(double sampleRate)
@@ -21,6 +31,13 @@ namespace GuitarIO
         {
             voice.SetSampleRate(sampleRate);
         }
+
+        for (auto &level : voiceLevels)
+        {
+            level.SetSampleRate(sampleRate);
+        }
+
+        outputGain.SetSampleRate(sampleRate);
     }
 
     void PolyphonicGenerator::SetVoiceFrequency(size_t voiceIndex, double frequency)
@@ -30,19 +47,17 @@ namespace GuitarIO
             return;
         }
 
-        frequencies[voiceIndex] = frequency;
-        voices[voiceIndex].SetFrequency(frequency);
+        frequencies[voiceIndex].store(frequency, std::memory_order_relaxed);
 
+        // A disabled voice keeps its oscillator frequency so it can fade out
         if (frequency > 0.0)
         {
-            voices[voiceIndex].SetAmplitude(1.0f);
-        }
-        else
-        {
-            voices[voiceIndex].SetAmplitude(0.0f);
+            voices[voiceIndex].SetFrequency(frequency);
         }
 
         UpdateActiveVoiceCount();
+        UpdateVoiceLevels();
+        UpdateOutputGain();
     }
 
     void PolyphonicGenerator::SetVoiceFrequencies(const std::array<float, MAX_VOICES> &freqs)
@@ -60,44 +75,80 @@ namespace GuitarIO
             return;
         }
 
-        voices[voiceIndex].SetAmplitude(amplitude);
+        amplitudes[voiceIndex].store(std::clamp(amplitude, 0.0f, 1.0f), std::memory_order_relaxed);
+        UpdateVoiceLevels();
     }
 
     void PolyphonicGenerator::SetGlobalVolume(float volume)
     {
-        globalVolume = std::clamp(volume, 0.0f, 1.0f);
+        globalVolume.store(std::clamp(volume, 0.0f, 1.0f), std::memory_order_relaxed);
+        UpdateOutputGain();
     }
 
-    void PolyphonicGenerator::Generate(std::span<float> buffer, bool accumulate)
+    void PolyphonicGenerator::SetVoiceLimit(size_t limit)
     {
-        if (activeVoiceCount == 0)
+        if (voiceLimit.exchange(limit, std::memory_order_relaxed) == limit)
         {
-            if (!accumulate)
-            {
-                std::fill(buffer.begin(), buffer.end(), 0.0f);
-            }
             return;
         }
 
-        const float gainCompensation = 1.0f / std::sqrt(static_cast<float>(activeVoiceCount));
-        const float effectiveVolume = globalVolume * gainCompensation;
+        UpdateVoiceLevels();
+        UpdateOutputGain();
+    }
+
+    void PolyphonicGenerator::Generate(std::span<float> buffer, bool accumulate)
+    {
+        GUITAR_IO_PROFILE_SCOPE("PolyphonicGenerator::Generate");
 
         if (!accumulate)
         {
             std::fill(buffer.begin(), buffer.end(), 0.0f);
         }
 
-        for (size_t i = 0; i < MAX_VOICES; ++i)
+        if (IsIdle())
         {
-            if (frequencies[i] > 0.0)
+            return;
+        }
+
+        GUITAR_IO_PROFILE_COUNTER("PolyphonicGenerator::ActiveVoices", GetActiveVoiceCount());
+
+        for (size_t offset = 0; offset < buffer.size(); offset += CONTROL_INTERVAL)
+        {
+            const size_t count = std::min<size_t>(CONTROL_INTERVAL, buffer.size() - offset);
+            const std::span<float> chunk = buffer.subspan(offset, count);
+            const std::span<float> voiceChunk(scratch.data(), count);
+            const ParameterRamp gain = outputGain.Tick();
+
+            for (size_t i = 0; i < MAX_VOICES; ++i)
             {
-                float originalAmp = effectiveVolume;
-                voices[i].SetAmplitude(originalAmp);
-                voices[i].Generate(buffer, true);
+                const ParameterRamp level = voiceLevels[i].Tick();
+                if (level.IsFlat() && level.start == 0.0f)
+                {
+                    continue;
+                }
+
+                voices[i].Generate(voiceChunk);
+                AudioMixer::MixRamp(voiceChunk, chunk, level.start * gain.start, level.end * gain.end);
             }
         }
     }
 
+    void PolyphonicGenerator::Generate(AudioBlock &block, bool accumulate)
+    {
+        if (IsIdle())
+        {
+            if (!accumulate && !block.silent)
+            {
+                std::fill(block.samples.begin(), block.samples.end(), 0.0f);
+                block.silent = true;
+            }
+            return;
+        }
+
+        Generate(block.samples, accumulate);
+        block.silent = false;
+    }
+
     void PolyphonicGenerator::Reset()
     {
         for (auto &voice : voices)
@@ -108,19 +159,52 @@ namespace GuitarIO
 
     size_t PolyphonicGenerator::GetActiveVoiceCount() const
     {
-        return activeVoiceCount;
+        return activeVoiceCount.load(std::memory_order_relaxed);
+    }
+
+    bool PolyphonicGenerator::IsIdle() const
+    {
+        return std::all_of(voiceLevels.begin(), voiceLevels.end(), [](const SmoothedParameter &level) {
+            return level.GetTarget() == 0.0f && level.IsSettled() && level.GetValue() == 0.0f;
+        });
     }
 
     void PolyphonicGenerator::UpdateActiveVoiceCount()
     {
-        activeVoiceCount = 0;
-        for (double freq : frequencies)
+        size_t count = 0;
+        for (const auto &freq : frequencies)
         {
-            if (freq > 0.0)
+            if (freq.load(std::memory_order_relaxed) > 0.0)
             {
-                ++activeVoiceCount;
+                ++count;
             }
         }
+        activeVoiceCount.store(count, std::memory_order_relaxed);
+    }
+
+    void PolyphonicGenerator::UpdateVoiceLevels()
+    {
+        const size_t limit = voiceLimit.load(std::memory_order_relaxed);
+        size_t rendered = 0;
+        for (size_t i = 0; i < MAX_VOICES; ++i)
+        {
+            const bool enabled = frequencies[i].load(std::memory_order_relaxed) > 0.0;
+            const bool audible = enabled && rendered < limit;
+            rendered += audible ? 1 : 0;
+            voiceLevels[i].SetTarget(audible ? amplitudes[i].load(std::memory_order_relaxed) : 0.0f);
+        }
+    }
+
+    void PolyphonicGenerator::UpdateOutputGain()
+    {
+        // Keep the last gain while the final voice fades out
+        const size_t renderedVoices =
+            std::min(activeVoiceCount.load(std::memory_order_relaxed), voiceLimit.load(std::memory_order_relaxed));
+        if (renderedVoices > 0)
+        {
+            const float volume = globalVolume.load(std::memory_order_relaxed);
+            outputGain.SetTarget(volume / std::sqrt(static_cast<float>(renderedVoices)));
+        }
     }
 
 } // namespace GuitarIO
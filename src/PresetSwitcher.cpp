@@ -0,0 +1,228 @@
+#include "PresetSwitcher.h"
+#include <algorithm>
+#include <chrono>
+
+namespace GuitarIO
+{
+    PresetSwitcher::PresetSwitcher(const PresetSwitcherConfig &config)
+        : config(config), retired(std::max(1u, config.retireCapacity))
+    {
+        reclaiming.store(true);
+        reclaimer = std::thread(&PresetSwitcher::ReclaimLoop, this);
+    }
+
+    PresetSwitcher::~PresetSwitcher()
+    {
+        reclaiming.store(false);
+        if (reclaimer.joinable())
+        {
+            reclaimer.join();
+        }
+
+        Reclaim();
+        delete pending.exchange(nullptr);
+        delete outgoing;
+        delete active;
+    }
+
+    bool PresetSwitcher::Prepare(double sampleRate, uint32_t newMaxBlockFrames, uint32_t newChannels)
+    {
+        if (sampleRate <= 0.0 || newMaxBlockFrames == 0 || newChannels == 0)
+        {
+            lastError = "Invalid stream format";
+            return false;
+        }
+
+        maxBlockFrames = newMaxBlockFrames;
+        channels = newChannels;
+        kernels = AudioMixer::SelectKernels(channels, maxBlockFrames);
+        fadeBuffer.assign(static_cast<size_t>(maxBlockFrames) * channels, 0.0f);
+        SetSampleRate(sampleRate);
+        return true;
+    }
+
+    bool PresetSwitcher::Prepare(const ProcessSpec &spec)
+    {
+        return Prepare(spec.sampleRate, spec.maxBlockFrames, spec.channels);
+    }
+
+    void PresetSwitcher::SetSampleRate(double sampleRate)
+    {
+        const auto frames = static_cast<uint32_t>(std::max(0.0f, config.crossfadeMs) * 0.001 * sampleRate);
+        crossfadeFrames.store(frames, std::memory_order_relaxed);
+    }
+
+    uint64_t PresetSwitcher::Load(std::unique_ptr<Preset> preset)
+    {
+        if (!preset)
+        {
+            return 0;
+        }
+
+        auto *slot = new Slot{ std::move(preset), loads.fetch_add(1, std::memory_order_relaxed) + 1 };
+        const uint64_t generation = slot->generation;
+
+        // A preset the audio thread never picked up is still owned here and can be freed directly
+        delete pending.exchange(slot, std::memory_order_acq_rel);
+        return generation;
+    }
+
+    void PresetSwitcher::Process(std::span<float> buffer, uint32_t bufferChannels)
+    {
+        if (bufferChannels != channels)
+        {
+            return;
+        }
+
+        AdoptPending();
+
+        if (outgoing != nullptr)
+        {
+            ProcessCrossfade(buffer);
+        }
+        else if (active != nullptr)
+        {
+            active->preset->chain.Process(buffer, channels);
+        }
+    }
+
+    void PresetSwitcher::Reset()
+    {
+        // With the retire queue full the fade keeps running; it retires the preset once a slot frees up
+        if (outgoing != nullptr && Retire(outgoing))
+        {
+            outgoing = nullptr;
+            crossfading.store(false, std::memory_order_relaxed);
+        }
+
+        if (active != nullptr)
+        {
+            active->preset->chain.Reset();
+        }
+    }
+
+    uint32_t PresetSwitcher::GetLatencyFrames() const
+    {
+        return active != nullptr ? active->preset->chain.GetLatencyFrames() : 0;
+    }
+
+    uint64_t PresetSwitcher::GetActiveGeneration() const
+    {
+        return activeGeneration.load(std::memory_order_acquire);
+    }
+
+    bool PresetSwitcher::IsCrossfading() const
+    {
+        return crossfading.load(std::memory_order_relaxed);
+    }
+
+    uint64_t PresetSwitcher::GetReclaimedCount() const
+    {
+        return reclaimed.load(std::memory_order_relaxed);
+    }
+
+    std::string PresetSwitcher::GetLastError() const
+    {
+        return lastError;
+    }
+
+    void PresetSwitcher::AdoptPending()
+    {
+        // Finish the running switch first, and keep room to retire the preset being replaced
+        if (outgoing != nullptr || pending.load(std::memory_order_relaxed) == nullptr
+            || retired.GetWriteAvailable() == 0)
+        {
+            return;
+        }
+
+        Slot *next = pending.exchange(nullptr, std::memory_order_acq_rel);
+        if (next == nullptr)
+        {
+            return;
+        }
+
+        fadeLength = crossfadeFrames.load(std::memory_order_relaxed);
+        if (active != nullptr && fadeLength > 0)
+        {
+            outgoing = active;
+            fadePosition = 0;
+            crossfading.store(true, std::memory_order_relaxed);
+        }
+        else if (active != nullptr)
+        {
+            Retire(active);
+        }
+
+        active = next;
+        activeGeneration.store(active->generation, std::memory_order_release);
+    }
+
+    void PresetSwitcher::ProcessCrossfade(std::span<float> buffer)
+    {
+        const size_t chunkSamples = static_cast<size_t>(maxBlockFrames) * channels;
+        const float step = 1.0f / static_cast<float>(fadeLength);
+
+        for (size_t offset = 0; offset < buffer.size(); offset += chunkSamples)
+        {
+            const std::span<float> chunk = buffer.subspan(offset, std::min(chunkSamples, buffer.size() - offset));
+            const auto frames = static_cast<uint32_t>(chunk.size() / channels);
+
+            if (outgoing == nullptr)
+            {
+                active->preset->chain.Process(chunk, channels);
+                continue;
+            }
+
+            const std::span<float> old = std::span<float>(fadeBuffer).first(chunk.size());
+            std::copy(chunk.begin(), chunk.end(), old.begin());
+            outgoing->preset->chain.Process(old, channels);
+            active->preset->chain.Process(chunk, channels);
+
+            // The ramps stop at 0/1 exactly when the fade ends inside this chunk; the remainder is held
+            const uint32_t fadeFrames = std::min(frames, fadeLength - fadePosition);
+            const float startGain = static_cast<float>(fadePosition) * step;
+            const float endGain = static_cast<float>(fadePosition + fadeFrames) * step;
+            const std::span<float> fadeIn = chunk.first(static_cast<size_t>(fadeFrames) * channels);
+            const std::span<const float> fadeOut = old.first(fadeIn.size());
+
+            kernels.applyGainRamp(fadeIn, startGain, endGain, channels);
+            kernels.mixRamp(fadeOut, fadeIn, 1.0f - startGain, 1.0f - endGain, channels);
+
+            // A failed retire holds the finished fade (fadeFrames == 0 from here on) and retries next chunk
+            fadePosition += fadeFrames;
+            if (fadePosition >= fadeLength && Retire(outgoing))
+            {
+                outgoing = nullptr;
+                crossfading.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool PresetSwitcher::Retire(Slot *slot)
+    {
+        const std::span<Slot *const> item(&slot, 1);
+        return retired.Write(item) == 1;
+    }
+
+    void PresetSwitcher::ReclaimLoop()
+    {
+        const auto interval = std::chrono::milliseconds(std::max(1u, config.reclaimIntervalMs));
+
+        while (reclaiming.load())
+        {
+            Reclaim();
+            std::this_thread::sleep_for(interval);
+        }
+    }
+
+    void PresetSwitcher::Reclaim()
+    {
+        Slot *slot = nullptr;
+        while (retired.Read(std::span<Slot *>(&slot, 1)) == 1)
+        {
+            delete slot;
+            reclaimed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,104 @@
+#include "ProcessorChain.h"
+#include "AudioMixer.h"
+#include <algorithm>
+
+namespace GuitarIO
+{
+    void ProcessorChain::Add(std::unique_ptr<AudioProcessor> processor)
+    {
+        if (processor)
+        {
+            processors.push_back(std::move(processor));
+            silentFrames.push_back(0);
+        }
+    }
+
+    void ProcessorChain::Process(std::span<float> buffer, uint32_t channels)
+    {
+        for (auto &processor : processors)
+        {
+            processor->Process(buffer, channels);
+        }
+    }
+
+    void ProcessorChain::Process(AudioBlock &block)
+    {
+        const auto frames = static_cast<uint32_t>(block.GetFrameCount());
+
+        for (size_t i = 0; i < processors.size(); ++i)
+        {
+            AudioProcessor &processor = *processors[i];
+
+            if (!block.silent)
+            {
+                silentFrames[i] = 0;
+                processor.Process(block.samples, block.channels);
+                continue;
+            }
+
+            if (silentFrames[i] >= processor.GetTailFrames())
+            {
+                continue; // Tail has decayed: silence in, silence out
+            }
+
+            processor.Process(block.samples, block.channels);
+            // Saturate below TAIL_INFINITE so processors with an infinite tail are never skipped
+            constexpr uint32_t SATURATED = AudioProcessor::TAIL_INFINITE - 1;
+            silentFrames[i] = frames > SATURATED - silentFrames[i] ? SATURATED : silentFrames[i] + frames;
+            block.silent = AudioMixer::IsSilent(block.samples, silenceThreshold);
+        }
+    }
+
+    void ProcessorChain::SetSilenceThreshold(float threshold)
+    {
+        silenceThreshold = std::max(threshold, 0.0f);
+    }
+
+    bool ProcessorChain::Prepare(const ProcessSpec &spec)
+    {
+        bool prepared = true;
+        for (auto &processor : processors)
+        {
+            prepared = processor->Prepare(spec) && prepared;
+        }
+        return prepared;
+    }
+
+    void ProcessorChain::SetSampleRate(double sampleRate)
+    {
+        for (auto &processor : processors)
+        {
+            processor->SetSampleRate(sampleRate);
+        }
+    }
+
+    void ProcessorChain::Reset()
+    {
+        for (auto &processor : processors)
+        {
+            processor->Reset();
+        }
+        std::fill(silentFrames.begin(), silentFrames.end(), 0);
+    }
+
+    uint32_t ProcessorChain::GetLatencyFrames() const
+    {
+        uint32_t latency = 0;
+        for (const auto &processor : processors)
+        {
+            latency += processor->GetLatencyFrames();
+        }
+        return latency;
+    }
+
+    size_t ProcessorChain::GetSize() const
+    {
+        return processors.size();
+    }
+
+    AudioProcessor *ProcessorChain::Get(size_t index) const
+    {
+        return index < processors.size() ? processors[index].get() : nullptr;
+    }
+
+} // namespace GuitarIO
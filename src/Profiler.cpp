@@ -0,0 +1,161 @@
+#include "Profiler.h"
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace GuitarIO
+{
+    /**
+     * @brief Owns the ring pool (rings outlive the threads that fill them)
+     */
+    struct Profiler::Registry
+    {
+        /**
+         * @brief Allocates every ring and numbers the slots
+         */
+        Registry()
+        {
+            for (size_t i = 0; i < buffers.size(); ++i)
+            {
+                buffers[i].index = static_cast<uint32_t>(i);
+            }
+        }
+
+        std::array<ThreadBuffer, MAX_THREADS> buffers; ///< Ring pool
+        std::mutex collectMutex;                       ///< Serializes Collect() (the single ring consumer)
+    };
+
+    /**
+     * @brief Calling thread's claimed slot, released when the thread exits
+     */
+    struct Profiler::ThreadSlot
+    {
+        /**
+         * @brief Returns the slot to the pool; unread events stay in the ring for Collect()
+         */
+        ~ThreadSlot()
+        {
+            if (buffer != nullptr)
+            {
+                buffer->claimed.store(false, std::memory_order_release);
+            }
+        }
+
+        ThreadBuffer *buffer = nullptr; ///< Claimed buffer (null until the first event)
+    };
+
+    std::atomic<bool> Profiler::enabled = false;
+    std::atomic<uint64_t> Profiler::dropped = 0;
+
+    void Profiler::SetEnabled(bool enable)
+    {
+        if (enable)
+        {
+            // Allocate the pool here so that no recording thread constructs it
+            static_cast<void>(GetRegistry());
+        }
+        enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    void Profiler::RegisterThread()
+    {
+        static_cast<void>(GetThreadBuffer());
+    }
+
+    double Profiler::GetTicksPerSecond()
+    {
+        static const double ticksPerSecond = []
+        {
+            // Sample both clocks across a short sleep; a few milliseconds gives well under 0.1% error
+            const auto clockStart = std::chrono::steady_clock::now();
+            const uint64_t tickStart = ReadTimestamp();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const uint64_t tickEnd = ReadTimestamp();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - clockStart;
+            return static_cast<double>(tickEnd - tickStart) / elapsed.count();
+        }();
+        return ticksPerSecond;
+    }
+
+    void Profiler::RecordScope(const char *name, uint64_t start, uint64_t end)
+    {
+        Record({ name, start, end, 0, 0, ProfileEventType::Scope });
+    }
+
+    void Profiler::RecordCounter(const char *name, int64_t value)
+    {
+        Record({ name, ReadTimestamp(), 0, value, 0, ProfileEventType::Counter });
+    }
+
+    void Profiler::RecordInstant(const char *name)
+    {
+        Record({ name, ReadTimestamp(), 0, 0, 0, ProfileEventType::Instant });
+    }
+
+    size_t Profiler::Collect(std::vector<ProfileEvent> &events)
+    {
+        Registry &registry = GetRegistry();
+        const std::lock_guard lock(registry.collectMutex);
+
+        const size_t before = events.size();
+        for (ThreadBuffer &buffer : registry.buffers)
+        {
+            const size_t available = buffer.events.GetReadAvailable();
+            const size_t offset = events.size();
+            events.resize(offset + available);
+            const size_t read = buffer.events.Read(std::span<ProfileEvent>(events).subspan(offset));
+            events.resize(offset + read);
+        }
+        return events.size() - before;
+    }
+
+    uint64_t Profiler::GetDroppedEvents()
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    Profiler::Registry &Profiler::GetRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    Profiler::ThreadBuffer *Profiler::GetThreadBuffer()
+    {
+        thread_local ThreadSlot slot;
+        if (slot.buffer == nullptr) [[unlikely]]
+        {
+            // Acquire pairs with the release in ~ThreadSlot, so the previous owner's writes are visible
+            for (ThreadBuffer &buffer : GetRegistry().buffers)
+            {
+                bool expected = false;
+                if (!buffer.claimed.load(std::memory_order_relaxed)
+                    && buffer.claimed.compare_exchange_strong(
+                        expected, true, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    slot.buffer = &buffer;
+                    break;
+                }
+            }
+        }
+        return slot.buffer;
+    }
+
+    void Profiler::Record(ProfileEvent event)
+    {
+        ThreadBuffer *buffer = GetThreadBuffer();
+        if (buffer == nullptr) [[unlikely]]
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        event.thread = buffer->index;
+        if (buffer->events.Write(std::span<const ProfileEvent>(&event, 1)) == 0)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace GuitarIO
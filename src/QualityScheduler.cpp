@@ -0,0 +1,149 @@
+#include "QualityScheduler.h"
+#include <algorithm>
+
+namespace GuitarIO
+{
+    QualityScheduler::QualityScheduler(const QualitySchedulerConfig &config) : config(config)
+    {
+    }
+
+    size_t QualityScheduler::AddFallback(std::string name, uint32_t levels, Fallback apply)
+    {
+        fallbacks.push_back({ std::move(name), levels, std::move(apply) });
+        maxLevel += levels;
+        return fallbacks.size() - 1;
+    }
+
+    void QualityScheduler::Prepare(double sampleRate, uint32_t bufferSize)
+    {
+        periodSeconds = sampleRate > 0.0 ? static_cast<double>(bufferSize) / sampleRate : 0.0;
+    }
+
+    void QualityScheduler::BeginBlock()
+    {
+        blockStart = std::chrono::steady_clock::now();
+    }
+
+    void QualityScheduler::EndBlock()
+    {
+        if (periodSeconds <= 0.0)
+        {
+            return;
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - blockStart;
+        ReportLoad(static_cast<float>(elapsed.count() / periodSeconds));
+    }
+
+    void QualityScheduler::ReportLoad(float load)
+    {
+        smoothedLoad += (load - smoothedLoad) * config.loadSmoothing;
+        publishedLoad.store(smoothedLoad, std::memory_order_relaxed);
+        if (load > peakLoad.load(std::memory_order_relaxed))
+        {
+            peakLoad.store(load, std::memory_order_relaxed);
+        }
+
+        // Step down on single-block peaks (an xrun is imminent), step up on the smoothed load only
+        overBudgetBlocks = load > config.targetLoad ? overBudgetBlocks + 1 : 0;
+        relaxedBlocks = smoothedLoad < config.recoverLoad ? relaxedBlocks + 1 : 0;
+
+        const uint32_t current = level.load(std::memory_order_relaxed);
+        if (overBudgetBlocks >= config.stepDownBlocks && current < maxLevel)
+        {
+            ApplyLevel(current + 1);
+            stepDowns.fetch_add(1, std::memory_order_relaxed);
+            overBudgetBlocks = 0;
+            relaxedBlocks = 0;
+
+            // Let the smoothed load reflect the cheaper level before considering a step back up
+            smoothedLoad = std::max(smoothedLoad, config.recoverLoad);
+        }
+        else if (relaxedBlocks >= config.stepUpBlocks && current > 0)
+        {
+            ApplyLevel(current - 1);
+            stepUps.fetch_add(1, std::memory_order_relaxed);
+            relaxedBlocks = 0;
+        }
+    }
+
+    void QualityScheduler::Reset()
+    {
+        while (level.load(std::memory_order_relaxed) > 0)
+        {
+            ApplyLevel(level.load(std::memory_order_relaxed) - 1);
+        }
+
+        overBudgetBlocks = 0;
+        relaxedBlocks = 0;
+        smoothedLoad = 0.0f;
+        publishedLoad.store(0.0f, std::memory_order_relaxed);
+        peakLoad.store(0.0f, std::memory_order_relaxed);
+        stepDowns.store(0, std::memory_order_relaxed);
+        stepUps.store(0, std::memory_order_relaxed);
+    }
+
+    uint32_t QualityScheduler::GetLevel() const
+    {
+        return level.load(std::memory_order_relaxed);
+    }
+
+    uint32_t QualityScheduler::GetMaxLevel() const
+    {
+        return maxLevel;
+    }
+
+    uint32_t QualityScheduler::GetFallbackLevel(size_t index) const
+    {
+        return index < fallbacks.size() ? FallbackLevelAt(level.load(std::memory_order_relaxed), index) : 0;
+    }
+
+    std::string QualityScheduler::GetFallbackName(size_t index) const
+    {
+        return index < fallbacks.size() ? fallbacks[index].name : std::string();
+    }
+
+    QualitySchedulerStats QualityScheduler::GetStats() const
+    {
+        QualitySchedulerStats stats;
+        stats.load = publishedLoad.load(std::memory_order_relaxed);
+        stats.peakLoad = peakLoad.load(std::memory_order_relaxed);
+        stats.level = level.load(std::memory_order_relaxed);
+        stats.stepDowns = stepDowns.load(std::memory_order_relaxed);
+        stats.stepUps = stepUps.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void QualityScheduler::ApplyLevel(uint32_t newLevel)
+    {
+        // Adjacent levels differ in exactly one fallback
+        const uint32_t changed = std::max(newLevel, level.load(std::memory_order_relaxed));
+        uint32_t consumed = 0;
+        for (size_t i = 0; i < fallbacks.size(); ++i)
+        {
+            consumed += fallbacks[i].levels;
+            if (changed <= consumed)
+            {
+                if (fallbacks[i].apply)
+                {
+                    fallbacks[i].apply(FallbackLevelAt(newLevel, i));
+                }
+                break;
+            }
+        }
+
+        level.store(newLevel, std::memory_order_relaxed);
+    }
+
+    uint32_t QualityScheduler::FallbackLevelAt(uint32_t globalLevel, size_t index) const
+    {
+        uint32_t before = 0;
+        for (size_t i = 0; i < index; ++i)
+        {
+            before += fallbacks[i].levels;
+        }
+
+        return std::min(globalLevel - std::min(globalLevel, before), fallbacks[index].levels);
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,184 @@
+#include "RateConverter.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr double PASSBAND = 0.9; ///< Cutoff as a fraction of the low-rate Nyquist frequency
+
+        /**
+         * @brief Designs a Blackman-windowed sinc lowpass with unity DC gain
+         * @param length Number of taps
+         * @param factor Rate change factor (cutoff = PASSBAND * 0.5 / factor)
+         * @return Filter coefficients
+         */
+        std::vector<float> DesignLowpass(size_t length, uint32_t factor)
+        {
+            std::vector<float> coefficients(length);
+            const double cutoff = PASSBAND * 0.5 / factor;
+            const double center = static_cast<double>(length - 1) / 2.0;
+            double sum = 0.0;
+
+            for (size_t n = 0; n < length; ++n)
+            {
+                const double x = static_cast<double>(n) - center;
+                const double sinc =
+                    x == 0.0 ? 2.0 * cutoff : std::sin(2.0 * std::numbers::pi * cutoff * x) / (std::numbers::pi * x);
+                const double w = 2.0 * std::numbers::pi * static_cast<double>(n) / static_cast<double>(length - 1);
+                const double window = length > 1 ? 0.42 - 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w) : 1.0;
+                coefficients[n] = static_cast<float>(sinc * window);
+                sum += coefficients[n];
+            }
+
+            for (float &c : coefficients)
+            {
+                c = static_cast<float>(c / sum);
+            }
+
+            return coefficients;
+        }
+    } // namespace
+
+    void Decimator::Prepare(uint32_t newFactor, uint32_t newChannels, uint32_t tapsPerPhase)
+    {
+        factor = std::max(1u, newFactor);
+        channels = std::max(1u, newChannels);
+
+        const std::vector<float> prototype = factor > 1
+                                                 ? DesignLowpass(static_cast<size_t>(tapsPerPhase) * factor, factor)
+                                                 : std::vector<float>{ 1.0f };
+        taps.assign(prototype.rbegin(), prototype.rend());
+
+        history.assign(taps.size() * 2 * channels, 0.0f);
+        Reset();
+    }
+
+    size_t Decimator::Process(std::span<const float> input, std::span<float> output)
+    {
+        const size_t length = taps.size();
+        const size_t frames = input.size() / channels;
+        const size_t capacity = output.size() / channels;
+        size_t written = 0;
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            // Each channel's history is mirrored so the newest `length` samples are contiguous
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                float *line = history.data() + static_cast<size_t>(c) * length * 2;
+                line[position] = input[i * channels + c];
+                line[position + length] = input[i * channels + c];
+            }
+            position = position + 1 == length ? 0 : position + 1;
+
+            if (++phase < factor)
+            {
+                continue;
+            }
+            phase = 0;
+
+            if (written == capacity)
+            {
+                continue;
+            }
+
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                const float *window = history.data() + static_cast<size_t>(c) * length * 2 + position;
+                float sum = 0.0f;
+                for (size_t k = 0; k < length; ++k)
+                {
+                    sum += window[k] * taps[k];
+                }
+                output[written * channels + c] = sum;
+            }
+            ++written;
+        }
+
+        return written;
+    }
+
+    void Decimator::Reset()
+    {
+        std::fill(history.begin(), history.end(), 0.0f);
+        position = 0;
+        phase = 0;
+    }
+
+    uint32_t Decimator::GetLatencySamples() const
+    {
+        return static_cast<uint32_t>(taps.empty() ? 0 : (taps.size() - 1) / 2);
+    }
+
+    void Interpolator::Prepare(uint32_t newFactor, uint32_t newChannels, uint32_t newTapsPerPhase)
+    {
+        factor = std::max(1u, newFactor);
+        channels = std::max(1u, newChannels);
+        tapsPerPhase = factor > 1 ? std::max(1u, newTapsPerPhase) : 1;
+
+        const std::vector<float> prototype = factor > 1
+                                                 ? DesignLowpass(static_cast<size_t>(tapsPerPhase) * factor, factor)
+                                                 : std::vector<float>{ 1.0f };
+
+        // phases[p][k] multiplies the k-th newest low-rate sample for output phase p
+        phases.assign(static_cast<size_t>(factor) * tapsPerPhase, 0.0f);
+        for (uint32_t p = 0; p < factor; ++p)
+        {
+            for (uint32_t k = 0; k < tapsPerPhase; ++k)
+            {
+                phases[static_cast<size_t>(p) * tapsPerPhase + k] =
+                    prototype[static_cast<size_t>(k) * factor + p] * static_cast<float>(factor);
+            }
+        }
+
+        history.assign(static_cast<size_t>(tapsPerPhase) * 2 * channels, 0.0f);
+        Reset();
+    }
+
+    size_t Interpolator::Process(std::span<const float> input, std::span<float> output)
+    {
+        const size_t frames = std::min(input.size() / channels, output.size() / channels / factor);
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            position = position == 0 ? tapsPerPhase - 1 : position - 1;
+
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                // Newest sample at `position`, older samples follow contiguously thanks to the mirror
+                float *line = history.data() + static_cast<size_t>(c) * tapsPerPhase * 2;
+                line[position] = input[i * channels + c];
+                line[position + tapsPerPhase] = input[i * channels + c];
+
+                const float *window = line + position;
+                for (uint32_t p = 0; p < factor; ++p)
+                {
+                    const float *coefficients = phases.data() + static_cast<size_t>(p) * tapsPerPhase;
+                    float sum = 0.0f;
+                    for (uint32_t k = 0; k < tapsPerPhase; ++k)
+                    {
+                        sum += window[k] * coefficients[k];
+                    }
+                    output[(i * factor + p) * channels + c] = sum;
+                }
+            }
+        }
+
+        return frames * factor;
+    }
+
+    void Interpolator::Reset()
+    {
+        std::fill(history.begin(), history.end(), 0.0f);
+        position = 0;
+    }
+
+    uint32_t Interpolator::GetLatencySamples() const
+    {
+        return (tapsPerPhase * factor - 1) / 2;
+    }
+
+} // namespace GuitarIO
@@ -1,5 +1,10 @@
 #include "RtAudioDevice.h"
+#include "CallbackRecorder.h"
+#include "Metrics.h"
+#include "Profiler.h"
+#include <chrono>
 #include <stdexcept>
+#include <thread>
 #include <RtAudio.h>
 
 namespace GuitarIO
@@ -18,9 +23,9 @@ namespace GuitarIO
         AudioCallback userCallback,
         void *userPtr)
     {
-        if (IsOpen())
+        if (!TryTransition(StreamState::Closed, StreamState::Opening))
         {
-            lastError = "Device already open";
+            SetLastError("Device already open");
             return false;
         }
 
@@ -59,10 +64,15 @@ namespace GuitarIO
 
         if (result != RTAUDIO_NO_ERROR)
         {
-            lastError = rtAudio.getErrorText();
+            SetLastError(rtAudio.getErrorText());
+            hasInput = false;
+            hasOutput = false;
+            state.store(StreamState::Closed, std::memory_order_release);
             return false;
         }
 
+        streamSampleRate = rtAudio.getStreamSampleRate();
+        state.store(StreamState::Open, std::memory_order_release);
         return true;
     }
 
@@ -74,83 +84,165 @@ namespace GuitarIO
 
     bool RtAudioDevice::Start()
     {
-        if (!IsOpen())
+        if (!TryTransition(StreamState::Open, StreamState::Starting))
         {
-            lastError = "Device not open";
+            SetLastError(DescribeRejectedTransition(GetState()));
             return false;
         }
 
         RtAudioErrorType result = rtAudio.startStream();
         if (result != RTAUDIO_NO_ERROR)
         {
-            lastError = rtAudio.getErrorText();
+            SetLastError(rtAudio.getErrorText());
+            state.store(StreamState::Open, std::memory_order_release);
             return false;
         }
 
+        state.store(StreamState::Running, std::memory_order_release);
         return true;
     }
 
     bool RtAudioDevice::Stop()
     {
-        if (!IsRunning())
+        if (!TryTransition(StreamState::Running, StreamState::Stopping))
         {
-            lastError = "Stream not running";
+            SetLastError("Stream not running");
             return false;
         }
 
         RtAudioErrorType result = rtAudio.stopStream();
         if (result != RTAUDIO_NO_ERROR)
         {
-            lastError = rtAudio.getErrorText();
+            SetLastError(rtAudio.getErrorText());
+            const StreamState settled = rtAudio.isStreamRunning() ? StreamState::Running : StreamState::Open;
+            state.store(settled, std::memory_order_release);
             return false;
         }
 
+        state.store(StreamState::Open, std::memory_order_release);
         return true;
     }
 
     void RtAudioDevice::Close()
     {
-        if (IsOpen())
+        // Wait out a transition owned by another thread (including another Close()), then claim the stream
+        StreamState current = GetState();
+        while (true)
         {
-            if (IsRunning())
+            if (current == StreamState::Closed)
             {
-                rtAudio.stopStream();
+                return;
             }
-            rtAudio.closeStream();
+
+            if ((current == StreamState::Open || current == StreamState::Running)
+                && state.compare_exchange_weak(current, StreamState::Closing, std::memory_order_acq_rel))
+            {
+                break;
+            }
+
+            std::this_thread::yield();
+            current = GetState();
+        }
+
+        if (current == StreamState::Running || rtAudio.isStreamRunning())
+        {
+            rtAudio.stopStream();
         }
+        rtAudio.closeStream();
 
         hasInput = false;
         hasOutput = false;
+        state.store(StreamState::Closed, std::memory_order_release);
     }
 
     bool RtAudioDevice::IsOpen() const
     {
-        return rtAudio.isStreamOpen();
+        const StreamState current = GetState();
+        return current != StreamState::Closed && current != StreamState::Opening;
     }
 
     bool RtAudioDevice::IsRunning() const
     {
-        return rtAudio.isStreamRunning();
+        return GetState() == StreamState::Running;
+    }
+
+    StreamState RtAudioDevice::GetState() const
+    {
+        return state.load(std::memory_order_acquire);
+    }
+
+    void RtAudioDevice::SetRecorder(CallbackRecorder *newRecorder)
+    {
+        recorder.store(newRecorder, std::memory_order_release);
+    }
+
+    void RtAudioDevice::SetMetrics(const AudioStreamMetrics *newMetrics)
+    {
+        metrics.store(newMetrics, std::memory_order_release);
     }
 
     std::string RtAudioDevice::GetLastError() const
     {
+        std::lock_guard<std::mutex> lock(errorMutex);
         return lastError;
     }
 
+    bool RtAudioDevice::TryTransition(StreamState from, StreamState to)
+    {
+        return state.compare_exchange_strong(from, to, std::memory_order_acq_rel);
+    }
+
+    void RtAudioDevice::SetLastError(std::string message)
+    {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        lastError = std::move(message);
+    }
+
+    std::string RtAudioDevice::DescribeRejectedTransition(StreamState current)
+    {
+        switch (current)
+        {
+        case StreamState::Closed:
+        case StreamState::Opening:
+        case StreamState::Closing:
+            return "Device not open";
+        case StreamState::Starting:
+        case StreamState::Running:
+            return "Stream already running";
+        case StreamState::Stopping:
+            return "Stream is stopping";
+        case StreamState::Open:
+            break;
+        }
+
+        return "Stream state changed concurrently";
+    }
+
     int RtAudioDevice::RtAudioCallback(void *outputBuffer,
         void *inputBuffer,
         unsigned int nFrames,
-        double /*streamTime*/,
-        RtAudioStreamStatus /*status*/,
+        double streamTime,
+        RtAudioStreamStatus status,
         void *userData)
     {
         auto *device = static_cast<RtAudioDevice *>(userData);
-        if (!device || !device->callback)
+        if (!device)
+        {
+            return 1; // Stop stream
+        }
+
+        if (!device->callback)
         {
+            device->TryTransition(StreamState::Running, StreamState::Open);
             return 1; // Stop stream
         }
 
+        GUITAR_IO_PROFILE_SCOPE("RtAudioDevice::Callback");
+        if (status != 0)
+        {
+            GUITAR_IO_PROFILE_EVENT("RtAudioDevice::Xrun");
+        }
+
         // Create std::span wrappers for buffers
         std::span<const float> inputSpan;
         std::span<float> outputSpan;
@@ -167,7 +259,36 @@ namespace GuitarIO
             outputSpan = std::span<float>(static_cast<float *>(outputBuffer), nFrames * channels);
         }
 
-        return device->callback(inputSpan, outputSpan, device->userData);
+        CallbackRecorder *activeRecorder = device->recorder.load(std::memory_order_acquire);
+        if (activeRecorder != nullptr)
+        {
+            activeRecorder->RecordBlock(inputSpan, nFrames, streamTime, static_cast<uint32_t>(status));
+        }
+
+        const AudioStreamMetrics *activeMetrics = device->metrics.load(std::memory_order_acquire);
+        const auto callbackStart = activeMetrics != nullptr ? std::chrono::steady_clock::now()
+                                                            : std::chrono::steady_clock::time_point{};
+
+        const int result = device->callback(inputSpan, outputSpan, device->userData);
+
+        if (activeMetrics != nullptr)
+        {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - callbackStart;
+            const double period = device->streamSampleRate > 0.0 ? nFrames / device->streamSampleRate : 0.0;
+            activeMetrics->RecordCallback(period > 0.0 ? elapsed.count() / period : 0.0, status != 0);
+        }
+
+        if (activeRecorder != nullptr)
+        {
+            activeRecorder->RecordOutput(outputSpan);
+        }
+        if (result != 0)
+        {
+            // RtAudio stops the stream itself when the callback asks it to
+            device->TryTransition(StreamState::Running, StreamState::Open);
+        }
+
+        return result;
     }
 
 } // namespace GuitarIO
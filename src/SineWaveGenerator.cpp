@@ -1,6 +1,7 @@
 #include "SineWaveGenerator.h"
+#include "LookupTables.h"
+#include "Profiler.h"
 #include <cmath>
-#include <numbers>
 
 namespace GuitarIO
 {
@@ -9,28 +10,53 @@ namespace GuitarIO
     {
     }
 
+    SineWaveGenerator::SineWaveGenerator(const SineWaveGenerator &other)
+        : sampleRate(other.sampleRate.load(std::memory_order_relaxed)),
+          frequency(other.frequency.load(std::memory_order_relaxed)),
+          amplitude(other.amplitude.load(std::memory_order_relaxed)),
+          tuning(other.tuning.load(std::memory_order_relaxed)),
+          currentPhase(other.currentPhase), phaseIncrement(other.phaseIncrement), appliedTuning(other.appliedTuning)
+    {
+    }
+
+    SineWaveGenerator &SineWaveGenerator::operator=(const SineWaveGenerator &other)
+    {
+        sampleRate.store(other.sampleRate.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        frequency.store(other.frequency.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        amplitude.store(other.amplitude.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        tuning.store(other.tuning.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        currentPhase = other.currentPhase;
+        phaseIncrement = other.phaseIncrement;
+        appliedTuning = other.appliedTuning;
+        return *this;
+    }
+
     void SineWaveGenerator::SetFrequency(double freq)
     {
-        this->frequency = freq;
-        UpdateIncrement();
+        frequency.store(freq, std::memory_order_relaxed);
+        tuning.fetch_add(1, std::memory_order_release);
     }
 
     void SineWaveGenerator::SetAmplitude(float amp)
     {
-        this->amplitude = amp;
+        amplitude.store(amp, std::memory_order_relaxed);
     }
 
     void SineWaveGenerator::SetSampleRate(double rate)
     {
-        this->sampleRate = rate;
-        UpdateIncrement();
+        sampleRate.store(rate, std::memory_order_relaxed);
+        tuning.fetch_add(1, std::memory_order_release);
     }
 
     void SineWaveGenerator::Generate(std::span<float> buffer, bool accumulate)
     {
+        GUITAR_IO_PROFILE_SCOPE("SineWaveGenerator::Generate");
+        UpdateIncrement();
+        const float gain = amplitude.load(std::memory_order_relaxed);
+
         for (float &sample : buffer)
         {
-            float value = amplitude * std::sin(static_cast<float>(currentPhase));
+            float value = gain * SineTable<1024>::Sin(currentPhase);
 
             if (accumulate)
             {
@@ -42,9 +68,9 @@ namespace GuitarIO
             }
 
             currentPhase += phaseIncrement;
-            if (currentPhase >= 2.0 * std::numbers::pi)
+            if (currentPhase >= 1.0)
             {
-                currentPhase -= 2.0 * std::numbers::pi;
+                currentPhase -= 1.0;
             }
         }
     }
@@ -56,7 +82,16 @@ namespace GuitarIO
 
     void SineWaveGenerator::UpdateIncrement()
     {
-        phaseIncrement = (2.0 * std::numbers::pi * frequency) / sampleRate;
+        const uint32_t currentTuning = tuning.load(std::memory_order_acquire);
+        if (currentTuning == appliedTuning)
+        {
+            return;
+        }
+
+        appliedTuning = currentTuning;
+        // Wrapped to [0, 1) so negative or above-Nyquist frequencies keep the phase in table range
+        const double cycles = frequency.load(std::memory_order_relaxed) / sampleRate.load(std::memory_order_relaxed);
+        phaseIncrement = cycles - std::floor(cycles);
     }
 
 } // namespace GuitarIO
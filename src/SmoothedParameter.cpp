@@ -0,0 +1,130 @@
+#include "SmoothedParameter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr float SETTLE_TOLERANCE = 1e-5f; ///< Relative distance treated as arrived
+    } // namespace
+
+    SmoothedParameter::SmoothedParameter(float initialValue, float minValue, float maxValue)
+        : target(initialValue), appliedTarget(initialValue), goal(std::clamp(initialValue, minValue, maxValue)),
+          current(goal), minValue(minValue), maxValue(maxValue)
+    {
+    }
+
+    SmoothedParameter::SmoothedParameter(const SmoothedParameter &other)
+        : target(other.target.load(std::memory_order_relaxed)),
+          coefficient(other.coefficient.load(std::memory_order_relaxed)), smoothingMs(other.smoothingMs),
+          appliedTarget(other.appliedTarget), modulation(other.modulation), goal(other.goal), current(other.current),
+          minValue(other.minValue), maxValue(other.maxValue), controlInterval(other.controlInterval),
+          modulationChanged(other.modulationChanged), settled(other.settled)
+    {
+    }
+
+    SmoothedParameter &SmoothedParameter::operator=(const SmoothedParameter &other)
+    {
+        target.store(other.target.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        coefficient.store(other.coefficient.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        smoothingMs = other.smoothingMs;
+        appliedTarget = other.appliedTarget;
+        modulation = other.modulation;
+        goal = other.goal;
+        current = other.current;
+        minValue = other.minValue;
+        maxValue = other.maxValue;
+        controlInterval = other.controlInterval;
+        modulationChanged = other.modulationChanged;
+        settled = other.settled;
+        return *this;
+    }
+
+    void SmoothedParameter::Prepare(double sampleRate, uint32_t interval, double newSmoothingMs)
+    {
+        controlInterval = std::max(1u, interval);
+        smoothingMs = newSmoothingMs;
+        SetSampleRate(sampleRate);
+    }
+
+    void SmoothedParameter::SetSampleRate(double sampleRate)
+    {
+        const double smoothingSamples = smoothingMs * 0.001 * sampleRate;
+        const double periods = smoothingSamples > 0.0 ? static_cast<double>(controlInterval) / smoothingSamples : 0.0;
+        const float value = periods > 0.0 ? static_cast<float>(1.0 - std::exp(-periods)) : 1.0f;
+        coefficient.store(value, std::memory_order_relaxed);
+    }
+
+    void SmoothedParameter::SetTarget(float value)
+    {
+        target.store(value, std::memory_order_relaxed);
+    }
+
+    void SmoothedParameter::SetImmediate(float value)
+    {
+        target.store(value, std::memory_order_relaxed);
+        appliedTarget = value;
+        goal = std::clamp(value + modulation, minValue, maxValue);
+        current = goal;
+        settled = true;
+    }
+
+    void SmoothedParameter::SetModulation(float offset)
+    {
+        if (offset != modulation)
+        {
+            modulation = offset;
+            modulationChanged = true;
+        }
+    }
+
+    ParameterRamp SmoothedParameter::Tick()
+    {
+        const float requested = target.load(std::memory_order_relaxed);
+        if (requested != appliedTarget || modulationChanged)
+        {
+            appliedTarget = requested;
+            modulationChanged = false;
+            goal = std::clamp(requested + modulation, minValue, maxValue);
+            settled = goal == current;
+        }
+
+        if (settled)
+        {
+            return { current, current };
+        }
+
+        const float start = current;
+        current += (goal - current) * coefficient.load(std::memory_order_relaxed);
+
+        if (std::fabs(goal - current) <= SETTLE_TOLERANCE * std::max(1.0f, std::fabs(goal)))
+        {
+            current = goal;
+            settled = true;
+        }
+
+        return { start, current };
+    }
+
+    float SmoothedParameter::GetValue() const
+    {
+        return current;
+    }
+
+    float SmoothedParameter::GetTarget() const
+    {
+        return target.load(std::memory_order_relaxed);
+    }
+
+    bool SmoothedParameter::IsSettled() const
+    {
+        return settled;
+    }
+
+    uint32_t SmoothedParameter::GetControlInterval() const
+    {
+        return controlInterval;
+    }
+
+} // namespace GuitarIO
@@ -0,0 +1,561 @@
+#include "StreamHost.h"
+#include "AudioMixer.h"
+#include "MemoryAccounting.h"
+#include "SpscRingBuffer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MACOS)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#endif
+
+#if defined(PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace GuitarIO
+{
+    namespace
+    {
+        constexpr int INGEST_POLL_TIMEOUT_MS = 20;   ///< Ingest thread wakeup period
+        constexpr size_t INGEST_CHUNK_BYTES = 65536; ///< Maximum bytes read per socket per poll
+
+        int64_t NowNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+    } // namespace
+
+    /**
+     * @brief State of one virtual stream
+     */
+    struct StreamHost::VirtualStream
+    {
+        uint32_t id = 0;                      ///< Stream ID
+        uint32_t channels = 1;                ///< Interleaved channels
+        size_t blockSamples = 0;              ///< Samples per block (frames * channels)
+        size_t homeWorker = 0;                ///< Worker whose run queue receives this stream
+        float silenceThreshold = 0.0f;        ///< Silence detection threshold (negative = off)
+        SpscRingBuffer<float> input;          ///< Queued input samples
+        TaggedVector<float> block;            ///< Block being processed
+        ProcessorChain chain;                 ///< Processors applied to each block
+        StreamSink sink;                      ///< Receives processed blocks
+        void *userData = nullptr;             ///< User data pointer passed to sink
+        std::atomic<bool> open = true;        ///< Accepting input
+        std::atomic<bool> scheduled = false;  ///< Queued or being processed
+        std::atomic<int64_t> readyTimeNs = 0; ///< Time the pending block was scheduled
+
+        std::atomic<uint64_t> blocksProcessed = 0; ///< Blocks processed
+        std::atomic<uint64_t> framesDropped = 0;   ///< Frames rejected by a full queue
+        std::atomic<uint64_t> blocksSilent = 0;    ///< Blocks flagged silent after the chain
+        std::atomic<int64_t> lastLatencyNs = 0;    ///< Latency of the last block
+        std::atomic<int64_t> totalLatencyNs = 0;   ///< Sum of block latencies
+        std::atomic<int64_t> maxLatencyNs = 0;     ///< Worst block latency
+    };
+
+    StreamHost::StreamHost(const StreamHostConfig &config) : pinWorkers(config.pinWorkers)
+    {
+        uint32_t workerCount = config.workerCount;
+        if (workerCount == 0)
+        {
+            workerCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            workers.push_back(std::make_unique<Worker>());
+        }
+
+        streams.resize(config.maxStreams);
+    }
+
+    StreamHost::~StreamHost()
+    {
+        Stop();
+    }
+
+    uint32_t StreamHost::CreateStream(const VirtualStreamConfig &config,
+        ProcessorChain chain,
+        StreamSink sink,
+        void *userPtr)
+    {
+        if (config.blockSize == 0 || config.channels == 0)
+        {
+            SetLastError("Block size and channel count must be non-zero");
+            return INVALID_STREAM;
+        }
+
+        std::lock_guard lock(streamsMutex);
+
+        const uint32_t id = streamCount.load(std::memory_order_relaxed);
+        if (id >= streams.size())
+        {
+            SetLastError("Stream table full");
+            return INVALID_STREAM;
+        }
+
+        auto stream = std::make_unique<VirtualStream>();
+        stream->id = id;
+        stream->channels = config.channels;
+        stream->blockSamples = static_cast<size_t>(config.blockSize) * config.channels;
+        stream->homeWorker = id % workers.size();
+        stream->input.Resize(static_cast<size_t>(std::max(config.queueFrames, config.blockSize)) * config.channels);
+        stream->block.resize(stream->blockSamples);
+        stream->silenceThreshold = config.silenceThreshold;
+        stream->chain = std::move(chain);
+        stream->chain.SetSilenceThreshold(config.silenceThreshold);
+        stream->sink = std::move(sink);
+        stream->userData = userPtr;
+
+        streams[id] = std::move(stream);
+        streamCount.store(id + 1, std::memory_order_release);
+
+        return id;
+    }
+
+    void StreamHost::CloseStream(uint32_t streamId)
+    {
+        if (VirtualStream *stream = FindStream(streamId))
+        {
+            stream->open.store(false, std::memory_order_release);
+        }
+
+        std::lock_guard lock(socketsMutex);
+        std::erase_if(sockets, [streamId](const SocketInput &socket) { return socket.streamId == streamId; });
+        socketsChanged.store(true, std::memory_order_release);
+    }
+
+    size_t StreamHost::Push(uint32_t streamId, std::span<const float> samples)
+    {
+        VirtualStream *stream = FindStream(streamId);
+        if (!stream)
+        {
+            return 0;
+        }
+
+        const size_t offeredFrames = samples.size() / stream->channels;
+        const size_t frames = std::min(offeredFrames, stream->input.GetWriteAvailable() / stream->channels);
+        stream->input.Write(samples.first(frames * stream->channels));
+
+        if (frames < offeredFrames)
+        {
+            stream->framesDropped.fetch_add(offeredFrames - frames, std::memory_order_relaxed);
+        }
+
+        // Pairs with the fence in RunStream so either this thread sees the stream idle
+        // or the worker sees the new samples
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (running.load(std::memory_order_acquire) && stream->input.GetReadAvailable() >= stream->blockSamples)
+        {
+            Schedule(*stream);
+        }
+
+        return frames;
+    }
+
+    bool StreamHost::AttachSocket([[maybe_unused]] uint32_t streamId, [[maybe_unused]] int socketFd)
+    {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MACOS)
+        if (!FindStream(streamId) || socketFd < 0)
+        {
+            SetLastError("Invalid stream or socket");
+            return false;
+        }
+
+        int socketType = 0;
+        socklen_t optionLength = sizeof(socketType);
+        if (::getsockopt(socketFd, SOL_SOCKET, SO_TYPE, &socketType, &optionLength) != 0)
+        {
+            SetLastError("Descriptor is not a socket");
+            return false;
+        }
+
+        SocketInput socket;
+        socket.fd = socketFd;
+        socket.streamId = streamId;
+        socket.datagram = socketType == SOCK_DGRAM;
+        socket.pending.resize(streams[streamId]->channels * sizeof(float));
+
+        std::lock_guard lock(socketsMutex);
+        sockets.push_back(std::move(socket));
+        socketsChanged.store(true, std::memory_order_release);
+        return true;
+#else
+        SetLastError("Socket input is not supported on this platform");
+        return false;
+#endif
+    }
+
+    void StreamHost::DetachSocket(int socketFd)
+    {
+        std::lock_guard lock(socketsMutex);
+        std::erase_if(sockets, [socketFd](const SocketInput &socket) { return socket.fd == socketFd; });
+        socketsChanged.store(true, std::memory_order_release);
+    }
+
+    bool StreamHost::Start()
+    {
+        if (running.exchange(true, std::memory_order_acq_rel))
+        {
+            SetLastError("Host already running");
+            return false;
+        }
+
+        totalBlocks.store(0, std::memory_order_relaxed);
+        totalFrames.store(0, std::memory_order_relaxed);
+        totalSteals.store(0, std::memory_order_relaxed);
+        startTime = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            workers[i]->thread = std::thread(&StreamHost::WorkerLoop, this, i);
+
+#if defined(PLATFORM_LINUX)
+            if (pinWorkers)
+            {
+                cpu_set_t cpuSet;
+                CPU_ZERO(&cpuSet);
+                CPU_SET(i % std::max(1u, std::thread::hardware_concurrency()), &cpuSet);
+                pthread_setaffinity_np(workers[i]->thread.native_handle(), sizeof(cpuSet), &cpuSet);
+            }
+#endif
+        }
+
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MACOS)
+        ingestThread = std::thread(&StreamHost::IngestLoop, this);
+#endif
+
+        // Input queued while stopped
+        const uint32_t count = streamCount.load(std::memory_order_acquire);
+        for (uint32_t id = 0; id < count; ++id)
+        {
+            VirtualStream &stream = *streams[id];
+            if (stream.open.load(std::memory_order_acquire) && stream.input.GetReadAvailable() >= stream.blockSamples)
+            {
+                Schedule(stream);
+            }
+        }
+
+        return true;
+    }
+
+    void StreamHost::Stop()
+    {
+        if (!running.exchange(false, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        {
+            std::lock_guard lock(sleepMutex);
+        }
+        wakeup.notify_all();
+
+        for (auto &worker : workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+        }
+
+        if (ingestThread.joinable())
+        {
+            ingestThread.join();
+        }
+
+        stopTime = std::chrono::steady_clock::now();
+    }
+
+    bool StreamHost::IsRunning() const
+    {
+        return running.load(std::memory_order_acquire);
+    }
+
+    StreamStats StreamHost::GetStreamStats(uint32_t streamId) const
+    {
+        StreamStats stats;
+        if (streamId >= streamCount.load(std::memory_order_acquire))
+        {
+            return stats;
+        }
+
+        const VirtualStream &stream = *streams[streamId];
+        const uint64_t frames = stream.blockSamples / stream.channels;
+
+        stats.blocksProcessed = stream.blocksProcessed.load(std::memory_order_relaxed);
+        stats.framesProcessed = stats.blocksProcessed * frames;
+        stats.framesDropped = stream.framesDropped.load(std::memory_order_relaxed);
+        stats.blocksSilent = stream.blocksSilent.load(std::memory_order_relaxed);
+        stats.lastLatencyMs = static_cast<double>(stream.lastLatencyNs.load(std::memory_order_relaxed)) * 1e-6;
+        stats.maxLatencyMs = static_cast<double>(stream.maxLatencyNs.load(std::memory_order_relaxed)) * 1e-6;
+        if (stats.blocksProcessed > 0)
+        {
+            stats.averageLatencyMs = static_cast<double>(stream.totalLatencyNs.load(std::memory_order_relaxed)) * 1e-6
+                                     / static_cast<double>(stats.blocksProcessed);
+        }
+
+        return stats;
+    }
+
+    StreamHostStats StreamHost::GetStats() const
+    {
+        StreamHostStats stats;
+        stats.workerCount = static_cast<uint32_t>(workers.size());
+        stats.blocksProcessed = totalBlocks.load(std::memory_order_relaxed);
+        stats.framesProcessed = totalFrames.load(std::memory_order_relaxed);
+        stats.steals = totalSteals.load(std::memory_order_relaxed);
+
+        const uint32_t count = streamCount.load(std::memory_order_acquire);
+        for (uint32_t id = 0; id < count; ++id)
+        {
+            if (streams[id]->open.load(std::memory_order_relaxed))
+            {
+                ++stats.streamCount;
+            }
+        }
+
+        const auto endTime = running.load(std::memory_order_acquire) ? std::chrono::steady_clock::now() : stopTime;
+        if (endTime > startTime)
+        {
+            stats.elapsedSeconds = std::chrono::duration<double>(endTime - startTime).count();
+            stats.framesPerSecond = static_cast<double>(stats.framesProcessed) / stats.elapsedSeconds;
+        }
+
+        return stats;
+    }
+
+    std::string StreamHost::GetLastError() const
+    {
+        std::lock_guard lock(errorMutex);
+        return lastError;
+    }
+
+    void StreamHost::SetLastError(std::string message)
+    {
+        std::lock_guard lock(errorMutex);
+        lastError = std::move(message);
+    }
+
+    StreamHost::VirtualStream *StreamHost::FindStream(uint32_t streamId) const
+    {
+        if (streamId >= streamCount.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        VirtualStream *stream = streams[streamId].get();
+        return stream->open.load(std::memory_order_acquire) ? stream : nullptr;
+    }
+
+    void StreamHost::Schedule(VirtualStream &stream)
+    {
+        if (stream.scheduled.exchange(true, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        stream.readyTimeNs.store(NowNs(), std::memory_order_relaxed);
+
+        Worker &worker = *workers[stream.homeWorker];
+        {
+            std::lock_guard lock(worker.mutex);
+            worker.queue.push_back(&stream);
+        }
+        queuedStreams.fetch_add(1, std::memory_order_release);
+
+        // Taking the lock orders this wakeup after a worker's predicate check
+        {
+            std::lock_guard lock(sleepMutex);
+        }
+        wakeup.notify_one();
+    }
+
+    StreamHost::VirtualStream *StreamHost::TakeWork(size_t workerIndex)
+    {
+        for (size_t offset = 0; offset < workers.size(); ++offset)
+        {
+            if (queuedStreams.load(std::memory_order_acquire) == 0)
+            {
+                return nullptr;
+            }
+
+            Worker &worker = *workers[(workerIndex + offset) % workers.size()];
+            std::lock_guard lock(worker.mutex);
+            if (worker.queue.empty())
+            {
+                continue;
+            }
+
+            VirtualStream *stream = worker.queue.front();
+            worker.queue.pop_front();
+            queuedStreams.fetch_sub(1, std::memory_order_acq_rel);
+
+            if (offset != 0)
+            {
+                totalSteals.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            return stream;
+        }
+
+        return nullptr;
+    }
+
+    void StreamHost::RunStream(VirtualStream &stream)
+    {
+        if (stream.open.load(std::memory_order_acquire) && stream.input.GetReadAvailable() >= stream.blockSamples)
+        {
+            stream.input.Read(stream.block);
+
+            AudioBlock block{ stream.block, stream.channels, false };
+            if (stream.silenceThreshold >= 0.0f)
+            {
+                block.silent = AudioMixer::IsSilent(block.samples, stream.silenceThreshold);
+            }
+
+            stream.chain.Process(block);
+            if (block.silent)
+            {
+                stream.blocksSilent.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (stream.sink)
+            {
+                stream.sink(stream.id, stream.block, stream.userData);
+            }
+
+            const int64_t latency = NowNs() - stream.readyTimeNs.load(std::memory_order_relaxed);
+            stream.lastLatencyNs.store(latency, std::memory_order_relaxed);
+            stream.totalLatencyNs.fetch_add(latency, std::memory_order_relaxed);
+            if (latency > stream.maxLatencyNs.load(std::memory_order_relaxed))
+            {
+                stream.maxLatencyNs.store(latency, std::memory_order_relaxed);
+            }
+            stream.blocksProcessed.fetch_add(1, std::memory_order_relaxed);
+
+            totalBlocks.fetch_add(1, std::memory_order_relaxed);
+            totalFrames.fetch_add(stream.blockSamples / stream.channels, std::memory_order_relaxed);
+        }
+
+        stream.scheduled.store(false, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // One block per scheduling keeps the pool fair; requeue at the back if more input is waiting
+        if (stream.open.load(std::memory_order_acquire) && running.load(std::memory_order_acquire)
+            && stream.input.GetReadAvailable() >= stream.blockSamples)
+        {
+            Schedule(stream);
+        }
+    }
+
+    void StreamHost::WorkerLoop(size_t workerIndex)
+    {
+        while (running.load(std::memory_order_acquire))
+        {
+            if (VirtualStream *stream = TakeWork(workerIndex))
+            {
+                RunStream(*stream);
+                continue;
+            }
+
+            std::unique_lock lock(sleepMutex);
+            wakeup.wait(lock, [this] {
+                return !running.load(std::memory_order_acquire) || queuedStreams.load(std::memory_order_acquire) > 0;
+            });
+        }
+    }
+
+    void StreamHost::IngestLoop()
+    {
+#if defined(PLATFORM_LINUX) || defined(PLATFORM_MACOS)
+        std::vector<pollfd> pollFds;
+        TaggedVector<char> bytes(INGEST_CHUNK_BYTES);
+        TaggedVector<float> samples(INGEST_CHUNK_BYTES / sizeof(float));
+
+        socketsChanged.store(true, std::memory_order_release);
+
+        while (running.load(std::memory_order_acquire))
+        {
+            {
+                std::lock_guard lock(socketsMutex);
+                if (socketsChanged.exchange(false, std::memory_order_acq_rel))
+                {
+                    pollFds.clear();
+                    for (const SocketInput &socket : sockets)
+                    {
+                        pollFds.push_back(pollfd{ socket.fd, POLLIN, 0 });
+                    }
+                }
+            }
+
+            if (pollFds.empty())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(INGEST_POLL_TIMEOUT_MS));
+                continue;
+            }
+
+            if (::poll(pollFds.data(), static_cast<nfds_t>(pollFds.size()), INGEST_POLL_TIMEOUT_MS) <= 0)
+            {
+                continue;
+            }
+
+            std::lock_guard lock(socketsMutex);
+            if (socketsChanged.load(std::memory_order_acquire))
+            {
+                continue; // Indices are stale; results are picked up next round
+            }
+
+            bool removed = false;
+            for (size_t i = 0; i < pollFds.size(); ++i)
+            {
+                if ((pollFds[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0)
+                {
+                    continue;
+                }
+
+                SocketInput &socket = sockets[i];
+                const size_t pendingBytes = socket.pendingBytes;
+                std::memcpy(bytes.data(), socket.pending.data(), pendingBytes);
+
+                const ssize_t received =
+                    ::recv(socket.fd, bytes.data() + pendingBytes, bytes.size() - pendingBytes, MSG_DONTWAIT);
+                if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                {
+                    continue; // Nothing to read after all (spurious wakeup or interrupted); keep the socket
+                }
+                if (received < 0 || (received == 0 && !socket.datagram))
+                {
+                    socket.fd = -1;
+                    removed = true;
+                    continue;
+                }
+
+                // Whole frames are pushed; a trailing partial frame waits for the next read
+                const size_t totalBytes = pendingBytes + static_cast<size_t>(received);
+                const size_t frameBytes = socket.pending.size();
+                const size_t usableBytes = totalBytes - totalBytes % frameBytes;
+                std::memcpy(samples.data(), bytes.data(), usableBytes);
+                Push(socket.streamId, std::span<const float>(samples.data(), usableBytes / sizeof(float)));
+
+                socket.pendingBytes = totalBytes - usableBytes;
+                std::memcpy(socket.pending.data(), bytes.data() + usableBytes, socket.pendingBytes);
+            }
+
+            if (removed)
+            {
+                std::erase_if(sockets, [](const SocketInput &socket) { return socket.fd < 0; });
+                socketsChanged.store(true, std::memory_order_release);
+            }
+        }
+#endif
+    }
+
+} // namespace GuitarIO
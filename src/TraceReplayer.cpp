@@ -0,0 +1,257 @@
+#include "TraceReplayer.h"
+#include "MemoryAccounting.h"
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+namespace GuitarIO
+{
+    namespace
+    {
+        /**
+         * @brief Sequential reader over the loaded record bytes
+         */
+        class RecordCursor
+        {
+        public:
+            explicit RecordCursor(const TaggedVector<uint8_t> &data) : data(data)
+            {
+            }
+
+            /**
+             * @brief Reads a trivially copyable value
+             * @param value Destination
+             * @return false if the trace ends early
+             */
+            template<typename T> bool Get(T &value)
+            {
+                if (data.size() - offset < sizeof(T))
+                {
+                    return false;
+                }
+                std::memcpy(&value, data.data() + offset, sizeof(T));
+                offset += sizeof(T);
+                return true;
+            }
+
+            /**
+             * @brief Copies float samples
+             * @param samples Destination
+             * @return false if the trace ends early
+             */
+            bool GetSamples(std::span<float> samples)
+            {
+                if (data.size() - offset < samples.size_bytes())
+                {
+                    return false;
+                }
+                std::memcpy(samples.data(), data.data() + offset, samples.size_bytes());
+                offset += samples.size_bytes();
+                return true;
+            }
+
+            /**
+             * @brief Checks whether every record has been consumed
+             */
+            [[nodiscard]] bool AtEnd() const
+            {
+                return offset == data.size();
+            }
+
+        private:
+            const TaggedVector<uint8_t> &data; ///< Record bytes
+            size_t offset = 0;                ///< Read position
+        };
+    } // namespace
+
+    bool TraceReplayer::Open(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            lastError = "Failed to open trace file: " + path;
+            return false;
+        }
+
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != CallbackTrace::MAGIC)
+        {
+            lastError = "Not a callback trace: " + path;
+            return false;
+        }
+
+        if (header.version == 0 || header.version > CallbackTrace::VERSION)
+        {
+            lastError = "Unsupported trace version " + std::to_string(header.version);
+            return false;
+        }
+
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    AudioStreamConfig TraceReplayer::GetConfig() const
+    {
+        AudioStreamConfig config;
+        config.sampleRate = header.sampleRate;
+        config.bufferSize = header.bufferSize;
+        config.inputChannels = header.inputChannels;
+        config.outputChannels = header.outputChannels;
+        return config;
+    }
+
+    bool TraceReplayer::Replay(const TraceReplayHandlers &handlers,
+        TraceReplayResult &result,
+        const TraceReplayOptions &options,
+        void *userPtr)
+    {
+        result = {};
+        result.outputChecksum = CallbackTrace::CHECKSUM_SEED;
+
+        if (!handlers.process)
+        {
+            lastError = "No processing callback";
+            return false;
+        }
+
+        TaggedVector<float> input;
+        TaggedVector<float> output;
+        std::span<const float> lastOutput;
+        uint64_t framesReplayed = 0;
+        bool diverged = false;
+
+        RecordCursor cursor(data);
+        const auto start = std::chrono::steady_clock::now();
+
+        while (!cursor.AtEnd())
+        {
+            uint8_t type = 0;
+            cursor.Get(type);
+
+            if (type == CallbackTrace::RECORD_PARAMETER)
+            {
+                uint32_t id = 0;
+                float value = 0.0f;
+                uint64_t timestamp = 0;
+                if (!cursor.Get(id) || !cursor.Get(value) || !cursor.Get(timestamp))
+                {
+                    lastError = "Truncated parameter record";
+                    return false;
+                }
+
+                ++result.parameterEvents;
+                if (handlers.parameter)
+                {
+                    handlers.parameter(id, value);
+                }
+                continue;
+            }
+
+            if (type == CallbackTrace::RECORD_GAP)
+            {
+                uint32_t blocks = 0;
+                uint32_t parameters = 0;
+                uint64_t frames = 0;
+                if (!cursor.Get(blocks) || !cursor.Get(parameters) || !cursor.Get(frames))
+                {
+                    lastError = "Truncated gap record";
+                    return false;
+                }
+
+                ++result.gaps;
+                result.droppedBlocks += blocks;
+                result.droppedParameters += parameters;
+                diverged = true;
+                continue;
+            }
+
+            if (type == CallbackTrace::RECORD_OUTPUT_CHECKSUM)
+            {
+                uint64_t expected = 0;
+                if (!cursor.Get(expected))
+                {
+                    lastError = "Truncated checksum record";
+                    return false;
+                }
+
+                if (options.verifyOutput && result.blocks > 0 && diverged)
+                {
+                    ++result.checksumsSkipped;
+                }
+                else if (options.verifyOutput && result.blocks > 0)
+                {
+                    ++result.checksumsCompared;
+                    if (CallbackTrace::Checksum(lastOutput) != expected)
+                    {
+                        ++result.checksumMismatches;
+                        if (result.firstMismatchBlock < 0)
+                        {
+                            result.firstMismatchBlock = static_cast<int64_t>(result.blocks - 1);
+                        }
+                    }
+                }
+                continue;
+            }
+
+            if (type != CallbackTrace::RECORD_BLOCK)
+            {
+                lastError = "Unknown record type " + std::to_string(type);
+                return false;
+            }
+
+            uint32_t frames = 0;
+            uint32_t sampleCount = 0;
+            uint32_t status = 0;
+            double streamTime = 0.0;
+            uint64_t timestamp = 0;
+            if (!cursor.Get(frames) || !cursor.Get(sampleCount) || !cursor.Get(status) || !cursor.Get(streamTime)
+                || !cursor.Get(timestamp))
+            {
+                lastError = "Truncated block record";
+                return false;
+            }
+
+            input.resize(sampleCount);
+            if (!cursor.GetSamples(input))
+            {
+                lastError = "Truncated block samples";
+                return false;
+            }
+
+            output.assign(static_cast<size_t>(frames) * header.outputChannels, 0.0f);
+
+            if (options.realTime && header.sampleRate > 0)
+            {
+                const std::chrono::duration<double> due(static_cast<double>(framesReplayed) / header.sampleRate);
+                std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::nanoseconds>(due));
+            }
+
+            if (handlers.block)
+            {
+                handlers.block(status, streamTime);
+            }
+            result.statusEvents += status != 0 ? 1 : 0;
+
+            const int stop = handlers.process(input, output, userPtr);
+            lastOutput = output;
+            result.outputChecksum = CallbackTrace::Checksum(output, result.outputChecksum);
+            ++result.blocks;
+            framesReplayed += frames;
+
+            if (stop != 0)
+            {
+                lastError = "Processing callback requested stop";
+                result.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                return false;
+            }
+        }
+
+        result.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    std::string TraceReplayer::GetLastError() const
+    {
+        return lastError;
+    }
+
+} // namespace GuitarIO